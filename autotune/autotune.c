@@ -0,0 +1,174 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * Timing harness of `make autotune`, linked against a copy of the column-major dgemm
+ * and dsyrk drivers compiled with a candidate blasfeo_autotune.h.
+ *
+ * usage: autotune.out --params
+ *        autotune.out <routine> <m> <n> <k> [<routine> <m> <n> <k> ...]
+ *
+ * where <routine> is one of gemm_nn, gemm_nt, syrk_ln (n is ignored for syrk).
+ * One line with the Gflops of each case is printed to stdout.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <blasfeo.h>
+#include <blasfeo_block_size.h>
+
+#if defined(FORTRAN_BLAS_API)
+#define blasfeo_blas_dgemm dgemm_
+#define blasfeo_blas_dsyrk dsyrk_
+#endif
+
+
+
+// min time spent on each case, in seconds
+#define AUTOTUNE_MIN_TIME 0.05
+
+
+
+static void print_params()
+	{
+	printf("D_KC %d\n", D_KC);
+	printf("D_NC %d\n", D_NC);
+	printf("D_MC %d\n", D_MC);
+#if defined(L2_CACHE_SIZE)
+	printf("L2_CACHE_SIZE %d\n", L2_CACHE_SIZE);
+#endif
+#if defined(LLC_CACHE_SIZE)
+	printf("LLC_CACHE_SIZE %d\n", LLC_CACHE_SIZE);
+#endif
+	printf("D_GEMM_SMALL_MN %d\n", D_GEMM_SMALL_MN);
+	printf("D_GEMM_MN_RATIO %d\n", D_GEMM_MN_RATIO);
+	printf("D_M_KERNEL %d\n", D_M_KERNEL);
+	printf("D_PS %d\n", D_PS);
+	}
+
+
+
+static double run_case(char *routine, int m, int n, int k)
+	{
+	int ii, rep, nrep;
+	double time, flops;
+	double alpha = 1.0;
+	double beta = 0.0;
+	char c_l = 'l';
+	char c_n = 'n';
+	char c_t = 't';
+	int is_syrk = strcmp(routine, "syrk_ln")==0;
+	if(is_syrk)
+		n = m;
+	int lda = m;
+	int ldb = strcmp(routine, "gemm_nt")==0 ? n : k;
+	int size_A = m*k;
+	int size_B = is_syrk ? 1 : k*n;
+	int size_C = m*n;
+
+	double *A, *B, *C;
+	blasfeo_malloc_align((void **) &A, size_A*sizeof(double));
+	blasfeo_malloc_align((void **) &B, size_B*sizeof(double));
+	blasfeo_malloc_align((void **) &C, size_C*sizeof(double));
+	for(ii=0; ii<size_A; ii++)
+		A[ii] = 1.0/(ii%13+1);
+	for(ii=0; ii<size_B; ii++)
+		B[ii] = 1.0/(ii%11+1);
+	for(ii=0; ii<size_C; ii++)
+		C[ii] = 0.0;
+
+	blasfeo_timer timer;
+
+	// double the number of repetitions until the min time is reached; the first one warms up
+	time = 0.0;
+	for(nrep=1; time<AUTOTUNE_MIN_TIME; nrep*=2)
+		{
+		blasfeo_tic(&timer);
+		for(rep=0; rep<nrep; rep++)
+			{
+			if(strcmp(routine, "gemm_nn")==0)
+				blasfeo_blas_dgemm(&c_n, &c_n, &m, &n, &k, &alpha, A, &lda, B, &ldb, &beta, C, &m);
+			else if(strcmp(routine, "gemm_nt")==0)
+				blasfeo_blas_dgemm(&c_n, &c_t, &m, &n, &k, &alpha, A, &lda, B, &ldb, &beta, C, &m);
+			else
+				blasfeo_blas_dsyrk(&c_l, &c_n, &m, &k, &alpha, A, &lda, &beta, C, &m);
+			}
+		time = blasfeo_toc(&timer);
+		}
+	nrep /= 2;
+
+	flops = is_syrk ? 1.0*m*(m+1)*k : 2.0*m*n*k;
+
+	blasfeo_free_align(A);
+	blasfeo_free_align(B);
+	blasfeo_free_align(C);
+
+	return 1e-9*flops*nrep/time;
+	}
+
+
+
+int main(int argc, char **argv)
+	{
+
+	int ii;
+
+	if(argc==2 && strcmp(argv[1], "--params")==0)
+		{
+		print_params();
+		return 0;
+		}
+
+	if(argc<5 || (argc-1)%4!=0)
+		{
+		fprintf(stderr, "usage: %s --params | <routine> <m> <n> <k> [...]\n", argv[0]);
+		return 1;
+		}
+
+	for(ii=1; ii<argc; ii+=4)
+		{
+		if(strcmp(argv[ii], "gemm_nn")!=0 && strcmp(argv[ii], "gemm_nt")!=0 && strcmp(argv[ii], "syrk_ln")!=0)
+			{
+			fprintf(stderr, "unknown routine %s\n", argv[ii]);
+			return 1;
+			}
+		printf("%f\n", run_case(argv[ii], atoi(argv[ii+1]), atoi(argv[ii+2]), atoi(argv[ii+3])));
+		}
+
+	return 0;
+
+	}
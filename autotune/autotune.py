@@ -0,0 +1,194 @@
+#! /usr/bin/python3
+
+# Offline autotuner of the blocking parameters and algorithm switch points of the
+# column-major dgemm and dsyrk drivers.
+#
+# Each parameter is swept in turn (coordinate descent) by compiling the drivers against a
+# candidate blasfeo_autotune.h, linking them into the autotune.c harness and timing a set
+# of problem shapes sensitive to that parameter. The best values are written to
+# include/blasfeo_autotune.h, used by the library when built with AUTOTUNE=1.
+
+import subprocess as sp
+import argparse
+import math
+import os
+import shutil
+import socket
+import sys
+import tempfile
+from pathlib import Path
+
+
+
+AUTOTUNE_PATH=str(Path(__file__).absolute().parents[0])
+BLASFEO_PATH=str(Path(__file__).absolute().parents[1])
+HEADER_NAME="blasfeo_autotune.h"
+
+# min relative gain for a candidate to replace the current value, filters out timing noise
+MIN_GAIN=0.01
+
+# problem shapes (routine, m, n, k) used to score each group of parameters
+SHAPES = {
+	# large matrices, blocked algorithm packing A and B
+	"blocking": [
+		("gemm_nn", 1024, 1024, 1024),
+		("gemm_nt", 1024, 1024, 1024),
+		("gemm_nn", 2048, 256, 512),
+		("syrk_ln", 1024, 0, 1024),
+	],
+	# medium matrices, crossover between packing one or both operands
+	"cache": [(r, m, n, k) for r in ("gemm_nn", "gemm_nt")
+		for (m, n) in ((48, 48), (96, 96), (192, 192), (384, 384), (192, 48))
+		for k in (64, 256)] +
+		[("syrk_ln", m, 0, k) for m in (48, 96, 192, 384) for k in (64, 256)],
+	# tall matrices, packing A or B
+	"ratio": [("gemm_nn", m, n, k)
+		for (m, n) in ((192, 96), (256, 64), (384, 48), (512, 96), (1024, 64))
+		for k in (64, 256)],
+	# small matrices
+	"small": [(r, s, s, s) for r in ("gemm_nn", "gemm_nt") for s in (16, 24, 32, 48, 64, 96)],
+}
+
+
+
+def parse_arguments():
+	parser = argparse.ArgumentParser(description='BLASFEO blocking parameters autotuner')
+
+	parser.add_argument('--target', type=str, required=True,
+		help='BLASFEO target the library is built for, i.e. X64_INTEL_HASWELL')
+	parser.add_argument('--output', type=str,
+		default=os.path.join(BLASFEO_PATH, "include", HEADER_NAME),
+		help='Generated header')
+	parser.add_argument('--cpu', type=int, default=None,
+		help='Pin the timing runs to this cpu with taskset')
+
+	return parser.parse_args()
+
+
+
+def round_to(value, multiple):
+	return max(multiple, int(round(value/multiple))*multiple)
+
+
+
+def candidates(name, default, params):
+	if name=="D_KC":
+		return sorted({round_to(default*f, 32) for f in (0.5, 0.75, 1.0, 1.25, 1.5, 2.0)})
+	if name=="D_NC":
+		return sorted({round_to(default*f, params["D_PS"]) for f in (0.5, 0.75, 1.0, 1.5, 2.0)})
+	if name=="D_MC":
+		return sorted({round_to(default*f, params["D_M_KERNEL"]) for f in (0.5, 0.75, 1.0, 1.5, 2.0)})
+	if name in ("L2_CACHE_SIZE", "LLC_CACHE_SIZE"):
+		return sorted({int(default*f) for f in (0.25, 0.5, 1.0, 2.0, 4.0)})
+	if name=="D_GEMM_MN_RATIO":
+		return [1, 2, 4, 8, 16]
+	if name=="D_GEMM_SMALL_MN":
+		return [16, 24, 32, 48, 64, 96]
+	return [default]
+
+
+
+def write_header(path, values, comment):
+	with open(path, "w") as f:
+		f.write("// %s\n\n" % comment)
+		f.write("#ifndef BLASFEO_AUTOTUNE_H_\n#define BLASFEO_AUTOTUNE_H_\n\n")
+		for name, value in values.items():
+			f.write("#undef %s\n#define %s %d\n" % (name, name, value))
+		f.write("\n#endif  // BLASFEO_AUTOTUNE_H_\n")
+
+
+
+class Autotuner:
+
+	def __init__(self, args):
+		self.args = args
+		self.tune_dir = tempfile.mkdtemp(prefix="blasfeo_autotune_")
+		self.header = os.path.join(self.tune_dir, HEADER_NAME)
+
+	def build(self, values):
+		write_header(self.header, values, "autotune candidate")
+		cmd = ["make", "-s", "-C", AUTOTUNE_PATH, "candidate", "TUNE_DIR="+self.tune_dir]
+		proc = sp.run(cmd, stdout=sp.PIPE, stderr=sp.STDOUT)
+		if proc.returncode:
+			print(proc.stdout.decode())
+			sys.exit("Error: build of the autotune candidate failed")
+
+	def run(self, harness_args):
+		cmd = [os.path.join(self.tune_dir, "autotune.out")] + harness_args
+		if self.args.cpu is not None:
+			cmd = ["taskset", "-c", str(self.args.cpu)] + cmd
+		proc = sp.run(cmd, stdout=sp.PIPE, stderr=sp.PIPE, check=True)
+		return proc.stdout.decode().split("\n")
+
+	def default_params(self):
+		self.build({})
+		params = {}
+		for line in self.run(["--params"]):
+			if line:
+				name, value = line.split()
+				params[name] = int(value)
+		return params
+
+	def score(self, values, group):
+		self.build(values)
+		harness_args = []
+		for shape in SHAPES[group]:
+			harness_args += [str(x) for x in shape]
+		gflops = [float(x) for x in self.run(harness_args) if x]
+		# geometric mean, so that small and large shapes weight the same
+		return math.exp(sum(math.log(x) for x in gflops)/len(gflops))
+
+	def tune(self):
+		params = self.default_params()
+
+		sweep = [("D_KC", "blocking"), ("D_NC", "blocking"), ("D_MC", "blocking")]
+		if "L2_CACHE_SIZE" in params:
+			sweep.append(("L2_CACHE_SIZE", "cache"))
+		if "LLC_CACHE_SIZE" in params:
+			sweep.append(("LLC_CACHE_SIZE", "cache"))
+		sweep.append(("D_GEMM_MN_RATIO", "ratio"))
+		# the small-matrix switch point is only used on sandy bridge
+		if self.args.target=="X64_INTEL_SANDY_BRIDGE":
+			sweep.append(("D_GEMM_SMALL_MN", "small"))
+
+		values = {name: params[name] for name, _ in sweep}
+
+		for name, group in sweep:
+			best = values[name]
+			best_score = self.score(values, group)
+			print("%-16s %8d  %8.2f Gflops (current)" % (name, best, best_score))
+			for value in candidates(name, params[name], params):
+				if value==values[name]:
+					continue
+				trial = dict(values)
+				trial[name] = value
+				trial_score = self.score(trial, group)
+				print("%-16s %8d  %8.2f Gflops" % (name, value, trial_score))
+				if trial_score>best_score*(1.0+MIN_GAIN):
+					best, best_score = value, trial_score
+			values[name] = best
+			print("%-16s %8d  selected\n" % (name, best))
+
+		return params, values
+
+	def cleanup(self):
+		shutil.rmtree(self.tune_dir, ignore_errors=True)
+
+
+
+if __name__ == "__main__":
+	args = parse_arguments()
+
+	tuner = Autotuner(args)
+	try:
+		params, values = tuner.tune()
+	finally:
+		tuner.cleanup()
+
+	write_header(args.output, values,
+		"generated by autotune/autotune.py for TARGET=%s on %s" % (args.target, socket.gethostname()))
+
+	print("Tuned parameters (default -> tuned):")
+	for name, value in values.items():
+		print("  %-16s %8d -> %d" % (name, params[name], value))
+	print("\nWritten %s, rebuild the library with AUTOTUNE=1 to use it." % args.output)
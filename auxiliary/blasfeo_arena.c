@@ -0,0 +1,153 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+
+#include <blasfeo_block_size.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_arena.h>
+
+
+
+// number of columns a matrix is created with: with BLASFEO_ARENA_PAD the panel-major column count cn
+// is increased by D_PLD when the panel stride D_PS*cn is a multiple of the conflict stride
+static int arena_dmat_cols(int m, int n, int flags)
+	{
+#if defined(MF_PANELMAJ)
+	int cn = (n+D_PLD-1)/D_PLD*D_PLD;
+	// a single panel has no stride
+	if((flags & BLASFEO_ARENA_PAD) & m>D_PS & cn*D_PS*D_EL_SIZE%BLASFEO_ARENA_CONFLICT_STRIDE==0)
+		return cn+D_PLD;
+#endif
+	return n;
+	}
+
+
+
+static size_t arena_item_memsize(struct blasfeo_arena_item *item, int flags)
+	{
+	size_t memsize;
+	if(item->type==BLASFEO_ARENA_DMAT)
+		memsize = blasfeo_memsize_dmat(item->m, arena_dmat_cols(item->m, item->n, flags));
+	else
+		memsize = blasfeo_memsize_dvec(item->m);
+	return (memsize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+	}
+
+
+
+static void arena_item_create(struct blasfeo_arena_item *item, int flags, char *ptr)
+	{
+	struct blasfeo_dmat *sA;
+	int n_pad;
+	if(item->type==BLASFEO_ARENA_DMAT)
+		{
+		sA = (struct blasfeo_dmat *) item->obj;
+		n_pad = arena_dmat_cols(item->m, item->n, flags);
+		// the extra columns only widen the panel stride
+		blasfeo_create_dmat(item->m, n_pad, sA, ptr);
+		sA->n = item->n;
+		}
+	else
+		{
+		blasfeo_create_dvec(item->m, (struct blasfeo_dvec *) item->obj, ptr);
+		}
+	}
+
+
+
+// lay out the items in storage order, creating them if memory is not NULL; return the arena size
+static size_t arena_layout(int n_items, struct blasfeo_arena_item *items, int flags, char *memory)
+	{
+	size_t offset = 0;
+	int ii;
+	int stage = 0;
+	int next_stage = 0;
+	int found;
+	if(!(flags & BLASFEO_ARENA_INTERLEAVE))
+		{
+		for(ii=0; ii<n_items; ii++)
+			{
+			if(memory!=NULL)
+				arena_item_create(items+ii, flags, memory+offset);
+			offset += arena_item_memsize(items+ii, flags);
+			}
+		return offset;
+		}
+	// visit the stages by increasing index, and the items of each stage in list order
+	found = 0;
+	for(ii=0; ii<n_items; ii++)
+		{
+		if(found==0 | items[ii].stage<stage)
+			stage = items[ii].stage;
+		found = 1;
+		}
+	while(found)
+		{
+		found = 0;
+		for(ii=0; ii<n_items; ii++)
+			{
+			if(items[ii].stage==stage)
+				{
+				if(memory!=NULL)
+					arena_item_create(items+ii, flags, memory+offset);
+				offset += arena_item_memsize(items+ii, flags);
+				}
+			else if(items[ii].stage>stage & (found==0 | items[ii].stage<next_stage))
+				{
+				next_stage = items[ii].stage;
+				found = 1;
+				}
+			}
+		stage = next_stage;
+		}
+	return offset;
+	}
+
+
+
+size_t blasfeo_arena_memsize(int n_items, struct blasfeo_arena_item *items, int flags)
+	{
+	return arena_layout(n_items, items, flags, NULL);
+	}
+
+
+
+void blasfeo_arena_create(int n_items, struct blasfeo_arena_item *items, int flags, void *memory)
+	{
+	arena_layout(n_items, items, flags, (char *) memory);
+	return;
+	}
@@ -0,0 +1,226 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_batch.h>
+
+// calls with aligned operands in a group of small gemm_nt go straight to the generated kernel,
+// looked up once per group (not with capture or profiling, that need the public routine)
+#if defined(LA_HIGH_PERFORMANCE) & defined(MF_PANELMAJ) & defined(BLASFEO_JIT) & !defined(BLASFEO_GRAPH) & !defined(BLASFEO_PROFILE)
+#define BATCH_JIT
+#include <blasfeo_jit.h>
+#endif
+
+
+
+// batches up to this size are sorted in a stack buffer
+#define BATCH_STACK 64
+
+// sort key of a call: sizes, class of the scalars, position in the batch
+struct batch_key
+	{
+	int m;
+	int n;
+	int k;
+	int cls;
+	int idx;
+	};
+
+
+
+static int batch_key_cmp(const void *a, const void *b)
+	{
+	const struct batch_key *ka = a;
+	const struct batch_key *kb = b;
+	if(ka->m!=kb->m)
+		return ka->m<kb->m ? -1 : 1;
+	if(ka->n!=kb->n)
+		return ka->n<kb->n ? -1 : 1;
+	if(ka->k!=kb->k)
+		return ka->k<kb->k ? -1 : 1;
+	if(ka->cls!=kb->cls)
+		return ka->cls<kb->cls ? -1 : 1;
+	// keep the batch order within a group
+	return ka->idx<kb->idx ? -1 : ka->idx>kb->idx;
+	}
+
+
+
+static int batch_same_group(struct batch_key *ka, struct batch_key *kb)
+	{
+	return ka->m==kb->m & ka->n==kb->n & ka->k==kb->k & ka->cls==kb->cls;
+	}
+
+
+
+// sort the calls by size, n, k, alpha and beta can be NULL; return keys0 or a malloc'd array if batch>BATCH_STACK
+static struct batch_key *batch_sort(int batch, int *m, int *n, int *k, double *alpha, double *beta, struct batch_key *keys0)
+	{
+	struct batch_key *keys = batch>BATCH_STACK ? malloc(batch*sizeof(struct batch_key)) : keys0;
+	int ii;
+	for(ii=0; ii<batch; ii++)
+		{
+		keys[ii].m = m[ii];
+		keys[ii].n = n!=NULL ? n[ii] : 0;
+		keys[ii].k = k!=NULL ? k[ii] : 0;
+		// same scalar class as the generated kernels
+		keys[ii].cls = 0;
+		if(alpha!=NULL)
+			keys[ii].cls |= (alpha[ii]==1.0);
+		if(beta!=NULL)
+			keys[ii].cls |= (beta[ii]==0.0)<<1 | (beta[ii]==1.0)<<2;
+		keys[ii].idx = ii;
+		}
+	qsort(keys, batch, sizeof(struct batch_key), batch_key_cmp);
+	return keys;
+	}
+
+
+
+void blasfeo_dgemm_nt_batch(int batch, int *m, int *n, int *k, double *alpha, struct blasfeo_dmat **sA, int *ai, int *aj, struct blasfeo_dmat **sB, int *bi, int *bj, double *beta, struct blasfeo_dmat **sC, int *ci, int *cj, struct blasfeo_dmat **sD, int *di, int *dj)
+	{
+	if(batch<=0)
+		return;
+
+	struct batch_key keys0[BATCH_STACK];
+	struct batch_key *keys = batch_sort(batch, m, n, k, alpha, beta, keys0);
+
+	int ii, jj, g1, l;
+
+#if defined(BATCH_JIT)
+	const int ps = 4;
+	blasfeo_jit_dgemm_kernel kernel;
+	struct blasfeo_jit_dgemm_args args;
+	int mm, nn, kk;
+#endif
+
+	for(ii=0; ii<batch; ii=g1)
+		{
+		// the group is [ii,g1)
+		for(g1=ii+1; g1<batch && batch_same_group(keys+ii, keys+g1); g1++)
+			;
+#if defined(BATCH_JIT)
+		l = keys[ii].idx;
+		mm = m[l];
+		nn = n[l];
+		kk = k[l];
+		kernel = NULL;
+		if(mm>0 & nn>0 & mm<=BLASFEO_JIT_MAX_M & nn<=BLASFEO_JIT_MAX_N & kk<=BLASFEO_JIT_MAX_K & mm*nn*kk>=BLASFEO_JIT_MIN_MNK)
+			kernel = blasfeo_jit_dgemm_get('t', mm, nn, kk, alpha[l], beta[l]);
+#endif
+		for(jj=ii; jj<g1; jj++)
+			{
+			l = keys[jj].idx;
+#if defined(BATCH_JIT)
+			if(kernel!=NULL & ((ai[l] | bi[l] | ci[l] | di[l]) & (ps-1))==0)
+				{
+				sD[l]->use_dA = 0;
+				args.pA = sA[l]->pA + aj[l]*ps + ai[l]*sA[l]->cn;
+				args.pB = sB[l]->pA + bj[l]*ps + bi[l]*sB[l]->cn;
+				args.pC = sC[l]->pA + cj[l]*ps + ci[l]*sC[l]->cn;
+				args.pD = sD[l]->pA + dj[l]*ps + di[l]*sD[l]->cn;
+				args.sda_bytes = (long long) ps*sA[l]->cn*sizeof(double);
+				args.sdb_bytes = (long long) ps*sB[l]->cn*sizeof(double);
+				args.sdc_bytes = (long long) ps*sC[l]->cn*sizeof(double);
+				args.sdd_bytes = (long long) ps*sD[l]->cn*sizeof(double);
+				args.alpha = alpha[l];
+				args.beta = beta[l];
+				kernel(&args);
+				continue;
+				}
+#endif
+			blasfeo_dgemm_nt(m[l], n[l], k[l], alpha[l], sA[l], ai[l], aj[l], sB[l], bi[l], bj[l], beta[l], sC[l], ci[l], cj[l], sD[l], di[l], dj[l]);
+			}
+		}
+
+	if(keys!=keys0)
+		free(keys);
+
+	return;
+
+	}
+
+
+
+void blasfeo_dsyrk_ln_batch(int batch, int *m, int *k, double *alpha, struct blasfeo_dmat **sA, int *ai, int *aj, struct blasfeo_dmat **sB, int *bi, int *bj, double *beta, struct blasfeo_dmat **sC, int *ci, int *cj, struct blasfeo_dmat **sD, int *di, int *dj)
+	{
+	if(batch<=0)
+		return;
+
+	struct batch_key keys0[BATCH_STACK];
+	struct batch_key *keys = batch_sort(batch, m, NULL, k, NULL, NULL, keys0);
+
+	int ii, l;
+
+	for(ii=0; ii<batch; ii++)
+		{
+		l = keys[ii].idx;
+		blasfeo_dsyrk_ln(m[l], k[l], alpha[l], sA[l], ai[l], aj[l], sB[l], bi[l], bj[l], beta[l], sC[l], ci[l], cj[l], sD[l], di[l], dj[l]);
+		}
+
+	if(keys!=keys0)
+		free(keys);
+
+	return;
+
+	}
+
+
+
+void blasfeo_dpotrf_l_batch(int batch, int *m, struct blasfeo_dmat **sC, int *ci, int *cj, struct blasfeo_dmat **sD, int *di, int *dj)
+	{
+	if(batch<=0)
+		return;
+
+	struct batch_key keys0[BATCH_STACK];
+	struct batch_key *keys = batch_sort(batch, m, NULL, NULL, NULL, NULL, keys0);
+
+	int ii, l;
+
+	for(ii=0; ii<batch; ii++)
+		{
+		l = keys[ii].idx;
+		blasfeo_dpotrf_l(m[l], sC[l], ci[l], cj[l], sD[l], di[l], dj[l]);
+		}
+
+	if(keys!=keys0)
+		free(keys);
+
+	return;
+
+	}
@@ -0,0 +1,219 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+/*
+ * Condition number estimation from the LU and Cholesky factorizations.
+ *
+ * The 1-norm of inv(A) is estimated with the Hager-Higham method (N. J. Higham, "FORTRAN codes
+ * for estimating the one-norm of a real or complex matrix, with applications to condition
+ * estimation", 1988, as in LAPACK dlacn2), that only needs a few products of inv(A) and inv(A)^T
+ * with vectors. These are triangular solves with the factors, that use the inverse of the
+ * diagonal cached in the matrix by the first call.
+ */
+
+#include <math.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_cond.h>
+
+
+
+// max number of iterations of the estimator
+#define CON_ITMAX 5
+
+
+
+int blasfeo_dgecon_worksize(int n)
+	{
+	if(n<=0)
+		return 0;
+	return 3*blasfeo_memsize_dvec(n);
+	}
+
+
+
+// x <= inv(A) * x (trans==0) or x <= inv(A)^T * x (trans!=0), A factorized by LU (chol==0) or Cholesky (chol!=0) ; t temporary
+static void con_solve(int n, struct blasfeo_dmat *sA, int ai, int aj, int chol, int trans, struct blasfeo_dvec *sx, struct blasfeo_dvec *st)
+	{
+	if(chol)
+		{
+		blasfeo_dtrsv_lnn(n, sA, ai, aj, sx, 0, st, 0);
+		blasfeo_dtrsv_ltn(n, sA, ai, aj, st, 0, sx, 0);
+		}
+	else if(trans==0)
+		{
+		blasfeo_dtrsv_lnu(n, sA, ai, aj, sx, 0, st, 0);
+		blasfeo_dtrsv_unn(n, sA, ai, aj, st, 0, sx, 0);
+		}
+	else
+		{
+		blasfeo_dtrsv_utn(n, sA, ai, aj, sx, 0, st, 0);
+		blasfeo_dtrsv_ltu(n, sA, ai, aj, st, 0, sx, 0);
+		}
+	return;
+	}
+
+
+
+// sum of abs values
+static double con_asum(int n, double *x)
+	{
+	int ii;
+	double sum = 0.0;
+	for(ii=0; ii<n; ii++)
+		sum += fabs(x[ii]);
+	return sum;
+	}
+
+
+
+// index of the max abs element
+static int con_iamax(int n, double *x)
+	{
+	int ii;
+	int idx = 0;
+	for(ii=1; ii<n; ii++)
+		{
+		if(fabs(x[ii])>fabs(x[idx]))
+			idx = ii;
+		}
+	return idx;
+	}
+
+
+
+// estimate of the 1-norm of inv(A)
+static double con_est(int n, struct blasfeo_dmat *sA, int ai, int aj, int chol, void *work)
+	{
+	struct blasfeo_dvec sx, st, ss;
+	int ii, jj, jlast, iter, rep;
+	double est, est_old, tmp;
+	double *x, *s;
+
+	char *c_ptr = (char *) work;
+	blasfeo_create_dvec(n, &sx, c_ptr);
+	c_ptr += sx.memsize;
+	blasfeo_create_dvec(n, &st, c_ptr);
+	c_ptr += st.memsize;
+	blasfeo_create_dvec(n, &ss, c_ptr);
+	x = sx.pa;
+	s = ss.pa;
+
+	// x = inv(A) * e / n
+	for(ii=0; ii<n; ii++)
+		x[ii] = 1.0/n;
+	con_solve(n, sA, ai, aj, chol, 0, &sx, &st);
+	if(n==1)
+		return fabs(x[0]);
+	est = con_asum(n, x);
+	for(ii=0; ii<n; ii++)
+		{
+		s[ii] = x[ii]>=0.0 ? 1.0 : -1.0;
+		x[ii] = s[ii];
+		}
+	con_solve(n, sA, ai, aj, chol, 1, &sx, &st);
+	jj = con_iamax(n, x);
+
+	for(iter=2; ; iter++)
+		{
+		// x = inv(A) * e_j
+		for(ii=0; ii<n; ii++)
+			x[ii] = 0.0;
+		x[jj] = 1.0;
+		con_solve(n, sA, ai, aj, chol, 0, &sx, &st);
+		est_old = est;
+		est = con_asum(n, x);
+		// stop if the sign vector repeats, or the estimate does not increase
+		rep = 1;
+		for(ii=0; ii<n; ii++)
+			rep &= (x[ii]>=0.0 ? 1.0 : -1.0)==s[ii];
+		if(rep | est<=est_old)
+			break;
+		for(ii=0; ii<n; ii++)
+			{
+			s[ii] = x[ii]>=0.0 ? 1.0 : -1.0;
+			x[ii] = s[ii];
+			}
+		con_solve(n, sA, ai, aj, chol, 1, &sx, &st);
+		jlast = jj;
+		jj = con_iamax(n, x);
+		if(fabs(x[jlast])==fabs(x[jj]) | iter>=CON_ITMAX)
+			break;
+		}
+
+	// alternating sign vector, to catch the cases where the power method stalls
+	for(ii=0; ii<n; ii++)
+		x[ii] = (ii%2==0 ? 1.0 : -1.0) * (1.0 + (double) ii/(n-1));
+	con_solve(n, sA, ai, aj, chol, 0, &sx, &st);
+	tmp = con_asum(n, x);
+	tmp = 2.0*tmp/(3.0*n);
+	return tmp>est ? tmp : est;
+	}
+
+
+
+static void con_rcond(int n, struct blasfeo_dmat *sA, int ai, int aj, int chol, double anorm, double *rcond, void *work)
+	{
+	double ainvnm;
+	if(n<=0)
+		{
+		*rcond = 1.0;
+		return;
+		}
+	*rcond = 0.0;
+	if(anorm==0.0)
+		return;
+	ainvnm = con_est(n, sA, ai, aj, chol, work);
+	if(ainvnm!=0.0)
+		*rcond = (1.0/ainvnm)/anorm;
+	return;
+	}
+
+
+
+void blasfeo_dgecon(int n, struct blasfeo_dmat *sA, int ai, int aj, double anorm, double *rcond, void *work)
+	{
+	con_rcond(n, sA, ai, aj, 0, anorm, rcond, work);
+	}
+
+
+
+void blasfeo_dpocon(int n, struct blasfeo_dmat *sA, int ai, int aj, double anorm, double *rcond, void *work)
+	{
+	con_rcond(n, sA, ai, aj, 1, anorm, rcond, work);
+	}
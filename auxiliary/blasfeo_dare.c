@@ -0,0 +1,175 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+/*
+ * Discrete algebraic Riccati equation by the structure-preserving doubling algorithm
+ * (E. K.-W. Chu, H.-Y. Fan, W.-W. Lin, "A structure-preserving doubling algorithm for
+ * continuous-time algebraic Riccati equations", 2005, and its discrete-time version).
+ *
+ * The DARE is written as P = A^T * P * (I + G * P)^-1 * A + H with G = B * R^-1 * B^T and H = Q,
+ * and the doubling steps
+ *   A <= A * (I + G * H)^-1 * A
+ *   G <= G + A * (I + G * H)^-1 * G * A^T
+ *   H <= H + A^T * H * (I + G * H)^-1 * A
+ * make H converge quadratically to P, in place of the linear convergence of the Riccati recursion.
+ * (I + G * H)^-1 is applied to [A G] with one LU factorization with row pivoting per step.
+ */
+
+#include <math.h>
+
+#include <blasfeo_block_size.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_dare.h>
+
+
+
+// number of n x n work matrices (plus one n x 2n)
+#define DARE_NMAT 6
+
+
+
+int blasfeo_ddare_worksize(int n, int m)
+	{
+	if(n<=0)
+		return 0;
+	return DARE_NMAT*blasfeo_memsize_dmat(n, n) + blasfeo_memsize_dmat(n, 2*n) + blasfeo_memsize_dmat(m, m) + blasfeo_memsize_dmat(n, m) + (n*sizeof(int)+CACHE_LINE_SIZE-1)/CACHE_LINE_SIZE*CACHE_LINE_SIZE;
+	}
+
+
+
+// 1-norm (max column sum of abs values)
+static double dare_norm1(int n, struct blasfeo_dmat *sA)
+	{
+	int ii, jj;
+	double nrm = 0.0;
+	double tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		tmp = 0.0;
+		for(ii=0; ii<n; ii++)
+			tmp += fabs(BLASFEO_DMATEL(sA, ii, jj));
+		nrm = tmp>nrm ? tmp : nrm;
+		}
+	return nrm;
+	}
+
+
+
+int blasfeo_ddare(int n, int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sQ, int qi, int qj, struct blasfeo_dmat *sR, int ri, int rj, struct blasfeo_dmat *sP, int pi, int pj, double tol, int max_iter, void *work)
+	{
+	if(n<=0)
+		return 0;
+
+	struct blasfeo_dmat sX[DARE_NMAT];
+	struct blasfeo_dmat sY, sL, sBt;
+	struct blasfeo_dmat *sAk = sX+0;
+	struct blasfeo_dmat *sG = sX+1;
+	struct blasfeo_dmat *sH = sX+2;
+	struct blasfeo_dmat *sW = sX+3;
+	struct blasfeo_dmat *sT = sX+4;
+	struct blasfeo_dmat *sZ = sX+5;
+	struct blasfeo_dmat *sS;
+	int ii, it;
+	int *ipiv;
+	double nrm_d, nrm_h;
+
+	char *c_ptr = (char *) work;
+	for(ii=0; ii<DARE_NMAT; ii++)
+		{
+		blasfeo_create_dmat(n, n, sX+ii, c_ptr);
+		c_ptr += sX[ii].memsize;
+		}
+	blasfeo_create_dmat(n, 2*n, &sY, c_ptr);
+	c_ptr += sY.memsize;
+	blasfeo_create_dmat(m, m, &sL, c_ptr);
+	c_ptr += sL.memsize;
+	blasfeo_create_dmat(n, m, &sBt, c_ptr);
+	c_ptr += sBt.memsize;
+	ipiv = (int *) c_ptr;
+
+	// G <= B * R^-1 * B^T = (B * L^-T) * (B * L^-T)^T , with R = L * L^T
+	if(m>0)
+		{
+		blasfeo_dpotrf_l(m, sR, ri, rj, &sL, 0, 0);
+		blasfeo_dtrsm_rltn(n, m, 1.0, &sL, 0, 0, sB, bi, bj, &sBt, 0, 0);
+		blasfeo_dgemm_nt(n, n, m, 1.0, &sBt, 0, 0, &sBt, 0, 0, 0.0, sG, 0, 0, sG, 0, 0);
+		}
+	else
+		{
+		blasfeo_dgese(n, n, 0.0, sG, 0, 0);
+		}
+	blasfeo_dgecp(n, n, sA, ai, aj, sAk, 0, 0);
+	blasfeo_dgecp(n, n, sQ, qi, qj, sH, 0, 0);
+
+	for(it=0; it<max_iter; it++)
+		{
+		// [Y1 Y2] <= (I + G * H)^-1 * [A G]
+		blasfeo_dgemm_nn(n, n, n, 1.0, sG, 0, 0, sH, 0, 0, 0.0, sW, 0, 0, sW, 0, 0);
+		blasfeo_ddiare(n, 1.0, sW, 0, 0);
+		blasfeo_dgetrf_rp(n, n, sW, 0, 0, sW, 0, 0, ipiv);
+		blasfeo_dgecp(n, n, sAk, 0, 0, &sY, 0, 0);
+		blasfeo_dgecp(n, n, sG, 0, 0, &sY, 0, n);
+		blasfeo_drowpe(n, ipiv, &sY);
+		blasfeo_dtrsm_llnu(n, 2*n, 1.0, sW, 0, 0, &sY, 0, 0, &sY, 0, 0);
+		blasfeo_dtrsm_lunn(n, 2*n, 1.0, sW, 0, 0, &sY, 0, 0, &sY, 0, 0);
+
+		// G <= G + A * Y2 * A^T
+		blasfeo_dgemm_nn(n, n, n, 1.0, sAk, 0, 0, &sY, 0, n, 0.0, sT, 0, 0, sT, 0, 0);
+		blasfeo_dgemm_nt(n, n, n, 1.0, sT, 0, 0, sAk, 0, 0, 1.0, sG, 0, 0, sG, 0, 0);
+
+		// H <= H + A^T * H * Y1
+		blasfeo_dgemm_nn(n, n, n, 1.0, sH, 0, 0, &sY, 0, 0, 0.0, sZ, 0, 0, sZ, 0, 0);
+		blasfeo_dgemm_tn(n, n, n, 1.0, sAk, 0, 0, sZ, 0, 0, 0.0, sT, 0, 0, sT, 0, 0);
+		blasfeo_dgead(n, n, 1.0, sT, 0, 0, sH, 0, 0);
+
+		// A <= A * Y1
+		blasfeo_dgemm_nn(n, n, n, 1.0, sAk, 0, 0, &sY, 0, 0, 0.0, sZ, 0, 0, sZ, 0, 0);
+		sS = sAk;
+		sAk = sZ;
+		sZ = sS;
+
+		nrm_d = dare_norm1(n, sT);
+		nrm_h = dare_norm1(n, sH);
+		if(nrm_d<=tol*nrm_h)
+			break;
+		}
+
+	blasfeo_dgecp(n, n, sH, 0, 0, sP, pi, pj);
+
+	return it<max_iter ? it+1 : -1;
+	}
@@ -0,0 +1,230 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * gemm_nt and syrk_ln with fused epilogue.
+ *
+ * D is computed by tiles, and the post-operations are applied to each tile right after the
+ * gemm/syrk call that produced it, while the tile is still in cache, instead of re-reading the
+ * whole D from memory once per post-operation. The scaling is folded into alpha and beta.
+ */
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_epilogue.h>
+
+
+
+// size of the tiles of D; their row boundaries are aligned to EP_BLK rows of D, and so to its panels
+#define EP_BLK 64
+// D up to this many elements stays in cache as a whole and is not split in tiles
+#define EP_SMALL (256*256)
+// width of the column strips of the diagonal tiles in the lower to upper copy
+#define EP_TR 8
+
+
+
+// end of the tile of size blk (0 for no split) starting at x; the tiles also stop at the side s of the symmetrized square
+static int ep_tile_end(int x, int off, int blk, int s, int end)
+	{
+	int y = blk>0 ? x + blk - (off+x)%blk : end;
+	if(x<s & y>s)
+		y = s;
+	return y<end ? y : end;
+	}
+
+
+
+// apply the element-wise post-operations to the tile [r0,r1) x [c0,c1) of D ; lower triangle only if tri
+static void ep_tile_post(struct blasfeo_dgemm_ep *ep, struct blasfeo_dmat *sD, int di, int dj, int r0, int r1, int c0, int c1, int tri)
+	{
+	int flags = ep->flags;
+	int colad = (flags & BLASFEO_EP_COLAD)!=0;
+	int clip = (flags & BLASFEO_EP_CLIP)!=0;
+	int ii, jj, i0;
+	double tmp, y_j;
+	// local copies, that the compiler can not assume to be aliased by D
+	double dia_alpha = ep->dia_alpha;
+	double lo = ep->lo;
+	double up = ep->up;
+	double *x_dia = (flags & BLASFEO_EP_DIAAD)!=0 & ep->sx_dia!=NULL ? ep->sx_dia->pa + ep->xi_dia : NULL;
+	double *x_col = colad ? ep->sx_col->pa + ep->xi_col : NULL;
+	double *x_row = flags & BLASFEO_EP_ROWAD ? ep->sx_row->pa + ep->xi_row : NULL;
+
+	if(flags & BLASFEO_EP_DIAAD)
+		{
+		i0 = r0>c0 ? r0 : c0;
+		for(ii=i0; ii<r1 & ii<c1; ii++)
+			BLASFEO_DMATEL(sD, di+ii, dj+ii) += x_dia==NULL ? dia_alpha : dia_alpha*x_dia[ii];
+		}
+
+	if(!(flags & (BLASFEO_EP_COLAD | BLASFEO_EP_ROWAD | BLASFEO_EP_CLIP)))
+		return;
+
+	for(jj=c0; jj<c1; jj++)
+		{
+		i0 = tri & jj>r0 ? jj : r0;
+		y_j = x_row!=NULL ? x_row[jj] : 0.0;
+		if(clip)
+			{
+			for(ii=i0; ii<r1; ii++)
+				{
+				tmp = BLASFEO_DMATEL(sD, di+ii, dj+jj) + y_j;
+				if(colad)
+					tmp += x_col[ii];
+				tmp = tmp<lo ? lo : tmp;
+				tmp = tmp>up ? up : tmp;
+				BLASFEO_DMATEL(sD, di+ii, dj+jj) = tmp;
+				}
+			}
+		else if(colad)
+			{
+			for(ii=i0; ii<r1; ii++)
+				BLASFEO_DMATEL(sD, di+ii, dj+jj) += y_j + x_col[ii];
+			}
+		else
+			{
+			for(ii=i0; ii<r1; ii++)
+				BLASFEO_DMATEL(sD, di+ii, dj+jj) += y_j;
+			}
+		}
+
+	return;
+	}
+
+
+
+// copy the lower triangle of the diagonal tile [r0,r1) x [r0,r1) of D to the upper one, by strips of
+// EP_TR columns; the part below the diagonal block of a strip is transposed with dgetr (not with dtrtr_l,
+// that in lib8 writes past the triangle)
+static void ep_tile_symm(struct blasfeo_dmat *sD, int di, int dj, int r0, int r1)
+	{
+	int ii, jj, ll, nb;
+
+	for(jj=r0; jj<r1; jj+=nb)
+		{
+		nb = r1-jj<EP_TR ? r1-jj : EP_TR;
+		for(ll=jj; ll<jj+nb; ll++)
+			for(ii=ll+1; ii<jj+nb; ii++)
+				BLASFEO_DMATEL(sD, di+ll, dj+ii) = BLASFEO_DMATEL(sD, di+ii, dj+ll);
+		if(jj+nb<r1)
+			blasfeo_dgetr(r1-jj-nb, nb, sD, di+jj+nb, dj+jj, sD, di+jj, dj+jj+nb);
+		}
+
+	return;
+	}
+
+
+
+// tiled gemm_nt (syrk_ln if syrk) with epilogue
+static void ep_dgemm_tiles(int syrk, int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dgemm_ep *ep)
+	{
+	int symm = (ep->flags & BLASFEO_EP_SYMM)!=0;
+	// side of the symmetrized leading square
+	int s = symm ? (m<n ? m : n) : 0;
+	int blk = m<=EP_SMALL/n ? 0 : EP_BLK;
+	int r0, r1, c0, c1, sq;
+
+	if(ep->flags & BLASFEO_EP_SCALE)
+		{
+		alpha *= ep->scale;
+		beta *= ep->scale;
+		}
+
+	// rows and columns share the same tile boundaries, so that tiles with r0==c0 hold the diagonal
+	for(r0=0; r0<m; r0=r1)
+		{
+		r1 = ep_tile_end(r0, di, blk, s, m);
+		for(c0=0; c0<n; c0=c1)
+			{
+			c1 = ep_tile_end(c0, di, blk, s, n);
+			sq = r1<=s & c1<=s;
+			// strictly upper tiles: not computed by syrk, copied from the lower ones by symm
+			if(c0>=r1 & syrk)
+				break;
+			if(c0>=r1 & sq)
+				continue;
+			if(syrk & r0==c0)
+				blasfeo_dsyrk_ln(r1-r0, k, alpha, sA, ai+r0, aj, sB, bi+c0, bj, beta, sC, ci+r0, cj+c0, sD, di+r0, dj+c0);
+			else
+				blasfeo_dgemm_nt(r1-r0, c1-c0, k, alpha, sA, ai+r0, aj, sB, bi+c0, bj, beta, sC, ci+r0, cj+c0, sD, di+r0, dj+c0);
+			ep_tile_post(ep, sD, di, dj, r0, r1, c0, c1, r0==c0 & (syrk | sq));
+			if(symm & sq)
+				{
+				if(r0==c0)
+					{
+					ep_tile_symm(sD, di, dj, r0, r1);
+					}
+				else
+					{
+					blasfeo_dgetr(r1-r0, c1-c0, sD, di+r0, dj+c0, sD, di+c0, dj+r0);
+					}
+				}
+			}
+		}
+
+	return;
+	}
+
+
+
+void blasfeo_dgemm_nt_ep(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dgemm_ep *ep)
+	{
+	if(m<=0 | n<=0)
+		return;
+	if(ep==NULL || ep->flags==0)
+		{
+		blasfeo_dgemm_nt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+		return;
+		}
+	ep_dgemm_tiles(0, m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj, ep);
+	return;
+	}
+
+
+
+void blasfeo_dsyrk_ln_ep(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dgemm_ep *ep)
+	{
+	if(m<=0)
+		return;
+	if(ep==NULL || ep->flags==0)
+		{
+		blasfeo_dsyrk_ln(m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+		return;
+		}
+	ep_dgemm_tiles(1, m, m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj, ep);
+	return;
+	}
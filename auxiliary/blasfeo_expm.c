@@ -0,0 +1,271 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+/*
+ * Matrix exponential and phi1 function by scaling and squaring of a Pade approximant
+ * (N. J. Higham, "The scaling and squaring method for the matrix exponential revisited", 2005).
+ *
+ * The Pade degree m in {3,5,7,9,13} is the lowest one whose backward error bound theta_m is
+ * above the 1-norm of A; only for m=13 the matrix is scaled by 2^-s. The numerator and
+ * denominator are built from the even powers of A as V + U and V - U, with U = A * T, and the
+ * approximant is computed with an LU factorization with row pivoting and two triangular solves.
+ *
+ * phi1 is the top-right block of the exponential of the augmented matrix [A I; 0 0], whose powers
+ * have the block structure [A^j A^(j-1); 0 0]: the Pade approximant of the augmented matrix only
+ * needs the extra right-hand side 2*T in the solve with the same LU factorization, and each
+ * squaring step [E P; 0 I]^2 = [E*E E*P+P; 0 I] only needs one extra gemm.
+ */
+
+#include <math.h>
+
+#include <blasfeo_block_size.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_expm.h>
+
+
+
+// number of n x n work matrices
+#define EXPM_NMAT 7
+
+
+
+// Pade degrees, and corresponding max 1-norm for double precision accuracy
+static const int expm_deg[5] = {3, 5, 7, 9, 13};
+static const double expm_theta[5] = {1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0};
+
+// coefficients of the Pade approximants
+static const double expm_b3[4] = {120.0, 60.0, 12.0, 1.0};
+static const double expm_b5[6] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+static const double expm_b7[8] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+static const double expm_b9[10] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0, 2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+static const double expm_b13[14] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0, 1187353796428800.0, 129060195264000.0, 10559470521600.0, 670442572800.0, 33522128640.0, 1323241920.0, 40840800.0, 960960.0, 16380.0, 182.0, 1.0};
+static const double *expm_b[5] = {expm_b3, expm_b5, expm_b7, expm_b9, expm_b13};
+
+
+
+int blasfeo_dexpm_worksize(int n)
+	{
+	if(n<=0)
+		return 0;
+	return EXPM_NMAT*blasfeo_memsize_dmat(n, n) + (n*sizeof(int)+CACHE_LINE_SIZE-1)/CACHE_LINE_SIZE*CACHE_LINE_SIZE;
+	}
+
+
+
+// 1-norm (max column sum of abs values)
+static double expm_norm1(int n, struct blasfeo_dmat *sA, int ai, int aj)
+	{
+	int ii, jj;
+	double nrm = 0.0;
+	double tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		tmp = 0.0;
+		for(ii=0; ii<n; ii++)
+			tmp += fabs(BLASFEO_DMATEL(sA, ai+ii, aj+jj));
+		nrm = tmp>nrm ? tmp : nrm;
+		}
+	return nrm;
+	}
+
+
+
+// swap two (sub-)matrices
+static void expm_swap(struct blasfeo_dmat **sX0, int *x0i, int *x0j, struct blasfeo_dmat **sX1, int *x1i, int *x1j)
+	{
+	struct blasfeo_dmat *sS = *sX0;
+	int ti = *x0i;
+	int tj = *x0j;
+	*sX0 = *sX1;
+	*x0i = *x1i;
+	*x0j = *x1j;
+	*sX1 = sS;
+	*x1i = ti;
+	*x1j = tj;
+	}
+
+
+
+// D <= exp( A ) , and P <= phi1( A ) if sP is not NULL
+static void expm_pade(int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dmat *sP, int pi, int pj, void *work)
+	{
+
+	struct blasfeo_dmat sA0, sA2, sA4, sA6, sT, sU, sV;
+	struct blasfeo_dmat *sW[EXPM_NMAT] = {&sA0, &sA2, &sA4, &sA6, &sT, &sU, &sV};
+	struct blasfeo_dmat *sX[4]; // even powers A^2 ... A^8
+	struct blasfeo_dmat *sE0, *sE1, *sP0, *sP1;
+	int e0i, e0j, e1i, e1j, p0i, p0j, p1i, p1j;
+	int ii, kk, q, s, idx, m;
+	int *ipiv;
+	const double *b;
+	double nrm;
+
+	char *c_ptr = (char *) work;
+	for(ii=0; ii<EXPM_NMAT; ii++)
+		{
+		blasfeo_create_dmat(n, n, sW[ii], c_ptr);
+		c_ptr += sW[ii]->memsize;
+		}
+	ipiv = (int *) c_ptr;
+
+	// Pade degree and scaling; the 1-norm of [A I; 0 0] is at least 1
+	nrm = expm_norm1(n, sA, ai, aj);
+	if(sP!=NULL & nrm<1.0)
+		nrm = 1.0;
+	for(idx=0; idx<4; idx++)
+		{
+		if(nrm<=expm_theta[idx])
+			break;
+		}
+	s = 0;
+	if(idx==4 & nrm>expm_theta[4])
+		s = (int) ceil(log2(nrm/expm_theta[4]));
+	m = expm_deg[idx];
+	b = expm_b[idx];
+	q = m/2;
+
+	// even powers of the scaled A
+	blasfeo_dgecpsc(n, n, ldexp(1.0, -s), sA, ai, aj, &sA0, 0, 0);
+	blasfeo_dgemm_nn(n, n, n, 1.0, &sA0, 0, 0, &sA0, 0, 0, 0.0, &sA2, 0, 0, &sA2, 0, 0);
+	if(m>=5)
+		blasfeo_dgemm_nn(n, n, n, 1.0, &sA2, 0, 0, &sA2, 0, 0, 0.0, &sA4, 0, 0, &sA4, 0, 0);
+	if(m>=7)
+		blasfeo_dgemm_nn(n, n, n, 1.0, &sA4, 0, 0, &sA2, 0, 0, 0.0, &sA6, 0, 0, &sA6, 0, 0);
+	if(m==9) // A^8 in U, that is only computed at the end
+		blasfeo_dgemm_nn(n, n, n, 1.0, &sA4, 0, 0, &sA4, 0, 0, 0.0, &sU, 0, 0, &sU, 0, 0);
+	sX[0] = &sA2;
+	sX[1] = &sA4;
+	sX[2] = &sA6;
+	sX[3] = &sU;
+
+	if(m<13)
+		{
+		// T <= sum_k b_(2k+1) A^(2k) , V <= sum_k b_(2k) A^(2k)
+		blasfeo_dgecpsc(n, n, b[2*q+1], sX[q-1], 0, 0, &sT, 0, 0);
+		blasfeo_dgecpsc(n, n, b[2*q], sX[q-1], 0, 0, &sV, 0, 0);
+		for(kk=q-1; kk>=1; kk--)
+			{
+			blasfeo_dgead(n, n, b[2*kk+1], sX[kk-1], 0, 0, &sT, 0, 0);
+			blasfeo_dgead(n, n, b[2*kk], sX[kk-1], 0, 0, &sV, 0, 0);
+			}
+		blasfeo_ddiare(n, b[1], &sT, 0, 0);
+		blasfeo_ddiare(n, b[0], &sV, 0, 0);
+		}
+	else
+		{
+		// T <= A^6 * (b13 A^6 + b11 A^4 + b9 A^2) + b7 A^6 + b5 A^4 + b3 A^2 + b1 I
+		blasfeo_dgecpsc(n, n, b[13], &sA6, 0, 0, &sU, 0, 0);
+		blasfeo_dgead(n, n, b[11], &sA4, 0, 0, &sU, 0, 0);
+		blasfeo_dgead(n, n, b[9], &sA2, 0, 0, &sU, 0, 0);
+		blasfeo_dgecpsc(n, n, b[7], &sA6, 0, 0, &sT, 0, 0);
+		blasfeo_dgead(n, n, b[5], &sA4, 0, 0, &sT, 0, 0);
+		blasfeo_dgead(n, n, b[3], &sA2, 0, 0, &sT, 0, 0);
+		blasfeo_ddiare(n, b[1], &sT, 0, 0);
+		blasfeo_dgemm_nn(n, n, n, 1.0, &sA6, 0, 0, &sU, 0, 0, 1.0, &sT, 0, 0, &sT, 0, 0);
+		// V <= A^6 * (b12 A^6 + b10 A^4 + b8 A^2) + b6 A^6 + b4 A^4 + b2 A^2 + b0 I
+		blasfeo_dgecpsc(n, n, b[12], &sA6, 0, 0, &sU, 0, 0);
+		blasfeo_dgead(n, n, b[10], &sA4, 0, 0, &sU, 0, 0);
+		blasfeo_dgead(n, n, b[8], &sA2, 0, 0, &sU, 0, 0);
+		blasfeo_dgecpsc(n, n, b[6], &sA6, 0, 0, &sV, 0, 0);
+		blasfeo_dgead(n, n, b[4], &sA4, 0, 0, &sV, 0, 0);
+		blasfeo_dgead(n, n, b[2], &sA2, 0, 0, &sV, 0, 0);
+		blasfeo_ddiare(n, b[0], &sV, 0, 0);
+		blasfeo_dgemm_nn(n, n, n, 1.0, &sA6, 0, 0, &sU, 0, 0, 1.0, &sV, 0, 0, &sV, 0, 0);
+		}
+	// U <= A * T
+	blasfeo_dgemm_nn(n, n, n, 1.0, &sA0, 0, 0, &sT, 0, 0, 0.0, &sU, 0, 0, &sU, 0, 0);
+
+	// (V - U) in A2 (the powers are not needed any longer), (V + U) in V
+	blasfeo_dgecp(n, n, &sV, 0, 0, &sA2, 0, 0);
+	blasfeo_dgead(n, n, -1.0, &sU, 0, 0, &sA2, 0, 0);
+	blasfeo_dgead(n, n, 1.0, &sU, 0, 0, &sV, 0, 0);
+	blasfeo_dgetrf_rp(n, n, &sA2, 0, 0, &sA2, 0, 0, ipiv);
+
+	// the squaring steps alternate between the result and a work matrix, and end in the result
+	sE0 = sD; e0i = di; e0j = dj;
+	sE1 = &sU; e1i = 0; e1j = 0;
+	sP0 = sP; p0i = pi; p0j = pj;
+	sP1 = &sA4; p1i = 0; p1j = 0;
+	if(s%2!=0)
+		{
+		expm_swap(&sE0, &e0i, &e0j, &sE1, &e1i, &e1j);
+		expm_swap(&sP0, &p0i, &p0j, &sP1, &p1i, &p1j);
+		}
+
+	// E <= (V - U)^-1 * (V + U)
+	blasfeo_drowpe(n, ipiv, &sV);
+	blasfeo_dtrsm_llnu(n, n, 1.0, &sA2, 0, 0, &sV, 0, 0, &sV, 0, 0);
+	blasfeo_dtrsm_lunn(n, n, 1.0, &sA2, 0, 0, &sV, 0, 0, sE0, e0i, e0j);
+	if(sP!=NULL)
+		{
+		// P <= 2^(1-s) * (V - U)^-1 * T
+		blasfeo_drowpe(n, ipiv, &sT);
+		blasfeo_dtrsm_llnu(n, n, ldexp(1.0, 1-s), &sA2, 0, 0, &sT, 0, 0, &sT, 0, 0);
+		blasfeo_dtrsm_lunn(n, n, 1.0, &sA2, 0, 0, &sT, 0, 0, sP0, p0i, p0j);
+		}
+
+	// squaring
+	for(kk=0; kk<s; kk++)
+		{
+		if(sP!=NULL)
+			blasfeo_dgemm_nn(n, n, n, 1.0, sE0, e0i, e0j, sP0, p0i, p0j, 1.0, sP0, p0i, p0j, sP1, p1i, p1j);
+		blasfeo_dgemm_nn(n, n, n, 1.0, sE0, e0i, e0j, sE0, e0i, e0j, 0.0, sE1, e1i, e1j, sE1, e1i, e1j);
+		expm_swap(&sE0, &e0i, &e0j, &sE1, &e1i, &e1j);
+		expm_swap(&sP0, &p0i, &p0j, &sP1, &p1i, &p1j);
+		}
+
+	return;
+	}
+
+
+
+void blasfeo_dexpm(int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj, void *work)
+	{
+	if(n<=0)
+		return;
+	expm_pade(n, sA, ai, aj, sD, di, dj, NULL, 0, 0, work);
+	}
+
+
+
+void blasfeo_dexpm_phi1(int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dmat *sP, int pi, int pj, void *work)
+	{
+	if(n<=0)
+		return;
+	expm_pade(n, sA, ai, aj, sD, di, dj, sP, pi, pj, work);
+	}
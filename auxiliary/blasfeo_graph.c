@@ -0,0 +1,282 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_d_blasfeo_hp_api.h>
+#include <blasfeo_graph.h>
+
+
+
+// replay calls the implementation behind the recording public routines, that does not record again
+#if defined(LA_HIGH_PERFORMANCE) & defined(MF_PANELMAJ)
+#define GRAPH_D(routine) blasfeo_hp_d##routine
+#else
+#define GRAPH_D(routine) blasfeo_d##routine
+#endif
+
+
+
+static struct blasfeo_graph *graph_capture = NULL;
+
+
+
+static void node_dgemm_nn(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(gemm_nn)(nd->m, nd->n, nd->k, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->beta, nd->sM[2], nd->mi[2], nd->mj[2], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dgemm_nt(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(gemm_nt)(nd->m, nd->n, nd->k, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->beta, nd->sM[2], nd->mi[2], nd->mj[2], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dsyrk_ln(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(syrk_ln)(nd->m, nd->k, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->beta, nd->sM[2], nd->mi[2], nd->mj[2], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dtrsm_rltn(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(trsm_rltn)(nd->m, nd->n, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dtrmm_rlnn(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(trmm_rlnn)(nd->m, nd->n, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dpotrf_l(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(potrf_l)(nd->m, nd->sM[2], nd->mi[2], nd->mj[2], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dsyrk_dpotrf_ln(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(syrk_dpotrf_ln)(nd->m, nd->k, nd->sM[0], nd->mi[0], nd->mj[0], nd->sM[1], nd->mi[1], nd->mj[1], nd->sM[2], nd->mi[2], nd->mj[2], nd->sM[3], nd->mi[3], nd->mj[3]);
+	}
+
+static void node_dgemv_n(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(gemv_n)(nd->m, nd->n, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sv[0], nd->vi[0], nd->beta, nd->sv[1], nd->vi[1], nd->sv[2], nd->vi[2]);
+	}
+
+static void node_dgemv_t(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(gemv_t)(nd->m, nd->n, nd->alpha, nd->sM[0], nd->mi[0], nd->mj[0], nd->sv[0], nd->vi[0], nd->beta, nd->sv[1], nd->vi[1], nd->sv[2], nd->vi[2]);
+	}
+
+static void node_dtrsv_lnn(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(trsv_lnn)(nd->m, nd->sM[0], nd->mi[0], nd->mj[0], nd->sv[0], nd->vi[0], nd->sv[2], nd->vi[2]);
+	}
+
+static void node_dtrsv_ltn(struct blasfeo_graph_node *nd)
+	{
+	GRAPH_D(trsv_ltn)(nd->m, nd->sM[0], nd->mi[0], nd->mj[0], nd->sv[0], nd->vi[0], nd->sv[2], nd->vi[2]);
+	}
+
+static void (*graph_fun[BLASFEO_GRAPH_N_OPS])(struct blasfeo_graph_node *nd) =
+	{
+	node_dgemm_nn,
+	node_dgemm_nt,
+	node_dsyrk_ln,
+	node_dtrsm_rltn,
+	node_dtrmm_rlnn,
+	node_dpotrf_l,
+	node_dsyrk_dpotrf_ln,
+	node_dgemv_n,
+	node_dgemv_t,
+	node_dtrsv_lnn,
+	node_dtrsv_ltn,
+	};
+
+
+
+size_t blasfeo_graph_memsize(int max_nodes)
+	{
+	return max_nodes*sizeof(struct blasfeo_graph_node);
+	}
+
+
+
+void blasfeo_graph_create(int max_nodes, struct blasfeo_graph *graph, void *memory)
+	{
+	graph->nodes = (struct blasfeo_graph_node *) memory;
+	graph->max_nodes = max_nodes;
+	graph->n_nodes = 0;
+	graph->overflow = 0;
+	graph->memsize = blasfeo_graph_memsize(max_nodes);
+	}
+
+
+
+void blasfeo_graph_begin(struct blasfeo_graph *graph)
+	{
+	graph->n_nodes = 0;
+	graph->overflow = 0;
+	graph_capture = graph;
+	}
+
+
+
+void blasfeo_graph_end()
+	{
+	graph_capture = NULL;
+	}
+
+
+
+static struct blasfeo_graph_node *graph_new_node(int op, int m, int n, int k, double alpha, double beta)
+	{
+	struct blasfeo_graph *graph = graph_capture;
+	struct blasfeo_graph_node *nd;
+	int ii;
+	if(graph->n_nodes>=graph->max_nodes)
+		{
+		graph->overflow = 1;
+		return NULL;
+		}
+	nd = graph->nodes + graph->n_nodes;
+	graph->n_nodes++;
+	nd->fun = graph_fun[op];
+	nd->op = op;
+	nd->m = m;
+	nd->n = n;
+	nd->k = k;
+	nd->alpha = alpha;
+	nd->beta = beta;
+	for(ii=0; ii<4; ii++)
+		{
+		nd->sM[ii] = NULL;
+		nd->mi[ii] = 0;
+		nd->mj[ii] = 0;
+		}
+	for(ii=0; ii<3; ii++)
+		{
+		nd->sv[ii] = NULL;
+		nd->vi[ii] = 0;
+		}
+	return nd;
+	}
+
+
+
+void blasfeo_graph_record_m(int op, int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	struct blasfeo_graph_node *nd;
+	if(graph_capture==NULL)
+		return;
+	nd = graph_new_node(op, m, n, k, alpha, beta);
+	if(nd==NULL)
+		return;
+	nd->sM[0] = sA;
+	nd->mi[0] = ai;
+	nd->mj[0] = aj;
+	nd->sM[1] = sB;
+	nd->mi[1] = bi;
+	nd->mj[1] = bj;
+	nd->sM[2] = sC;
+	nd->mi[2] = ci;
+	nd->mj[2] = cj;
+	nd->sM[3] = sD;
+	nd->mi[3] = di;
+	nd->mj[3] = dj;
+	}
+
+
+
+void blasfeo_graph_record_v(int op, int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	struct blasfeo_graph_node *nd;
+	if(graph_capture==NULL)
+		return;
+	nd = graph_new_node(op, m, n, 0, alpha, beta);
+	if(nd==NULL)
+		return;
+	nd->sM[0] = sA;
+	nd->mi[0] = ai;
+	nd->mj[0] = aj;
+	nd->sv[0] = sx;
+	nd->vi[0] = xi;
+	nd->sv[1] = sy;
+	nd->vi[1] = yi;
+	nd->sv[2] = sz;
+	nd->vi[2] = zi;
+	}
+
+
+
+int blasfeo_graph_fuse(struct blasfeo_graph *graph)
+	{
+	struct blasfeo_graph_node *syrk, *potrf;
+	int ii, jj;
+	int n_fused = 0;
+	for(ii=0, jj=0; ii<graph->n_nodes; ii++, jj++)
+		{
+		syrk = graph->nodes + ii;
+		potrf = graph->nodes + ii + 1;
+		// the syrk result is overwritten by the factorization, so it is never observed
+		if(ii+1<graph->n_nodes & syrk->op==BLASFEO_GRAPH_DSYRK_LN & potrf->op==BLASFEO_GRAPH_DPOTRF_L &
+			syrk->alpha==1.0 & syrk->beta==1.0 & potrf->m==syrk->m &
+			potrf->sM[2]==syrk->sM[3] & potrf->mi[2]==syrk->mi[3] & potrf->mj[2]==syrk->mj[3] &
+			potrf->sM[3]==syrk->sM[3] & potrf->mi[3]==syrk->mi[3] & potrf->mj[3]==syrk->mj[3])
+			{
+			graph->nodes[jj] = *syrk;
+			graph->nodes[jj].op = BLASFEO_GRAPH_DSYRK_DPOTRF_LN;
+			graph->nodes[jj].fun = graph_fun[BLASFEO_GRAPH_DSYRK_DPOTRF_LN];
+			n_fused++;
+			ii++;
+			}
+		else
+			{
+			graph->nodes[jj] = *syrk;
+			}
+		}
+	graph->n_nodes = jj;
+	return n_fused;
+	}
+
+
+
+void blasfeo_graph_replay(struct blasfeo_graph *graph)
+	{
+	struct blasfeo_graph_node *nd = graph->nodes;
+	struct blasfeo_graph_node *nd_end = graph->nodes + graph->n_nodes;
+	for(; nd<nd_end; nd++)
+		nd->fun(nd);
+	}
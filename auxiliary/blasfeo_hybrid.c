@@ -0,0 +1,336 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * Size-based dispatch of the column-major blasfeo_d* routines to the external BLAS and LAPACK.
+ *
+ * The column-major blasfeo_dmat has the same layout as a Fortran matrix with leading dimension
+ * sA->m, so the external routines are called in place on the sub-matrix pointers. Small calls
+ * stay with the BLASFEO kernels, large ones go to the (possibly multi-threaded) external library.
+ */
+
+#include <stdlib.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_hybrid.h>
+
+#if defined(HYBRID_EXTERNAL_BLAS)
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_timing.h>
+#include <d_blas.h>
+#endif
+
+
+
+#if defined(HYBRID_EXTERNAL_BLAS)
+
+
+
+// default thresholds: about a 256x256x256 gemm, no size below 64
+static double hybrid_flops = 2.0*256*256*256;
+static int hybrid_min_dim = 64;
+
+// calibration sizes
+#define HYBRID_CAL_N 10
+static int hybrid_cal_size[HYBRID_CAL_N] = {16, 32, 64, 96, 128, 192, 256, 384, 512, 768};
+
+
+
+static int hybrid_external(double flops, int min_size)
+	{
+	return hybrid_flops>=0.0 & flops>=hybrid_flops & min_size>=hybrid_min_dim;
+	}
+
+
+
+// D <= C, m x n sub-matrix (lower triangle only if lower!=0), skipped if in place
+static void hybrid_dgecp(int m, int n, int lower, double *C, int ldc, double *D, int ldd)
+	{
+	int ii, jj;
+	if(C==D & ldc==ldd)
+		return;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ii=lower ? jj : 0; ii<m; ii++)
+			D[ii+jj*ldd] = C[ii+jj*ldc];
+		}
+	return;
+	}
+
+
+
+void blasfeo_hybrid_set_threshold(double flops, int min_dim)
+	{
+	hybrid_flops = flops;
+	hybrid_min_dim = min_dim;
+	return;
+	}
+
+
+
+void blasfeo_hybrid_get_threshold(double *flops, int *min_dim)
+	{
+	*flops = hybrid_flops;
+	*min_dim = hybrid_min_dim;
+	return;
+	}
+
+
+
+int blasfeo_hybrid_dgemm(char ta, char tb, int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	int min_size = m<n ? (m<k ? m : k) : (n<k ? n : k);
+	if(!hybrid_external(2.0*m*n*k, min_size))
+		return 0;
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldc = sC->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pB = sB->pA + bi + bj*ldb;
+	double *pC = sC->pA + ci + cj*ldc;
+	double *pD = sD->pA + di + dj*ldd;
+	if(beta!=0.0)
+		hybrid_dgecp(m, n, 0, pC, ldc, pD, ldd);
+	dgemm_(&ta, &tb, &m, &n, &k, &alpha, pA, &lda, pB, &ldb, &beta, pD, &ldd);
+	sD->use_dA = 0;
+	return 1;
+	}
+
+
+
+// only the symmetric case A==B maps to dsyrk
+int blasfeo_hybrid_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(sA!=sB | ai!=bi | aj!=bj)
+		return 0;
+	if(!hybrid_external(1.0*m*(m+1)*k, m<k ? m : k))
+		return 0;
+	char c_l = 'l';
+	char c_n = 'n';
+	int lda = sA->m;
+	int ldc = sC->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pC = sC->pA + ci + cj*ldc;
+	double *pD = sD->pA + di + dj*ldd;
+	if(beta!=0.0)
+		hybrid_dgecp(m, m, 1, pC, ldc, pD, ldd);
+	dsyrk_(&c_l, &c_n, &m, &k, &alpha, pA, &lda, &beta, pD, &ldd);
+	sD->use_dA = 0;
+	return 1;
+	}
+
+
+
+int blasfeo_hybrid_dtrsm_rltn(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(!hybrid_external(1.0*m*n*n, m<n ? m : n))
+		return 0;
+	char c_l = 'l';
+	char c_n = 'n';
+	char c_r = 'r';
+	char c_t = 't';
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pB = sB->pA + bi + bj*ldb;
+	double *pD = sD->pA + di + dj*ldd;
+	hybrid_dgecp(m, n, 0, pB, ldb, pD, ldd);
+	dtrsm_(&c_r, &c_l, &c_t, &c_n, &m, &n, &alpha, pA, &lda, pD, &ldd);
+	sD->use_dA = 0;
+	return 1;
+	}
+
+
+
+// if the matrix is not positive definite and the factorization is out of place, the call is
+// left to BLASFEO, that zeroes the non-positive pivots and completes the factorization
+int blasfeo_hybrid_dpotrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(!hybrid_external(1.0/3.0*m*m*m, m))
+		return 0;
+	char c_l = 'l';
+	int info;
+	int ldc = sC->m;
+	int ldd = sD->m;
+	double *pC = sC->pA + ci + cj*ldc;
+	double *pD = sD->pA + di + dj*ldd;
+	hybrid_dgecp(m, m, 1, pC, ldc, pD, ldd);
+	dpotrf_(&c_l, &m, pD, &ldd, &info);
+	sD->use_dA = 0;
+	if(info!=0 & (pC!=pD | ldc!=ldd))
+		return 0;
+	return 1;
+	}
+
+
+
+double blasfeo_hybrid_calibrate()
+	{
+	int ii, jj, rep, nrep, n;
+	double t_hp, t_ext, tmp;
+	char c_n = 'n';
+	double alpha = 1.0;
+	double beta = 0.0;
+	int n_max = hybrid_cal_size[HYBRID_CAL_N-1];
+	blasfeo_timer timer;
+
+	int size = blasfeo_memsize_dmat(n_max, n_max);
+	void *mem = malloc(3*size+64);
+	char *mem_align = (char *) ( ( ( (unsigned long long) mem ) + 63 ) / 64 * 64 );
+	struct blasfeo_dmat sA, sB, sC;
+	blasfeo_create_dmat(n_max, n_max, &sA, mem_align);
+	blasfeo_create_dmat(n_max, n_max, &sB, mem_align+size);
+	blasfeo_create_dmat(n_max, n_max, &sC, mem_align+2*size);
+	for(ii=0; ii<n_max*n_max; ii++)
+		{
+		sA.pA[ii] = 1.0/(ii%13+1);
+		sB.pA[ii] = 1.0/(ii%17+1);
+		sC.pA[ii] = 0.0;
+		}
+
+	// BLASFEO timings with the dispatch off
+	hybrid_flops = -1.0;
+
+	double threshold = -1.0;
+	int n_win = 0;
+	for(jj=0; jj<HYBRID_CAL_N; jj++)
+		{
+		n = hybrid_cal_size[jj];
+		nrep = 2e8/(2.0*n*n*n);
+		nrep = nrep<1 ? 1 : nrep;
+		t_hp = 1e30;
+		t_ext = 1e30;
+		// best of 3 for each library
+		for(ii=0; ii<3; ii++)
+			{
+			blasfeo_tic(&timer);
+			for(rep=0; rep<nrep; rep++)
+				blasfeo_dgemm_nn(n, n, n, alpha, &sA, 0, 0, &sB, 0, 0, beta, &sC, 0, 0, &sC, 0, 0);
+			tmp = blasfeo_toc(&timer);
+			t_hp = tmp<t_hp ? tmp : t_hp;
+			blasfeo_tic(&timer);
+			for(rep=0; rep<nrep; rep++)
+				dgemm_(&c_n, &c_n, &n, &n, &n, &alpha, sA.pA, &sA.m, sB.pA, &sB.m, &beta, sC.pA, &sC.m);
+			tmp = blasfeo_toc(&timer);
+			t_ext = tmp<t_ext ? tmp : t_ext;
+			}
+		// the external library has to win at two consecutive sizes
+		if(t_ext<t_hp)
+			{
+			n_win++;
+			if(n_win==2)
+				{
+				n = hybrid_cal_size[jj-1];
+				threshold = 2.0*n*n*n;
+				break;
+				}
+			}
+		else
+			{
+			n_win = 0;
+			}
+		}
+
+	free(mem);
+
+	// external library never faster: keep BLASFEO up to the largest size and beyond
+	if(threshold<0.0)
+		threshold = 1e300;
+	hybrid_flops = threshold;
+	return threshold;
+	}
+
+
+
+#else // HYBRID_EXTERNAL_BLAS
+
+
+
+void blasfeo_hybrid_set_threshold(double flops, int min_dim)
+	{
+	return;
+	}
+
+
+
+void blasfeo_hybrid_get_threshold(double *flops, int *min_dim)
+	{
+	*flops = -1.0;
+	*min_dim = 0;
+	return;
+	}
+
+
+
+double blasfeo_hybrid_calibrate()
+	{
+	return -1.0;
+	}
+
+
+
+int blasfeo_hybrid_dgemm(char ta, char tb, int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	return 0;
+	}
+
+
+
+int blasfeo_hybrid_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	return 0;
+	}
+
+
+
+int blasfeo_hybrid_dtrsm_rltn(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	return 0;
+	}
+
+
+
+int blasfeo_hybrid_dpotrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	return 0;
+	}
+
+
+
+#endif // HYBRID_EXTERNAL_BLAS
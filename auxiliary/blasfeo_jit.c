@@ -0,0 +1,631 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * Runtime generation of straight-line AVX2/FMA dgemm kernels for small panel-major matrices.
+ *
+ * D is computed in tiles of up to 12 rows (3 panels) times 4 columns, held in ymm0-ymm11;
+ * ymm12-ymm14 hold the current column of A and ymm15 the broadcast element of B.
+ * The loop over k is fully unrolled up to JIT_UNROLL_K, otherwise a loop with 4 unrolled
+ * iterations is emitted. Partial panels of D are stored with vmaskmovpd.
+ *
+ * Generated code is written to a private buffer, copied to its own mapping and then made
+ * executable, so that code in the cache is never writable. The cache is keyed by shape and
+ * alpha/beta class, lookup is lock-free and insertion is protected by a spin lock.
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <blasfeo_target.h>
+#include <blasfeo_jit.h>
+
+#if defined(BLASFEO_JIT)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+
+#if defined(BLASFEO_JIT)
+
+
+
+// max k of the fully unrolled kernels
+#define JIT_UNROLL_K 16
+
+// x86-64 registers
+#define RAX 0
+#define RCX 1
+#define RDX 2
+#define RBX 3
+#define RSP 4
+#define RBP 5
+#define RSI 6
+#define RDI 7
+#define R8 8
+#define R9 9
+#define R10 10
+#define R11 11
+#define R12 12
+#define R13 13
+#define R14 14
+#define R15 15
+
+// register allocation
+#define ARGS RDI // struct blasfeo_jit_dgemm_args
+#define A0 R13 // A, first row group
+#define A_GRP R8 // A, current row group
+#define A_WALK RAX // A, current k
+#define B_GRP R9 // B, current column group
+#define B_WALK RBP // B, current k
+#define C_COL R14 // C, current column group
+#define D_COL R15 // D, current column group
+#define C_TILE R10 // C, current tile
+#define D_TILE R11 // D, current tile
+#define SDA RSI
+#define SDB RDX
+#define SDC RCX
+#define SDD RBX
+#define CNT R12 // loop counter, mask address
+
+// VEX opcode maps and prefixes
+#define MAP_0F 1
+#define MAP_0F38 2
+#define PP_66 1
+
+#define NO_REG -1
+
+// masks of the first 1, 2, 3 rows of a panel
+static const long long jit_mask[4][4] =
+	{
+	{0, 0, 0, 0},
+	{-1, 0, 0, 0},
+	{-1, -1, 0, 0},
+	{-1, -1, -1, 0},
+	};
+
+
+
+struct jit_code
+	{
+	unsigned char *buf;
+	int size;
+	int cap;
+	int error;
+	};
+
+
+
+static void emit_byte(struct jit_code *c, int b)
+	{
+	if(c->size>=c->cap)
+		{
+		int cap = c->cap ? 2*c->cap : 4096;
+		unsigned char *buf = realloc(c->buf, cap);
+		if(buf==NULL)
+			{
+			c->error = 1;
+			return;
+			}
+		c->buf = buf;
+		c->cap = cap;
+		}
+	c->buf[c->size++] = (unsigned char) b;
+	}
+
+
+
+static void emit_int32(struct jit_code *c, int v)
+	{
+	emit_byte(c, v & 0xff);
+	emit_byte(c, (v>>8) & 0xff);
+	emit_byte(c, (v>>16) & 0xff);
+	emit_byte(c, (v>>24) & 0xff);
+	}
+
+
+
+// ModRM (and SIB) of a [base + index*scale + disp32] memory operand
+static void emit_mem(struct jit_code *c, int reg, int base, int index, int scale, int disp)
+	{
+	int ss = scale==8 ? 3 : scale==4 ? 2 : scale==2 ? 1 : 0;
+	emit_byte(c, 0x80 | (reg&7)<<3 | 4);
+	emit_byte(c, ss<<6 | (index==NO_REG ? 4 : index&7)<<3 | (base&7));
+	emit_int32(c, disp);
+	}
+
+
+
+// 3-byte VEX prefix and opcode; rm_ext and idx_ext are the high bits of the rm/base and index registers
+static void emit_vex(struct jit_code *c, int map, int w, int vvvv, int l, int reg, int idx_ext, int rm_ext, int opcode)
+	{
+	emit_byte(c, 0xc4);
+	emit_byte(c, (!(reg&8))<<7 | (!idx_ext)<<6 | (!rm_ext)<<5 | map);
+	emit_byte(c, w<<7 | ((~vvvv)&15)<<3 | l<<2 | PP_66);
+	emit_byte(c, opcode);
+	}
+
+
+
+// op ymm_reg, ymm_vvvv, ymm_rm
+static void emit_vex_rr(struct jit_code *c, int map, int w, int opcode, int reg, int vvvv, int rm)
+	{
+	emit_vex(c, map, w, vvvv, 1, reg, 0, rm&8, opcode);
+	emit_byte(c, 0xc0 | (reg&7)<<3 | (rm&7));
+	}
+
+
+
+// op ymm_reg, ymm_vvvv, [base + index*scale + disp]
+static void emit_vex_rm(struct jit_code *c, int map, int w, int opcode, int reg, int vvvv, int base, int index, int scale, int disp)
+	{
+	emit_vex(c, map, w, vvvv, 1, reg, index==NO_REG ? 0 : index&8, base&8, opcode);
+	emit_mem(c, reg, base, index, scale, disp);
+	}
+
+
+
+static void emit_vxorpd(struct jit_code *c, int dst)
+	{
+	emit_vex_rr(c, MAP_0F, 0, 0x57, dst, dst, dst);
+	}
+
+static void emit_vmovupd_load(struct jit_code *c, int dst, int base, int index, int scale, int disp)
+	{
+	emit_vex_rm(c, MAP_0F, 0, 0x10, dst, 0, base, index, scale, disp);
+	}
+
+static void emit_vmovupd_store(struct jit_code *c, int src, int base, int index, int scale, int disp)
+	{
+	emit_vex_rm(c, MAP_0F, 0, 0x11, src, 0, base, index, scale, disp);
+	}
+
+static void emit_vmaskmovpd_store(struct jit_code *c, int src, int mask, int base, int index, int scale, int disp)
+	{
+	emit_vex_rm(c, MAP_0F38, 0, 0x2f, src, mask, base, index, scale, disp);
+	}
+
+static void emit_vbroadcastsd(struct jit_code *c, int dst, int base, int disp)
+	{
+	emit_vex_rm(c, MAP_0F38, 0, 0x19, dst, 0, base, NO_REG, 1, disp);
+	}
+
+// dst += src1 * src2
+static void emit_vfmadd231pd(struct jit_code *c, int dst, int src1, int src2)
+	{
+	emit_vex_rr(c, MAP_0F38, 1, 0xb8, dst, src1, src2);
+	}
+
+// dst += src1 * [base + index*scale + disp]
+static void emit_vfmadd231pd_mem(struct jit_code *c, int dst, int src1, int base, int index, int scale, int disp)
+	{
+	emit_vex_rm(c, MAP_0F38, 1, 0xb8, dst, src1, base, index, scale, disp);
+	}
+
+static void emit_vmulpd(struct jit_code *c, int dst, int src1, int src2)
+	{
+	emit_vex_rr(c, MAP_0F, 0, 0x59, dst, src1, src2);
+	}
+
+static void emit_vaddpd_mem(struct jit_code *c, int dst, int src1, int base, int index, int scale, int disp)
+	{
+	emit_vex_rm(c, MAP_0F, 0, 0x58, dst, src1, base, index, scale, disp);
+	}
+
+static void emit_vzeroupper(struct jit_code *c)
+	{
+	emit_byte(c, 0xc5);
+	emit_byte(c, 0xf8);
+	emit_byte(c, 0x77);
+	}
+
+
+
+static void emit_push(struct jit_code *c, int r)
+	{
+	if(r&8)
+		emit_byte(c, 0x41);
+	emit_byte(c, 0x50 | (r&7));
+	}
+
+static void emit_pop(struct jit_code *c, int r)
+	{
+	if(r&8)
+		emit_byte(c, 0x41);
+	emit_byte(c, 0x58 | (r&7));
+	}
+
+// REX.W prefix and opcode of an instruction with a register ModRM
+static void emit_rex_rr(struct jit_code *c, int opcode, int reg, int rm)
+	{
+	emit_byte(c, 0x48 | ((reg&8)>>1) | ((rm&8)>>3));
+	emit_byte(c, opcode);
+	emit_byte(c, 0xc0 | (reg&7)<<3 | (rm&7));
+	}
+
+// mov dst, [base + disp]
+static void emit_mov_load(struct jit_code *c, int dst, int base, int disp)
+	{
+	emit_byte(c, 0x48 | ((dst&8)>>1) | ((base&8)>>3));
+	emit_byte(c, 0x8b);
+	emit_mem(c, dst, base, NO_REG, 1, disp);
+	}
+
+// mov dst, src
+static void emit_mov(struct jit_code *c, int dst, int src)
+	{
+	emit_rex_rr(c, 0x89, src, dst);
+	}
+
+// mov dst, imm64
+static void emit_mov_imm64(struct jit_code *c, int dst, long long imm)
+	{
+	int ii;
+	emit_byte(c, 0x48 | ((dst&8)>>3));
+	emit_byte(c, 0xb8 | (dst&7));
+	for(ii=0; ii<8; ii++)
+		emit_byte(c, (imm>>(8*ii)) & 0xff);
+	}
+
+// add dst, src
+static void emit_add(struct jit_code *c, int dst, int src)
+	{
+	emit_rex_rr(c, 0x01, src, dst);
+	}
+
+// add dst, imm32
+static void emit_add_imm(struct jit_code *c, int dst, int imm)
+	{
+	emit_byte(c, 0x48 | ((dst&8)>>3));
+	emit_byte(c, 0x81);
+	emit_byte(c, 0xc0 | (dst&7));
+	emit_int32(c, imm);
+	}
+
+// sub dst, imm32
+static void emit_sub_imm(struct jit_code *c, int dst, int imm)
+	{
+	emit_byte(c, 0x48 | ((dst&8)>>3));
+	emit_byte(c, 0x81);
+	emit_byte(c, 0xe8 | (dst&7));
+	emit_int32(c, imm);
+	}
+
+// jnz to the absolute code offset target
+static void emit_jnz(struct jit_code *c, int target)
+	{
+	emit_byte(c, 0x0f);
+	emit_byte(c, 0x85);
+	emit_int32(c, target - (c->size+4));
+	}
+
+
+
+// one k iteration of a tile of np panels times nc columns, at offset l of the current 4 iterations
+static void emit_tile_k(struct jit_code *c, int tb, int np, int nc, int l)
+	{
+	int pp, jj;
+	for(pp=0; pp<np; pp++)
+		emit_vmovupd_load(c, 12+pp, A_WALK, pp==0 ? NO_REG : SDA, pp, l*32);
+	for(jj=0; jj<nc; jj++)
+		{
+		// B(l,jj) of a panel of B^T (tb=='t') or B (tb=='n')
+		emit_vbroadcastsd(c, 15, B_WALK, tb=='t' ? l*32+jj*8 : jj*32+l*8);
+		for(pp=0; pp<np; pp++)
+			emit_vfmadd231pd(c, 4*pp+jj, 12+pp, 15);
+		}
+	}
+
+
+
+// 4 k iterations of a tile, and advance of A and B to the following 4
+static void emit_tile_k4(struct jit_code *c, int tb, int np, int nc)
+	{
+	int ll;
+	for(ll=0; ll<4; ll++)
+		emit_tile_k(c, tb, np, nc, ll);
+	emit_add_imm(c, A_WALK, 4*32);
+	if(tb=='t')
+		emit_add_imm(c, B_WALK, 4*32);
+	else
+		emit_add(c, B_WALK, SDB);
+	}
+
+
+
+static void emit_tile(struct jit_code *c, int tb, int mr, int nc, int k, int alpha_one, int beta_zero, int beta_one)
+	{
+	int np = (mr+3)/4;
+	int pp, jj, ll, label;
+
+	for(pp=0; pp<np; pp++)
+		for(jj=0; jj<nc; jj++)
+			emit_vxorpd(c, 4*pp+jj);
+
+	emit_mov(c, A_WALK, A_GRP);
+	emit_mov(c, B_WALK, B_GRP);
+
+	if(k<=JIT_UNROLL_K)
+		{
+		for(ll=0; ll<k/4; ll++)
+			emit_tile_k4(c, tb, np, nc);
+		}
+	else
+		{
+		emit_mov_imm64(c, CNT, k/4);
+		label = c->size;
+		emit_tile_k4(c, tb, np, nc);
+		emit_sub_imm(c, CNT, 1);
+		emit_jnz(c, label);
+		}
+	for(ll=0; ll<k%4; ll++)
+		emit_tile_k(c, tb, np, nc, ll);
+
+	if(!alpha_one)
+		{
+		emit_vbroadcastsd(c, 15, ARGS, offsetof(struct blasfeo_jit_dgemm_args, alpha));
+		for(pp=0; pp<np; pp++)
+			for(jj=0; jj<nc; jj++)
+				emit_vmulpd(c, 4*pp+jj, 4*pp+jj, 15);
+		}
+
+	if(!beta_zero)
+		{
+		if(!beta_one)
+			emit_vbroadcastsd(c, 15, ARGS, offsetof(struct blasfeo_jit_dgemm_args, beta));
+		for(pp=0; pp<np; pp++)
+			for(jj=0; jj<nc; jj++)
+				{
+				if(beta_one)
+					emit_vaddpd_mem(c, 4*pp+jj, 4*pp+jj, C_TILE, pp==0 ? NO_REG : SDC, pp, jj*32);
+				else
+					emit_vfmadd231pd_mem(c, 4*pp+jj, 15, C_TILE, pp==0 ? NO_REG : SDC, pp, jj*32);
+				}
+		}
+
+	for(pp=0; pp<np; pp++)
+		{
+		if(mr-4*pp>=4)
+			{
+			for(jj=0; jj<nc; jj++)
+				emit_vmovupd_store(c, 4*pp+jj, D_TILE, pp==0 ? NO_REG : SDD, pp, jj*32);
+			}
+		else
+			{
+			emit_mov_imm64(c, CNT, (long long) jit_mask[mr-4*pp]);
+			emit_vmovupd_load(c, 14, CNT, NO_REG, 1, 0);
+			for(jj=0; jj<nc; jj++)
+				emit_vmaskmovpd_store(c, 4*pp+jj, 14, D_TILE, pp==0 ? NO_REG : SDD, pp, jj*32);
+			}
+		}
+	}
+
+
+
+static void emit_dgemm(struct jit_code *c, int tb, int m, int n, int k, int alpha_one, int beta_zero, int beta_one)
+	{
+	int ii, jj;
+
+	emit_push(c, RBX);
+	emit_push(c, RBP);
+	emit_push(c, R12);
+	emit_push(c, R13);
+	emit_push(c, R14);
+	emit_push(c, R15);
+
+	emit_mov_load(c, A0, ARGS, offsetof(struct blasfeo_jit_dgemm_args, pA));
+	emit_mov_load(c, B_GRP, ARGS, offsetof(struct blasfeo_jit_dgemm_args, pB));
+	emit_mov_load(c, C_COL, ARGS, offsetof(struct blasfeo_jit_dgemm_args, pC));
+	emit_mov_load(c, D_COL, ARGS, offsetof(struct blasfeo_jit_dgemm_args, pD));
+	emit_mov_load(c, SDA, ARGS, offsetof(struct blasfeo_jit_dgemm_args, sda_bytes));
+	emit_mov_load(c, SDB, ARGS, offsetof(struct blasfeo_jit_dgemm_args, sdb_bytes));
+	emit_mov_load(c, SDC, ARGS, offsetof(struct blasfeo_jit_dgemm_args, sdc_bytes));
+	emit_mov_load(c, SDD, ARGS, offsetof(struct blasfeo_jit_dgemm_args, sdd_bytes));
+
+	for(jj=0; jj<n; jj+=4)
+		{
+		emit_mov(c, A_GRP, A0);
+		emit_mov(c, C_TILE, C_COL);
+		emit_mov(c, D_TILE, D_COL);
+		for(ii=0; ii<m; ii+=12)
+			{
+			emit_tile(c, tb, m-ii<12 ? m-ii : 12, n-jj<4 ? n-jj : 4, k, alpha_one, beta_zero, beta_one);
+			if(ii+12<m)
+				{
+				// next 3 panels
+				emit_add(c, A_GRP, SDA);
+				emit_add(c, A_GRP, SDA);
+				emit_add(c, A_GRP, SDA);
+				emit_add(c, C_TILE, SDC);
+				emit_add(c, C_TILE, SDC);
+				emit_add(c, C_TILE, SDC);
+				emit_add(c, D_TILE, SDD);
+				emit_add(c, D_TILE, SDD);
+				emit_add(c, D_TILE, SDD);
+				}
+			}
+		if(jj+4<n)
+			{
+			// next 4 columns
+			if(tb=='t')
+				emit_add(c, B_GRP, SDB);
+			else
+				emit_add_imm(c, B_GRP, 4*32);
+			emit_add_imm(c, C_COL, 4*32);
+			emit_add_imm(c, D_COL, 4*32);
+			}
+		}
+
+	emit_vzeroupper(c);
+
+	emit_pop(c, R15);
+	emit_pop(c, R14);
+	emit_pop(c, R13);
+	emit_pop(c, R12);
+	emit_pop(c, RBP);
+	emit_pop(c, RBX);
+	emit_byte(c, 0xc3); // ret
+	}
+
+
+
+// executable copy of the generated code, never writable once published
+static void *jit_install(struct jit_code *c)
+	{
+	long page = sysconf(_SC_PAGESIZE);
+	size_t size = (c->size + page - 1) / page * page;
+	void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(mem==MAP_FAILED)
+		return NULL;
+	memcpy(mem, c->buf, c->size);
+	if(mprotect(mem, size, PROT_READ | PROT_EXEC)!=0)
+		{
+		munmap(mem, size);
+		return NULL;
+		}
+	return mem;
+	}
+
+
+
+// cache, a key of 0 marks an empty entry
+struct jit_entry
+	{
+	unsigned long long key;
+	blasfeo_jit_dgemm_kernel kernel;
+	};
+
+static struct jit_entry jit_cache[BLASFEO_JIT_CACHE_SIZE];
+static int jit_cache_n = 0;
+static int jit_lock = 0;
+
+
+
+blasfeo_jit_dgemm_kernel blasfeo_jit_dgemm_get(char tb, int m, int n, int k, double alpha, double beta)
+	{
+	int alpha_one = alpha==1.0;
+	int beta_zero = beta==0.0;
+	int beta_one = beta==1.0;
+	int flags = (tb=='t') | alpha_one<<1 | beta_zero<<2 | beta_one<<3;
+	unsigned long long key = 1 | (unsigned long long) m<<8 | (unsigned long long) n<<16 | (unsigned long long) k<<24 | (unsigned long long) flags<<48;
+	unsigned long long hash = key * 0x9e3779b97f4a7c15ull;
+	int idx = (hash >> 32) % BLASFEO_JIT_CACHE_SIZE;
+	int ii, jj;
+	unsigned long long entry_key;
+	blasfeo_jit_dgemm_kernel kernel;
+	struct jit_code code = {NULL, 0, 0, 0};
+
+	if(m<=0 | n<=0 | k<0 | m>BLASFEO_JIT_MAX_M | n>BLASFEO_JIT_MAX_N | k>BLASFEO_JIT_MAX_K)
+		return NULL;
+
+	// lock-free lookup, the kernel is published before its key
+	for(ii=0; ii<BLASFEO_JIT_CACHE_SIZE; ii++)
+		{
+		jj = (idx+ii) % BLASFEO_JIT_CACHE_SIZE;
+		entry_key = __atomic_load_n(&jit_cache[jj].key, __ATOMIC_ACQUIRE);
+		if(entry_key==key)
+			return jit_cache[jj].kernel;
+		if(entry_key==0)
+			break;
+		}
+
+	while(__atomic_exchange_n(&jit_lock, 1, __ATOMIC_ACQUIRE))
+		;
+
+	// insert, unless another thread did it meanwhile
+	kernel = NULL;
+	for(ii=0; ii<BLASFEO_JIT_CACHE_SIZE; ii++)
+		{
+		jj = (idx+ii) % BLASFEO_JIT_CACHE_SIZE;
+		entry_key = __atomic_load_n(&jit_cache[jj].key, __ATOMIC_ACQUIRE);
+		if(entry_key==key)
+			{
+			kernel = jit_cache[jj].kernel;
+			break;
+			}
+		if(entry_key==0)
+			{
+			// keep some empty entries, so that lookups terminate early
+			if(2*jit_cache_n>=BLASFEO_JIT_CACHE_SIZE)
+				break;
+			emit_dgemm(&code, tb=='t' ? 't' : 'n', m, n, k, alpha_one, beta_zero, beta_one);
+			if(!code.error)
+				kernel = (blasfeo_jit_dgemm_kernel) jit_install(&code);
+			free(code.buf);
+			if(kernel!=NULL)
+				{
+				jit_cache[jj].kernel = kernel;
+				__atomic_store_n(&jit_cache[jj].key, key, __ATOMIC_RELEASE);
+				jit_cache_n++;
+				}
+			break;
+			}
+		}
+
+	__atomic_store_n(&jit_lock, 0, __ATOMIC_RELEASE);
+
+	return kernel;
+	}
+
+
+
+int blasfeo_jit_cache_size()
+	{
+	return __atomic_load_n(&jit_cache_n, __ATOMIC_ACQUIRE);
+	}
+
+
+
+#else // BLASFEO_JIT
+
+
+
+blasfeo_jit_dgemm_kernel blasfeo_jit_dgemm_get(char tb, int m, int n, int k, double alpha, double beta)
+	{
+	return NULL;
+	}
+
+
+
+int blasfeo_jit_cache_size()
+	{
+	return 0;
+	}
+
+
+
+#endif // BLASFEO_JIT
@@ -0,0 +1,223 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+#if defined(EXT_DEP)
+#include <stdio.h>
+#endif
+
+#include <blasfeo_profile.h>
+
+
+
+// call stack depth, instrumented routines may call each other
+#define PROFILE_MAX_DEPTH 8
+
+static struct blasfeo_profile_entry profile[BLASFEO_PROFILE_N_ROUTINES] =
+	{
+	{"dgemm_nn"},
+	{"dgemm_nt"},
+	{"dgemm_tn"},
+	{"dgemm_tt"},
+	{"dsyrk_ln"},
+	{"dtrsm_rltn"},
+	{"dpotrf_l"},
+	{"dgetrf_rp"},
+	{"dgemv_n"},
+	{"dgemv_t"},
+	};
+
+static struct blasfeo_profile_event stack[PROFILE_MAX_DEPTH];
+static int depth = 0;
+
+static void (*profile_callback)(struct blasfeo_profile_event *event, void *data) = 0;
+static void *profile_callback_data = 0;
+
+
+
+static long long profile_cycles()
+	{
+#if (defined(__GNUC__) | defined(__clang__)) & defined(__x86_64__)
+	unsigned int lo, hi;
+	__asm__ volatile("rdtsc" : "=a" (lo), "=d" (hi));
+	return ((long long) hi << 32) | lo;
+#elif (defined(__GNUC__) | defined(__clang__)) & defined(__aarch64__)
+	long long cnt;
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r" (cnt));
+	return cnt;
+#else
+	return 0;
+#endif
+	}
+
+
+
+struct blasfeo_profile_entry *blasfeo_profile_get(int routine)
+	{
+	if(routine<0 | routine>=BLASFEO_PROFILE_N_ROUTINES)
+		return 0;
+	return profile+routine;
+	}
+
+
+
+void blasfeo_profile_reset()
+	{
+	int ii, jj;
+	for(ii=0; ii<BLASFEO_PROFILE_N_ROUTINES; ii++)
+		{
+		profile[ii].calls = 0;
+		profile[ii].cycles = 0;
+		profile[ii].bytes_packed = 0;
+		for(jj=0; jj<BLASFEO_PROFILE_N_ALGS; jj++)
+			profile[ii].alg[jj] = 0;
+		for(jj=0; jj<BLASFEO_PROFILE_N_BINS; jj++)
+			profile[ii].size_hist[jj] = 0;
+		}
+	depth = 0;
+	return;
+	}
+
+
+
+void blasfeo_profile_set_callback(void (*callback)(struct blasfeo_profile_event *event, void *data), void *data)
+	{
+	profile_callback = callback;
+	profile_callback_data = data;
+	return;
+	}
+
+
+
+void blasfeo_profile_start(int routine, int m, int n, int k)
+	{
+	if(depth<PROFILE_MAX_DEPTH)
+		{
+		stack[depth].routine = routine;
+		stack[depth].m = m;
+		stack[depth].n = n;
+		stack[depth].k = k;
+		stack[depth].alg = BLASFEO_PROFILE_ALG_NONE;
+		stack[depth].bytes_packed = 0;
+		stack[depth].cycles = profile_cycles();
+		}
+	depth++;
+	return;
+	}
+
+
+
+void blasfeo_profile_alg(int alg)
+	{
+	if(depth>0 & depth<=PROFILE_MAX_DEPTH)
+		stack[depth-1].alg = alg;
+	return;
+	}
+
+
+
+void blasfeo_profile_packed(long long bytes)
+	{
+	if(depth>0 & depth<=PROFILE_MAX_DEPTH)
+		stack[depth-1].bytes_packed += bytes;
+	return;
+	}
+
+
+
+void blasfeo_profile_end()
+	{
+	if(depth<=0)
+		return;
+	depth--;
+	if(depth>=PROFILE_MAX_DEPTH)
+		return;
+
+	struct blasfeo_profile_event *event = stack+depth;
+	struct blasfeo_profile_entry *entry = profile+event->routine;
+
+	event->cycles = profile_cycles() - event->cycles;
+
+	int size = event->m>event->n ? event->m : event->n;
+	size = event->k>size ? event->k : size;
+	int bin = 0;
+	while(size>1 & bin<BLASFEO_PROFILE_N_BINS-1)
+		{
+		size >>= 1;
+		bin++;
+		}
+
+	entry->calls++;
+	entry->cycles += event->cycles;
+	entry->bytes_packed += event->bytes_packed;
+	entry->alg[event->alg]++;
+	entry->size_hist[bin]++;
+
+	if(profile_callback)
+		profile_callback(event, profile_callback_data);
+
+	return;
+	}
+
+
+
+#if defined(EXT_DEP)
+
+void blasfeo_profile_print()
+	{
+	int ii, jj;
+	const char *alg_names[BLASFEO_PROFILE_N_ALGS] = {"none", "0", "m1", "n1", "2"};
+	struct blasfeo_profile_entry *entry;
+	for(ii=0; ii<BLASFEO_PROFILE_N_ROUTINES; ii++)
+		{
+		entry = profile+ii;
+		if(entry->calls==0)
+			continue;
+		printf("\n%s: calls %lld, cycles %lld (%.1f per call), bytes packed %lld\n",
+			entry->name, entry->calls, entry->cycles, (double) entry->cycles/entry->calls, entry->bytes_packed);
+		printf("  alg:");
+		for(jj=0; jj<BLASFEO_PROFILE_N_ALGS; jj++)
+			if(entry->alg[jj])
+				printf(" %s %lld", alg_names[jj], entry->alg[jj]);
+		printf("\n  size:");
+		for(jj=0; jj<BLASFEO_PROFILE_N_BINS; jj++)
+			if(entry->size_hist[jj])
+				printf(" [%d,%d) %lld", 1<<jj, 2<<jj, entry->size_hist[jj]);
+		printf("\n");
+		}
+	return;
+	}
+
+#endif
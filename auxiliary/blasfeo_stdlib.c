@@ -36,14 +36,41 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#if defined(BLASFEO_HUGE_PAGES) & defined(OS_LINUX)
+#include <sys/mman.h>
+#endif
 
 #include <blasfeo_stdlib.h>
 #include <blasfeo_block_size.h>
 
 
 
+#if defined(BLASFEO_HUGE_PAGES) & defined(OS_LINUX)
+// allocations of at least one huge page are aligned to the huge page size and advised to be backed by
+// transparent huge pages; the kernel silently falls back to 4 kB pages if none is available
+static void *malloc_huge_page(size_t size)
+	{
+	void *ptr;
+	size_t size_huge = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	if(posix_memalign(&ptr, HUGE_PAGE_SIZE, size_huge)!=0)
+		return NULL;
+	madvise(ptr, size_huge, MADV_HUGEPAGE);
+	return ptr;
+	}
+#endif
+
+
+
 void blasfeo_malloc(void **ptr, size_t size)
 	{
+#if defined(BLASFEO_HUGE_PAGES) & defined(OS_LINUX)
+	if(size>=HUGE_PAGE_SIZE)
+		{
+		*ptr = malloc_huge_page(size);
+		if(*ptr!=NULL)
+			return;
+		}
+#endif
 	*ptr = malloc(size);
 	return;
 	}
@@ -69,6 +96,15 @@ void blasfeo_malloc_align(void **ptr, size_t size)
 
 #else
 
+#if defined(BLASFEO_HUGE_PAGES) & defined(OS_LINUX)
+	if(size>=HUGE_PAGE_SIZE)
+		{
+		*ptr = malloc_huge_page(size);
+		if(*ptr!=NULL)
+			return;
+		}
+#endif
+
 	int err = posix_memalign( ptr, CACHE_LINE_SIZE, size );
 	if(err!=0)
 		{
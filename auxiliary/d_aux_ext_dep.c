@@ -35,6 +35,11 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#if !defined(OS_WINDOWS)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <blasfeo_block_size.h>
 #include <blasfeo_common.h>
@@ -53,6 +58,8 @@
 #define MATEL BLASFEO_DMATEL
 #define VEC blasfeo_dvec
 #define VECEL BLASFEO_DVECEL
+#define PS D_PS
+#define PLD D_PLD
 
 
 
@@ -75,6 +82,12 @@
 #define PRINT_EXP_TRAN_MAT blasfeo_print_exp_tran_dmat
 #define PRINT_EXP_VEC blasfeo_print_exp_dvec
 #define PRINT_EXP_TRAN_VEC blasfeo_print_exp_tran_dvec
+#define SAVE_MAT blasfeo_save_dmat
+#define LOAD_MAT blasfeo_load_dmat
+#define UNLOAD_MAT blasfeo_unload_dmat
+#define SAVE_VEC blasfeo_save_dvec
+#define LOAD_VEC blasfeo_load_dvec
+#define UNLOAD_VEC blasfeo_unload_dvec
 
 
 
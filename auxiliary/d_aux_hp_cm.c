@@ -120,6 +120,10 @@
 #define REF_VECZE blasfeo_hp_dvecze
 #define REF_VECNRM_INF blasfeo_hp_dvecnrm_inf
 #define REF_VECNRM_2 blasfeo_hp_dvecnrm_2
+#define REF_GENRM_1 blasfeo_hp_dgenrm_1
+#define REF_GENRM_INF blasfeo_hp_dgenrm_inf
+#define REF_GENRM_FRO blasfeo_hp_dgenrm_fro
+#define REF_GENRM_MAX blasfeo_hp_dgenrm_max
 #define REF_DIAIN blasfeo_hp_ddiain
 #define REF_DIAIN_SP blasfeo_hp_ddiain_sp
 #define REF_DIAEX blasfeo_hp_ddiaex
@@ -185,6 +189,10 @@
 #define VECZE blasfeo_dvecze
 #define VECNRM_INF blasfeo_dvecnrm_inf
 #define VECNRM_2 blasfeo_dvecnrm_2
+#define GENRM_1 blasfeo_dgenrm_1
+#define GENRM_INF blasfeo_dgenrm_inf
+#define GENRM_FRO blasfeo_dgenrm_fro
+#define GENRM_MAX blasfeo_dgenrm_max
 #define DIAIN blasfeo_ddiain
 #define DIAIN_SP blasfeo_ddiain_sp
 #define DIAEX blasfeo_ddiaex
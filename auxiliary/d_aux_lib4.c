@@ -375,7 +375,7 @@ void dgead_lib(int m, int n, double alpha, int offsetA, double *A, int sda, int
 // --------- Transpose
 
 // transpose general matrix; m and n are referred to the original matrix
-void dgetr_lib(int m, int n, double alpha, int offsetA, double *pA, int sda, int offsetC, double *pC, int sdc)
+static void dgetr_lib_blk(int m, int n, double alpha, int offsetA, double *pA, int sda, int offsetC, double *pC, int sdc)
 	{
 
 /*
@@ -461,6 +461,135 @@ C =
 
 
 
+// leaf size of the recursive transposition: the A and C blocks of a leaf fit in L2 together
+#define DGETR_BLK 64
+
+
+
+// swap the m x n block X with the transpose of the n x m block Y (X and Y do not overlap)
+static void dgetr_lib_swap(int m, int n, int offsetX, double *pX, int offsetY, double *pY, int sd)
+	{
+
+	const int bs = 4;
+
+	int ii, jj, mm, nn;
+	double tmp;
+	double *px, *py;
+
+	if(m>DGETR_BLK | n>DGETR_BLK)
+		{
+		if(m>=n)
+			{
+			// split the rows of X (the columns of Y) at a panel boundary of X
+			mm = (m/2+offsetX+bs-1)/bs*bs - offsetX;
+			dgetr_lib_swap(mm, n, offsetX, pX, offsetY, pY, sd);
+			dgetr_lib_swap(m-mm, n, 0, pX-offsetX+(offsetX+mm)*sd, offsetY, pY+mm*bs, sd);
+			}
+		else
+			{
+			// split the columns of X (the rows of Y) at a panel boundary of Y
+			nn = (n/2+offsetY+bs-1)/bs*bs - offsetY;
+			dgetr_lib_swap(m, nn, offsetX, pX, offsetY, pY, sd);
+			dgetr_lib_swap(m, n-nn, offsetX, pX+nn*bs, 0, pY-offsetY+(offsetY+nn)*sd, sd);
+			}
+		return;
+		}
+
+	for(ii=0; ii<m; ii++)
+		{
+		px = pX - offsetX + (offsetX+ii)/bs*bs*sd + (offsetX+ii)%bs;
+		py = pY + ii*bs;
+		for(jj=0; jj<n; jj++)
+			{
+			tmp = px[jj*bs];
+			px[jj*bs] = py[-offsetY+(offsetY+jj)/bs*bs*sd+(offsetY+jj)%bs];
+			py[-offsetY+(offsetY+jj)/bs*bs*sd+(offsetY+jj)%bs] = tmp;
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// transpose the m x m block A in place
+static void dgetr_lib_ip(int m, int offsetA, double *pA, int sda)
+	{
+
+	const int bs = 4;
+
+	int ii, jj, mm;
+	double tmp;
+	double *pA2;
+
+	if(m>DGETR_BLK)
+		{
+		// A = [A00 A01; A10 A11], with the split at a panel boundary
+		mm = (m/2+offsetA+bs-1)/bs*bs - offsetA;
+		pA2 = pA - offsetA + (offsetA+mm)*sda;
+		dgetr_lib_ip(mm, offsetA, pA, sda);
+		dgetr_lib_ip(m-mm, 0, pA2+mm*bs, sda);
+		dgetr_lib_swap(m-mm, mm, 0, pA2, offsetA, pA+mm*bs, sda);
+		return;
+		}
+
+	for(ii=1; ii<m; ii++)
+		{
+		for(jj=0; jj<ii; jj++)
+			{
+			tmp = pA[-offsetA+(offsetA+ii)/bs*bs*sda+(offsetA+ii)%bs+jj*bs];
+			pA[-offsetA+(offsetA+ii)/bs*bs*sda+(offsetA+ii)%bs+jj*bs] = pA[-offsetA+(offsetA+jj)/bs*bs*sda+(offsetA+jj)%bs+ii*bs];
+			pA[-offsetA+(offsetA+jj)/bs*bs*sda+(offsetA+jj)%bs+ii*bs] = tmp;
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// transpose general matrix; m and n are referred to the original matrix
+// large matrices are recursively split at panel boundaries along the largest dimension (cache oblivious), so that
+// each leaf reads and writes a block that fits in cache, instead of streaming a 4-row panel of A against n/4 panels of C
+void dgetr_lib(int m, int n, double alpha, int offsetA, double *pA, int sda, int offsetC, double *pC, int sdc)
+	{
+
+	if(m<=0 || n<=0)
+		return;
+
+	const int bs = 4;
+
+	int ii, mm, nn;
+
+	if(m>DGETR_BLK | n>DGETR_BLK)
+		{
+		if(m>=n)
+			{
+			// split the rows of A (the columns of C) at a panel boundary of A
+			mm = (m/2+offsetA+bs-1)/bs*bs - offsetA;
+			dgetr_lib(mm, n, alpha, offsetA, pA, sda, offsetC, pC, sdc);
+			dgetr_lib(m-mm, n, alpha, 0, pA-offsetA+(offsetA+mm)*sda, sda, offsetC, pC+mm*bs, sdc);
+			}
+		else
+			{
+			// split the columns of A (the rows of C) at a panel boundary of C
+			nn = (n/2+offsetC+bs-1)/bs*bs - offsetC;
+			dgetr_lib(m, nn, alpha, offsetA, pA, sda, offsetC, pC, sdc);
+			dgetr_lib(m, n-nn, alpha, offsetA, pA+nn*bs, sda, 0, pC-offsetC+(offsetC+nn)*sdc, sdc);
+			}
+		return;
+		}
+
+	dgetr_lib_blk(m, n, alpha, offsetA, pA, sda, offsetC, pC, sdc);
+
+	return;
+
+	}
+
+
+
 // transpose lower triangular matrix
 void dtrtr_l_lib(int m, double alpha, int offsetA, double *pA, int sda, int offsetC, double *pC, int sdc)
 	{
@@ -1632,6 +1761,8 @@ void blasfeo_pack_dmat(int m, int n, double *A, int lda, struct blasfeo_dmat *sA
 #if defined(TARGET_X64_INTEL_HASWELL) || defined(TARGET_X64_INTEL_SANDY_BRIDGE)
 	__m256d
 		tmp;
+	// destination larger than the last level cache: non-temporal stores skip the read-for-ownership of sA
+	int stream = (double) m*n*sizeof(double) > LLC_CACHE_SIZE;
 #endif
 	m0 = (bs-ai%bs)%bs;
 	if(m0>m)
@@ -1656,18 +1787,37 @@ void blasfeo_pack_dmat(int m, int n, double *A, int lda, struct blasfeo_dmat *sA
 			pB += m0 + bs*(sda-1);
 			}
 #if defined(TARGET_X64_INTEL_HASWELL) || defined(TARGET_X64_INTEL_SANDY_BRIDGE)
-		for( ; ii<m-3; ii+=4)
+		if(stream)
 			{
-			tmp = _mm256_loadu_pd( &B[0+lda*0] );
-			_mm256_store_pd( &pB[0+bs*0], tmp );
-			tmp = _mm256_loadu_pd( &B[0+lda*1] );
-			_mm256_store_pd( &pB[0+bs*1], tmp );
-			tmp = _mm256_loadu_pd( &B[0+lda*2] );
-			_mm256_store_pd( &pB[0+bs*2], tmp );
-			tmp = _mm256_loadu_pd( &B[0+lda*3] );
-			_mm256_store_pd( &pB[0+bs*3], tmp );
-			B  += 4;
-			pB += bs*sda;
+			for( ; ii<m-3; ii+=4)
+				{
+				tmp = _mm256_loadu_pd( &B[0+lda*0] );
+				_mm256_stream_pd( &pB[0+bs*0], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*1] );
+				_mm256_stream_pd( &pB[0+bs*1], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*2] );
+				_mm256_stream_pd( &pB[0+bs*2], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*3] );
+				_mm256_stream_pd( &pB[0+bs*3], tmp );
+				B  += 4;
+				pB += bs*sda;
+				}
+			}
+		else
+			{
+			for( ; ii<m-3; ii+=4)
+				{
+				tmp = _mm256_loadu_pd( &B[0+lda*0] );
+				_mm256_store_pd( &pB[0+bs*0], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*1] );
+				_mm256_store_pd( &pB[0+bs*1], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*2] );
+				_mm256_store_pd( &pB[0+bs*2], tmp );
+				tmp = _mm256_loadu_pd( &B[0+lda*3] );
+				_mm256_store_pd( &pB[0+bs*3], tmp );
+				B  += 4;
+				pB += bs*sda;
+				}
 			}
 #else
 		for( ; ii<m-3; ii+=4)
@@ -1748,6 +1898,10 @@ void blasfeo_pack_dmat(int m, int n, double *A, int lda, struct blasfeo_dmat *sA
 			pB += 1;
 			}
 		}
+#if defined(TARGET_X64_INTEL_HASWELL) || defined(TARGET_X64_INTEL_SANDY_BRIDGE)
+	if(stream)
+		_mm_sfence();
+#endif
 	return;
 	}
 
@@ -2108,6 +2262,8 @@ void blasfeo_pack_tran_dmat(int m, int n, double *A, int lda, struct blasfeo_dma
 	__m256d
 		v0, v1, v2, v3,
 		v4, v5, v6, v7;
+	// destination larger than the last level cache: non-temporal stores skip the read-for-ownership of sA
+	int stream = (double) m*n*sizeof(double) > LLC_CACHE_SIZE;
 #endif
 	m0 = (bs-ai%bs)%bs;
 	if(m0>n)
@@ -2147,13 +2303,23 @@ void blasfeo_pack_tran_dmat(int m, int n, double *A, int lda, struct blasfeo_dma
 			B += 4;
 
 			v0 = _mm256_permute2f128_pd( v4, v6, 0x20 ); // 00 01 02 03
-			_mm256_store_pd( &pB[0+bs*0], v0 );
 			v2 = _mm256_permute2f128_pd( v4, v6, 0x31 ); // 20 21 22 23
-			_mm256_store_pd( &pB[0+bs*2], v2 );
 			v1 = _mm256_permute2f128_pd( v5, v7, 0x20 ); // 10 11 12 13
-			_mm256_store_pd( &pB[0+bs*1], v1 );
 			v3 = _mm256_permute2f128_pd( v5, v7, 0x31 ); // 30 31 32 33
-			_mm256_store_pd( &pB[0+bs*3], v3 );
+			if(stream)
+				{
+				_mm256_stream_pd( &pB[0+bs*0], v0 );
+				_mm256_stream_pd( &pB[0+bs*1], v1 );
+				_mm256_stream_pd( &pB[0+bs*2], v2 );
+				_mm256_stream_pd( &pB[0+bs*3], v3 );
+				}
+			else
+				{
+				_mm256_store_pd( &pB[0+bs*0], v0 );
+				_mm256_store_pd( &pB[0+bs*2], v2 );
+				_mm256_store_pd( &pB[0+bs*1], v1 );
+				_mm256_store_pd( &pB[0+bs*3], v3 );
+				}
 
 			pB += 4*bs;
 			}
@@ -2207,6 +2373,10 @@ void blasfeo_pack_tran_dmat(int m, int n, double *A, int lda, struct blasfeo_dma
 				}
 			}
 		}
+#if defined(TARGET_X64_INTEL_HASWELL) || defined(TARGET_X64_INTEL_SANDY_BRIDGE)
+	if(stream)
+		_mm_sfence();
+#endif
 	return;
 	}
 
@@ -2354,6 +2524,11 @@ void blasfeo_unpack_dmat(int m, int n, struct blasfeo_dmat *sA, int ai, int aj,
 
 
 
+// rows of sA per block in blasfeo_unpack_tran_dmat
+#define DUNPACK_TRAN_BLK 16
+
+
+
 // convert and transpose a matrix structure into a matrix
 void blasfeo_unpack_tran_dmat(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *A, int lda)
 	{
@@ -2361,6 +2536,20 @@ void blasfeo_unpack_tran_dmat(int m, int n, struct blasfeo_dmat *sA, int ai, int
 	int sda = sA->cn;
 	double *pA = sA->pA + aj*bs + ai/bs*bs*sda + ai%bs;
 	int i, ii, jj;
+
+	// block the rows of sA at panel boundaries, so that each block writes a few columns of A as sequential streams
+	// instead of 4 elements into each of the m columns per panel column
+	if(m>DUNPACK_TRAN_BLK)
+		{
+		for(ii=0; ii<m; ii+=i)
+			{
+			i = DUNPACK_TRAN_BLK - (ai+ii)%bs;
+			i = m-ii<i ? m-ii : i;
+			blasfeo_unpack_tran_dmat(i, n, sA, ai+ii, aj, A+ii*lda, lda);
+			}
+		return;
+		}
+
 	int m0 = (bs-ai%bs)%bs;
 	if(m0>m)
 		m0 = m;
@@ -4400,6 +4589,12 @@ void blasfeo_dgetr(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, struct
 	double *pA = sA->pA + ai/bs*bs*sda + ai%bs + aj*bs;
 	int sdc = sC->cn;
 	double *pC = sC->pA + ci/bs*bs*sdc + ci%bs + cj*bs;
+	// in place
+	if(pA==pC & m==n)
+		{
+		dgetr_lib_ip(m, ai%bs, pA, sda);
+		return;
+		}
 	dgetr_lib(m, n, 1.0, ai%bs, pA, sda, ci%bs, pC, sdc); // TODO remove alpha !!!
 	return;
 	}
@@ -4933,6 +5128,184 @@ void blasfeo_dvecnrm_2(int m, struct blasfeo_dvec *sx, int xi, double *ptr_norm)
 
 
 
+// compute 1 norm of matrix (max abs column sum)
+void blasfeo_dgenrm_1(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double *pA0;
+	double acc[4];
+	double norm = 0.0;
+	double tmp;
+	if(m<=0)
+		n = 0;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		pA0 = pA + jj*bs;
+		// unaligned first panel
+		i0 = air;
+		i1 = air+m<bs ? air+m : bs;
+		for(ll=i0; ll<i1; ll++)
+			acc[ll] += fabs(pA0[ll]);
+		ii = i1-i0;
+		pA0 += bs*sda;
+		// full panels
+		for(; ii<m-(bs-1); ii+=bs)
+			{
+			for(ll=0; ll<bs; ll++)
+				acc[ll] += fabs(pA0[ll]);
+			pA0 += bs*sda;
+			}
+		// last panel
+		for(ll=0; ll<m-ii; ll++)
+			acc[ll] += fabs(pA0[ll]);
+		tmp = 0.0;
+		for(ll=0; ll<bs; ll++)
+			tmp += acc[ll];
+		norm = norm>=tmp ? norm : tmp;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute inf norm of matrix (max abs row sum)
+void blasfeo_dgenrm_inf(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[4];
+	double norm = 0.0;
+	if(n<=0)
+		m = 0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += fabs(pA[jj*bs+ll]);
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += fabs(pA[jj*bs+ll]);
+			}
+		for(ll=0; ll<bs; ll++)
+			norm = norm>=acc[ll] ? norm : acc[ll];
+		pA += bs*sda;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute Frobenius norm of matrix
+void blasfeo_dgenrm_fro(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[4];
+	double norm = 0.0;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm += acc[ll];
+	norm = sqrt(norm);
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute max abs element of matrix
+void blasfeo_dgenrm_max(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[4];
+	double norm = 0.0;
+	double tmp;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					{
+					tmp = fabs(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					{
+					tmp = fabs(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm = norm>=acc[ll] ? norm : acc[ll];
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
 // permute elements of a vector struct
 void blasfeo_dvecpe(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi)
 	{
@@ -478,6 +478,42 @@ void blasfeo_drowsw(int kmax, struct blasfeo_dmat *sA, int ai, int aj, struct bl
 
 
 
+// permute the rows of a matrix struct
+void blasfeo_drowpe(int kmax, int *ipiv, struct blasfeo_dmat *sA)
+	{
+
+	// invalidate stored inverse diagonal
+	sA->use_dA = 0;
+
+	int ii;
+	for(ii=0; ii<kmax; ii++)
+		{
+		if(ipiv[ii]!=ii)
+			blasfeo_drowsw(sA->n, sA, ii, 0, sA, ipiv[ii], 0);
+		}
+	return;
+	}
+
+
+
+// inverse permute the rows of a matrix struct
+void blasfeo_drowpei(int kmax, int *ipiv, struct blasfeo_dmat *sA)
+	{
+
+	// invalidate stored inverse diagonal
+	sA->use_dA = 0;
+
+	int ii;
+	for(ii=kmax-1; ii>=0; ii--)
+		{
+		if(ipiv[ii]!=ii)
+			blasfeo_drowsw(sA->n, sA, ii, 0, sA, ipiv[ii], 0);
+		}
+	return;
+	}
+
+
+
 // extract a row int a vector
 void blasfeo_drowex(int kmax, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi)
 	{
@@ -966,24 +1002,16 @@ void blasfeo_dvecad(int m, double alpha, struct blasfeo_dvec *sa, int ai, struct
 	}
 
 
-// copy and transpose a generic strmat into a generic strmat
-void blasfeo_dgetr(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj)
-	{
-
-	// invalidate stored inverse diagonal
-	sB->use_dA = 0;
+// leaf size of the recursive transposition: the A and B blocks of a leaf fit in L2 together
+#define DGETR_BLK 64
 
-	const int ps = 8;
 
-	int sda = sA->cn;
-	int sdb = sB->cn;
 
-	int air = ai & (ps-1);
-	int bir = bi & (ps-1);
+// transpose the m x n block of A into B; pA, pB point to panels edges
+static void blasfeo_dgetr_blk(int m, int n, int air, double *pA, int sda, int bir, double *pB, int sdb)
+	{
 
-	// pA, pB point to panels edges
-	double *pA = sA->pA + aj*ps + (ai-air)*sda;
-	double *pB = sB->pA + bj*ps + (bi-bir)*sdb;
+	const int ps = 8;
 
 	int ii, nmax;
 
@@ -1013,6 +1041,160 @@ void blasfeo_dgetr(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, struct
 
 
 
+// recursively split large blocks at panel boundaries along the largest dimension (cache oblivious)
+static void blasfeo_dgetr_rec(int m, int n, int air, double *pA, int sda, int bir, double *pB, int sdb)
+	{
+
+	const int ps = 8;
+
+	int mm, nn;
+
+	if(m>DGETR_BLK | n>DGETR_BLK)
+		{
+		if(m>=n)
+			{
+			// split the rows of A (the columns of B) at a panel boundary of A
+			mm = (m/2+air+ps-1)/ps*ps - air;
+			blasfeo_dgetr_rec(mm, n, air, pA, sda, bir, pB, sdb);
+			blasfeo_dgetr_rec(m-mm, n, 0, pA+(air+mm)*sda, sda, bir, pB+mm*ps, sdb);
+			}
+		else
+			{
+			// split the columns of A (the rows of B) at a panel boundary of B
+			nn = (n/2+bir+ps-1)/ps*ps - bir;
+			blasfeo_dgetr_rec(m, nn, air, pA, sda, bir, pB, sdb);
+			blasfeo_dgetr_rec(m, n-nn, air, pA+nn*ps, sda, 0, pB+(bir+nn)*sdb, sdb);
+			}
+		return;
+		}
+
+	blasfeo_dgetr_blk(m, n, air, pA, sda, bir, pB, sdb);
+
+	return;
+
+	}
+
+
+
+// swap the m x n block X with the transpose of the n x m block Y (X and Y do not overlap); pX, pY point to panels edges
+static void blasfeo_dgetr_swap(int m, int n, int xir, double *pX, int yir, double *pY, int sd)
+	{
+
+	const int ps = 8;
+
+	int ii, jj, mm, nn;
+	double tmp;
+	double *px, *py;
+
+	if(m>DGETR_BLK | n>DGETR_BLK)
+		{
+		if(m>=n)
+			{
+			mm = (m/2+xir+ps-1)/ps*ps - xir;
+			blasfeo_dgetr_swap(mm, n, xir, pX, yir, pY, sd);
+			blasfeo_dgetr_swap(m-mm, n, 0, pX+(xir+mm)*sd, yir, pY+mm*ps, sd);
+			}
+		else
+			{
+			nn = (n/2+yir+ps-1)/ps*ps - yir;
+			blasfeo_dgetr_swap(m, nn, xir, pX, yir, pY, sd);
+			blasfeo_dgetr_swap(m, n-nn, xir, pX+nn*ps, 0, pY+(yir+nn)*sd, sd);
+			}
+		return;
+		}
+
+	for(ii=0; ii<m; ii++)
+		{
+		px = pX + (xir+ii)/ps*ps*sd + (xir+ii)%ps;
+		py = pY + ii*ps;
+		for(jj=0; jj<n; jj++)
+			{
+			tmp = px[jj*ps];
+			px[jj*ps] = py[(yir+jj)/ps*ps*sd+(yir+jj)%ps];
+			py[(yir+jj)/ps*ps*sd+(yir+jj)%ps] = tmp;
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// transpose the m x m block of A in place; pA points to panels edges
+static void blasfeo_dgetr_ip(int m, int air, double *pA, int sda)
+	{
+
+	const int ps = 8;
+
+	int ii, jj, mm;
+	double tmp;
+	double *pA2;
+
+	if(m>DGETR_BLK)
+		{
+		// A = [A00 A01; A10 A11], with the split at a panel boundary
+		mm = (m/2+air+ps-1)/ps*ps - air;
+		pA2 = pA + (air+mm)*sda;
+		blasfeo_dgetr_ip(mm, air, pA, sda);
+		blasfeo_dgetr_ip(m-mm, 0, pA2+mm*ps, sda);
+		blasfeo_dgetr_swap(m-mm, mm, 0, pA2, air, pA+mm*ps, sda);
+		return;
+		}
+
+	for(ii=1; ii<m; ii++)
+		{
+		for(jj=0; jj<ii; jj++)
+			{
+			tmp = pA[(air+ii)/ps*ps*sda+(air+ii)%ps+jj*ps];
+			pA[(air+ii)/ps*ps*sda+(air+ii)%ps+jj*ps] = pA[(air+jj)/ps*ps*sda+(air+jj)%ps+ii*ps];
+			pA[(air+jj)/ps*ps*sda+(air+jj)%ps+ii*ps] = tmp;
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// copy and transpose a generic strmat into a generic strmat
+void blasfeo_dgetr(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj)
+	{
+
+	// invalidate stored inverse diagonal
+	sB->use_dA = 0;
+
+	if(m<=0 | n<=0)
+		return;
+
+	const int ps = 8;
+
+	int sda = sA->cn;
+	int sdb = sB->cn;
+
+	int air = ai & (ps-1);
+	int bir = bi & (ps-1);
+
+	// pA, pB point to panels edges
+	double *pA = sA->pA + aj*ps + (ai-air)*sda;
+	double *pB = sB->pA + bj*ps + (bi-bir)*sdb;
+
+	// in place
+	if(pA==pB & air==bir & m==n)
+		{
+		blasfeo_dgetr_ip(m, air, pA, sda);
+		return;
+		}
+
+	blasfeo_dgetr_rec(m, n, air, pA, sda, bir, pB, sdb);
+
+	return;
+
+	}
+
+
+
 // copy and transpose a lower triangular strmat into an upper triangular strmat
 void blasfeo_dtrtr_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj)
 	{
@@ -1397,6 +1579,184 @@ void blasfeo_dvecnrm_2(int m, struct blasfeo_dvec *sx, int xi, double *ptr_norm)
 
 
 
+// compute 1 norm of matrix (max abs column sum)
+void blasfeo_dgenrm_1(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 8;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double *pA0;
+	double acc[8];
+	double norm = 0.0;
+	double tmp;
+	if(m<=0)
+		n = 0;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		pA0 = pA + jj*bs;
+		// unaligned first panel
+		i0 = air;
+		i1 = air+m<bs ? air+m : bs;
+		for(ll=i0; ll<i1; ll++)
+			acc[ll] += fabs(pA0[ll]);
+		ii = i1-i0;
+		pA0 += bs*sda;
+		// full panels
+		for(; ii<m-(bs-1); ii+=bs)
+			{
+			for(ll=0; ll<bs; ll++)
+				acc[ll] += fabs(pA0[ll]);
+			pA0 += bs*sda;
+			}
+		// last panel
+		for(ll=0; ll<m-ii; ll++)
+			acc[ll] += fabs(pA0[ll]);
+		tmp = 0.0;
+		for(ll=0; ll<bs; ll++)
+			tmp += acc[ll];
+		norm = norm>=tmp ? norm : tmp;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute inf norm of matrix (max abs row sum)
+void blasfeo_dgenrm_inf(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 8;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[8];
+	double norm = 0.0;
+	if(n<=0)
+		m = 0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += fabs(pA[jj*bs+ll]);
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += fabs(pA[jj*bs+ll]);
+			}
+		for(ll=0; ll<bs; ll++)
+			norm = norm>=acc[ll] ? norm : acc[ll];
+		pA += bs*sda;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute Frobenius norm of matrix
+void blasfeo_dgenrm_fro(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 8;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[8];
+	double norm = 0.0;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm += acc[ll];
+	norm = sqrt(norm);
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute max abs element of matrix
+void blasfeo_dgenrm_max(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm)
+	{
+	const int bs = 8;
+	int sda = sA->cn;
+	double *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	double acc[8];
+	double norm = 0.0;
+	double tmp;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					{
+					tmp = fabs(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					{
+					tmp = fabs(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm = norm>=acc[ll] ? norm : acc[ll];
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
 // permute elements of a vector struct
 void blasfeo_dvecpe(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi)
 	{
@@ -119,6 +119,10 @@
 #define REF_VECZE blasfeo_ref_dvecze
 #define REF_VECNRM_INF blasfeo_ref_dvecnrm_inf
 #define REF_VECNRM_2 blasfeo_ref_dvecnrm_2
+#define REF_GENRM_1 blasfeo_ref_dgenrm_1
+#define REF_GENRM_INF blasfeo_ref_dgenrm_inf
+#define REF_GENRM_FRO blasfeo_ref_dgenrm_fro
+#define REF_GENRM_MAX blasfeo_ref_dgenrm_max
 #define REF_DIAIN blasfeo_ref_ddiain
 #define REF_DIAIN_SP blasfeo_ref_ddiain_sp
 #define REF_DIAEX blasfeo_ref_ddiaex
@@ -184,6 +188,10 @@
 #define VECZE blasfeo_dvecze
 #define VECNRM_INF blasfeo_dvecnrm_inf
 #define VECNRM_2 blasfeo_dvecnrm_2
+#define GENRM_1 blasfeo_dgenrm_1
+#define GENRM_INF blasfeo_dgenrm_inf
+#define GENRM_FRO blasfeo_dgenrm_fro
+#define GENRM_MAX blasfeo_dgenrm_max
 #define DIAIN blasfeo_ddiain
 #define DIAIN_SP blasfeo_ddiain_sp
 #define DIAEX blasfeo_ddiaex
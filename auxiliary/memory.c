@@ -86,7 +86,7 @@ void blasfeo_init()
 	size += 2*4096;
 //	printf("\nsize %d\n", size);
 	// call malloc
-	mem = malloc(size);
+	blasfeo_malloc(&mem, size);
 	initialized = 1;
 	}
 
@@ -94,7 +94,7 @@ void blasfeo_init()
 
 void blasfeo_quit()
 	{
-	free(mem);
+	blasfeo_free(mem);
 	initialized = 0;
 	}
 
@@ -35,6 +35,11 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#if !defined(OS_WINDOWS)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <blasfeo_block_size.h>
 #include <blasfeo_common.h>
@@ -53,6 +58,8 @@
 #define MATEL BLASFEO_SMATEL
 #define VEC blasfeo_svec
 #define VECEL BLASFEO_SVECEL
+#define PS S_PS
+#define PLD S_PLD
 
 
 
@@ -75,6 +82,12 @@
 #define PRINT_EXP_TRAN_MAT blasfeo_print_exp_tran_smat
 #define PRINT_EXP_VEC blasfeo_print_exp_svec
 #define PRINT_EXP_TRAN_VEC blasfeo_print_exp_tran_svec
+#define SAVE_MAT blasfeo_save_smat
+#define LOAD_MAT blasfeo_load_smat
+#define UNLOAD_MAT blasfeo_unload_smat
+#define SAVE_VEC blasfeo_save_svec
+#define LOAD_VEC blasfeo_load_svec
+#define UNLOAD_VEC blasfeo_unload_svec
 
 
 
@@ -113,6 +113,10 @@
 #define REF_VECZE blasfeo_hp_svecze
 #define REF_VECNRM_INF blasfeo_hp_svecnrm_inf
 #define REF_VECNRM_2 blasfeo_hp_svecnrm_2
+#define REF_GENRM_1 blasfeo_hp_sgenrm_1
+#define REF_GENRM_INF blasfeo_hp_sgenrm_inf
+#define REF_GENRM_FRO blasfeo_hp_sgenrm_fro
+#define REF_GENRM_MAX blasfeo_hp_sgenrm_max
 #define REF_DIAIN blasfeo_hp_sdiain
 #define REF_DIAIN_SP blasfeo_hp_sdiain_sp
 #define REF_DIAEX blasfeo_hp_sdiaex
@@ -178,6 +182,10 @@
 #define VECZE blasfeo_svecze
 #define VECNRM_INF blasfeo_svecnrm_inf
 #define VECNRM_2 blasfeo_svecnrm_2
+#define GENRM_1 blasfeo_sgenrm_1
+#define GENRM_INF blasfeo_sgenrm_inf
+#define GENRM_FRO blasfeo_sgenrm_fro
+#define GENRM_MAX blasfeo_sgenrm_max
 #define DIAIN blasfeo_sdiain
 #define DIAIN_SP blasfeo_sdiain_sp
 #define DIAEX blasfeo_sdiaex
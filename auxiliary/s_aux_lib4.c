@@ -3850,6 +3850,184 @@ void blasfeo_svecnrm_2(int m, struct blasfeo_svec *sx, int xi, float *ptr_norm)
 
 
 
+// compute 1 norm of matrix (max abs column sum)
+void blasfeo_sgenrm_1(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	float *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	float *pA0;
+	float acc[4];
+	float norm = 0.0;
+	float tmp;
+	if(m<=0)
+		n = 0;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		pA0 = pA + jj*bs;
+		// unaligned first panel
+		i0 = air;
+		i1 = air+m<bs ? air+m : bs;
+		for(ll=i0; ll<i1; ll++)
+			acc[ll] += fabsf(pA0[ll]);
+		ii = i1-i0;
+		pA0 += bs*sda;
+		// full panels
+		for(; ii<m-(bs-1); ii+=bs)
+			{
+			for(ll=0; ll<bs; ll++)
+				acc[ll] += fabsf(pA0[ll]);
+			pA0 += bs*sda;
+			}
+		// last panel
+		for(ll=0; ll<m-ii; ll++)
+			acc[ll] += fabsf(pA0[ll]);
+		tmp = 0.0;
+		for(ll=0; ll<bs; ll++)
+			tmp += acc[ll];
+		norm = norm>=tmp ? norm : tmp;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute inf norm of matrix (max abs row sum)
+void blasfeo_sgenrm_inf(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	float *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	float acc[4];
+	float norm = 0.0;
+	if(n<=0)
+		m = 0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		for(ll=0; ll<bs; ll++)
+			acc[ll] = 0.0;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += fabsf(pA[jj*bs+ll]);
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += fabsf(pA[jj*bs+ll]);
+			}
+		for(ll=0; ll<bs; ll++)
+			norm = norm>=acc[ll] ? norm : acc[ll];
+		pA += bs*sda;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute Frobenius norm of matrix
+void blasfeo_sgenrm_fro(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	float *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	float acc[4];
+	float norm = 0.0;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					acc[ll] += pA[jj*bs+ll]*pA[jj*bs+ll];
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm += acc[ll];
+	norm = sqrtf(norm);
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute max abs element of matrix
+void blasfeo_sgenrm_max(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm)
+	{
+	const int bs = 4;
+	int sda = sA->cn;
+	float *pA = sA->pA + ai/bs*bs*sda + aj*bs;
+	int air = ai%bs;
+	int ii, jj, ll, i0, i1;
+	float acc[4];
+	float norm = 0.0;
+	float tmp;
+	if(n<=0)
+		m = 0;
+	for(ll=0; ll<bs; ll++)
+		acc[ll] = 0.0;
+	// row range [i0,i1) of each panel
+	i0 = air;
+	for(ii=0; ii<m; ii+=i1-i0, i0=0)
+		{
+		i1 = i0+m-ii<bs ? i0+m-ii : bs;
+		if(i0==0 & i1==bs)
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=0; ll<bs; ll++)
+					{
+					tmp = fabsf(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		else
+			{
+			for(jj=0; jj<n; jj++)
+				for(ll=i0; ll<i1; ll++)
+					{
+					tmp = fabsf(pA[jj*bs+ll]);
+					acc[ll] = acc[ll]>=tmp ? acc[ll] : tmp;
+					}
+			}
+		pA += bs*sda;
+		}
+	for(ll=0; ll<bs; ll++)
+		norm = norm>=acc[ll] ? norm : acc[ll];
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
 // permute elements of a vector struct
 void blasfeo_svecpe(int kmax, int *ipiv, struct blasfeo_svec *sx, int xi)
 	{
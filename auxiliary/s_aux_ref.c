@@ -112,6 +112,10 @@
 #define REF_VECZE blasfeo_ref_svecze
 #define REF_VECNRM_INF blasfeo_ref_svecnrm_inf
 #define REF_VECNRM_2 blasfeo_ref_svecnrm_2
+#define REF_GENRM_1 blasfeo_ref_sgenrm_1
+#define REF_GENRM_INF blasfeo_ref_sgenrm_inf
+#define REF_GENRM_FRO blasfeo_ref_sgenrm_fro
+#define REF_GENRM_MAX blasfeo_ref_sgenrm_max
 #define REF_DIAIN blasfeo_ref_sdiain
 #define REF_DIAIN_SP blasfeo_ref_sdiain_sp
 #define REF_DIAEX blasfeo_ref_sdiaex
@@ -177,6 +181,10 @@
 #define VECZE blasfeo_svecze
 #define VECNRM_INF blasfeo_svecnrm_inf
 #define VECNRM_2 blasfeo_svecnrm_2
+#define GENRM_1 blasfeo_sgenrm_1
+#define GENRM_INF blasfeo_sgenrm_inf
+#define GENRM_FRO blasfeo_sgenrm_fro
+#define GENRM_MAX blasfeo_sgenrm_max
 #define DIAIN blasfeo_sdiain
 #define DIAIN_SP blasfeo_sdiain_sp
 #define DIAEX blasfeo_sdiaex
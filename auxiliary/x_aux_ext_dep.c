@@ -309,3 +309,231 @@ void PRINT_EXP_TRAN_VEC(int m, struct VEC *sa, int ai)
 	}
 
 
+
+
+
+// binary container of matrix and vector structures: a 128-byte header followed by the memory of the
+// structure, in the native byte order and memory format of the library that wrote it
+#define BINARY_VERSION 1
+#define BINARY_HEADER_SIZE 128
+#define BINARY_MAT 0
+#define BINARY_VEC 1
+
+struct binary_header
+	{
+	char magic[8]; // "BLASFEO"
+	int endian; // 0x01020304 in the byte order of the writer
+	int version;
+	int type; // BINARY_MAT or BINARY_VEC
+	int el_size; // bytes per element
+	int ps; // panel size, 0 for column-major
+	int pld; // GCD of panel length, 0 for column-major
+	int m;
+	int n;
+	int pm;
+	int cn;
+	int use_dA;
+	int memsize; // bytes following the header
+	char pad[BINARY_HEADER_SIZE-56];
+	};
+
+
+
+static void binary_header_init(struct binary_header *head, int type, int m, int n, int pm, int cn, int use_dA, int memsize)
+	{
+	memset(head, 0, sizeof(struct binary_header));
+	memcpy(head->magic, "BLASFEO", 8);
+	head->endian = 0x01020304;
+	head->version = BINARY_VERSION;
+	head->type = type;
+	head->el_size = sizeof(REAL);
+#if defined(MF_COLMAJ)
+	head->ps = 0;
+	head->pld = 0;
+#else
+	head->ps = PS;
+	head->pld = PLD;
+#endif
+	head->m = m;
+	head->n = n;
+	head->pm = pm;
+	head->cn = cn;
+	head->use_dA = use_dA;
+	head->memsize = memsize;
+	}
+
+
+
+static int binary_save(char *file_name, struct binary_header *head, void *data)
+	{
+	FILE *file = fopen(file_name, "wb");
+	if(file==NULL)
+		return 1;
+	int err = fwrite(head, sizeof(struct binary_header), 1, file)!=1;
+	err |= fwrite(data, head->memsize, 1, file)!=1;
+	err |= fclose(file)!=0;
+	return err;
+	}
+
+
+
+// map (or read) a binary file and check that it holds a structure of the given type
+// stored in the memory format of this library; on success head_out points to the header
+static int binary_load(char *file_name, int type, struct binary_header **head_out)
+	{
+	struct binary_header head;
+	FILE *file = fopen(file_name, "rb");
+	if(file==NULL)
+		return 1;
+	if(fread(&head, sizeof(struct binary_header), 1, file)!=1)
+		{
+		fclose(file);
+		return 2;
+		}
+	if(memcmp(head.magic, "BLASFEO", 8)!=0 | head.endian!=0x01020304 | head.version!=BINARY_VERSION | head.type!=type | head.memsize<0)
+		{
+		fclose(file);
+		return 2;
+		}
+#if defined(MF_COLMAJ)
+	if(head.el_size!=sizeof(REAL) | head.ps!=0 | head.pld!=0)
+#else
+	if(head.el_size!=sizeof(REAL) | head.ps!=PS | head.pld!=PLD)
+#endif
+		{
+		fclose(file);
+		return 3;
+		}
+	size_t size = BINARY_HEADER_SIZE + head.memsize;
+	void *mem;
+#if defined(OS_WINDOWS)
+	blasfeo_malloc_align(&mem, size);
+	rewind(file);
+	if(fread(mem, size, 1, file)!=1)
+		{
+		blasfeo_free_align(mem);
+		fclose(file);
+		return 2;
+		}
+#else
+	struct stat file_stat;
+	if(fstat(fileno(file), &file_stat)!=0 || (size_t) file_stat.st_size<size)
+		{
+		fclose(file);
+		return 2;
+		}
+	// private copy-on-write mapping: the structure can be modified without changing the file
+	mem = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+	if(mem==MAP_FAILED)
+		{
+		fclose(file);
+		return 1;
+		}
+#endif
+	fclose(file);
+	*head_out = (struct binary_header *) mem;
+	return 0;
+	}
+
+
+
+static void binary_unload(void *data)
+	{
+	struct binary_header *head = (struct binary_header *) ((char *) data - BINARY_HEADER_SIZE);
+#if defined(OS_WINDOWS)
+	blasfeo_free_align(head);
+#else
+	munmap(head, BINARY_HEADER_SIZE + head->memsize);
+#endif
+	}
+
+
+
+// save a matrix structure to a binary file
+int SAVE_MAT(char *file_name, struct MAT *sA)
+	{
+	struct binary_header head;
+#if defined(MF_COLMAJ)
+	binary_header_init(&head, BINARY_MAT, sA->m, sA->n, sA->m, sA->n, sA->use_dA, sA->memsize);
+#else
+	binary_header_init(&head, BINARY_MAT, sA->m, sA->n, sA->pm, sA->cn, sA->use_dA, sA->memsize);
+#endif
+	return binary_save(file_name, &head, sA->pA);
+	}
+
+
+
+// load a matrix structure from a binary file, using the mapped file as memory
+int LOAD_MAT(char *file_name, struct MAT *sA)
+	{
+	struct binary_header *head;
+	int err = binary_load(file_name, BINARY_MAT, &head);
+	if(err)
+		return err;
+	char *data = (char *) head + BINARY_HEADER_SIZE;
+#if defined(MF_COLMAJ)
+	CREATE_MAT(head->m, head->n, sA, data);
+#else
+	// the stored cn may be larger than needed by n (padded stride)
+	CREATE_MAT(head->m, head->cn, sA, data);
+	sA->n = head->n;
+#endif
+	if(sA->memsize!=head->memsize)
+		{
+		binary_unload(data);
+		return 3;
+		}
+	sA->use_dA = head->use_dA;
+	return 0;
+	}
+
+
+
+// release a matrix structure created by LOAD_MAT
+void UNLOAD_MAT(struct MAT *sA)
+	{
+	binary_unload(sA->mem);
+	return;
+	}
+
+
+
+// save a vector structure to a binary file
+int SAVE_VEC(char *file_name, struct VEC *sa)
+	{
+	struct binary_header head;
+#if defined(MF_COLMAJ)
+	binary_header_init(&head, BINARY_VEC, sa->m, 1, sa->m, 1, 0, sa->memsize);
+#else
+	binary_header_init(&head, BINARY_VEC, sa->m, 1, sa->pm, 1, 0, sa->memsize);
+#endif
+	return binary_save(file_name, &head, sa->pa);
+	}
+
+
+
+// load a vector structure from a binary file, using the mapped file as memory
+int LOAD_VEC(char *file_name, struct VEC *sa)
+	{
+	struct binary_header *head;
+	int err = binary_load(file_name, BINARY_VEC, &head);
+	if(err)
+		return err;
+	char *data = (char *) head + BINARY_HEADER_SIZE;
+	CREATE_VEC(head->m, sa, data);
+	if(sa->memsize!=head->memsize)
+		{
+		binary_unload(data);
+		return 3;
+		}
+	return 0;
+	}
+
+
+
+// release a vector structure created by LOAD_VEC
+void UNLOAD_VEC(struct VEC *sa)
+	{
+	binary_unload(sa->mem);
+	return;
+	}
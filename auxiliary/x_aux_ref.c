@@ -1029,6 +1029,113 @@ void REF_VECNRM_2(int m, struct VEC *sx, int xi, REAL *ptr_norm)
 
 
 
+// compute 1 norm of matrix (max abs column sum)
+void REF_GENRM_1(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	const int aai=0; const int aaj=0;
+#else
+	int aai=ai; int aaj=aj;
+#endif
+	int ii, jj;
+	REAL norm = 0.0;
+	REAL tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		tmp = 0.0;
+		for(ii=0; ii<m; ii++)
+			tmp += FABS(XMATEL_A(aai+ii, aaj+jj));
+		norm = norm>=tmp ? norm : tmp;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute inf norm of matrix (max abs row sum)
+void REF_GENRM_INF(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	const int aai=0; const int aaj=0;
+#else
+	int aai=ai; int aaj=aj;
+#endif
+	int ii, jj;
+	REAL norm = 0.0;
+	REAL tmp;
+	for(ii=0; ii<m; ii++)
+		{
+		tmp = 0.0;
+		for(jj=0; jj<n; jj++)
+			tmp += FABS(XMATEL_A(aai+ii, aaj+jj));
+		norm = norm>=tmp ? norm : tmp;
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute Frobenius norm of matrix
+void REF_GENRM_FRO(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	const int aai=0; const int aaj=0;
+#else
+	int aai=ai; int aaj=aj;
+#endif
+	int ii, jj;
+	REAL norm = 0.0;
+	REAL tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ii=0; ii<m; ii++)
+			{
+			tmp = XMATEL_A(aai+ii, aaj+jj);
+			norm += tmp*tmp;
+			}
+		}
+	norm = SQRT(norm);
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
+// compute max abs element of matrix
+void REF_GENRM_MAX(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	const int aai=0; const int aaj=0;
+#else
+	int aai=ai; int aaj=aj;
+#endif
+	int ii, jj;
+	REAL norm = 0.0;
+	REAL tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ii=0; ii<m; ii++)
+			{
+			tmp = FABS(XMATEL_A(aai+ii, aaj+jj));
+			norm = norm>=tmp ? norm : tmp;
+			}
+		}
+	*ptr_norm = norm;
+	return;
+	}
+
+
+
 // insert a vector into diagonal
 void REF_DIAIN(int kmax, REAL alpha, struct VEC *sx, int xi, struct MAT *sA, int ai, int aj)
 	{
@@ -1826,6 +1933,34 @@ void VECNRM_2(int m, struct VEC *sx, int xi, REAL *ptr_norm)
 
 
 
+void GENRM_1(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+	REF_GENRM_1(m, n, sA, ai, aj, ptr_norm);
+	}
+
+
+
+void GENRM_INF(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+	REF_GENRM_INF(m, n, sA, ai, aj, ptr_norm);
+	}
+
+
+
+void GENRM_FRO(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+	REF_GENRM_FRO(m, n, sA, ai, aj, ptr_norm);
+	}
+
+
+
+void GENRM_MAX(int m, int n, struct MAT *sA, int ai, int aj, REAL *ptr_norm)
+	{
+	REF_GENRM_MAX(m, n, sA, ai, aj, ptr_norm);
+	}
+
+
+
 void DIAIN(int kmax, REAL alpha, struct VEC *sx, int xi, struct MAT *sA, int ai, int aj)
 	{
 	REF_DIAIN(kmax, alpha, sx, xi, sA, ai, aj);
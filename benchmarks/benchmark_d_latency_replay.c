@@ -0,0 +1,199 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+// latency of a recorded call sequence: the factorization of the backward Riccati recursion of
+// examples/example_d_riccati_recursion.c is captured once in a blasfeo_graph and replayed,
+// timing each replay on its own
+//
+// optional command line arguments: N nx nu nrep
+//
+// the capture requires a panel-major LA=HIGH_PERFORMANCE library built with GRAPH=1, otherwise
+// the recursion is timed by direct calls
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo.h>
+#include "benchmark_x_common.h"
+
+
+
+// number of calls recorded for a horizon of N stages
+#define REPLAY_MAX_NODES(N) (2*(N)+1)
+
+
+
+static void d_back_ric_trf(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsL, struct blasfeo_dmat *hswork_mat)
+	{
+
+	int nn;
+
+	// last stage
+	blasfeo_dpotrf_l(nx[N], &hsRSQrq[N], 0, 0, &hsL[N], 0, 0);
+
+	// middle stages
+	for(nn=0; nn<N; nn++)
+		{
+		blasfeo_dtrmm_rlnn(nu[N-nn-1]+nx[N-nn-1], nx[N-nn], 1.0, &hsL[N-nn], nu[N-nn], nu[N-nn], &hsBAbt[N-nn-1], 0, 0, &hswork_mat[0], 0, 0);
+		blasfeo_dsyrk_dpotrf_ln(nu[N-nn-1]+nx[N-nn-1], nx[N-nn], &hswork_mat[0], 0, 0, &hswork_mat[0], 0, 0, &hsRSQrq[N-nn-1], 0, 0, &hsL[N-nn-1], 0, 0);
+		}
+
+	return;
+
+	}
+
+
+
+int main(int argc, char **argv)
+	{
+
+	benchmark_pin_cpu();
+
+	int ii, jj, rep;
+
+	int N = argc>1 ? atoi(argv[1]) : 10;
+	int nx_ = argc>2 ? atoi(argv[2]) : 8;
+	int nu_ = argc>3 ? atoi(argv[3]) : 3;
+	int nrep = argc>4 ? atoi(argv[4]) : 10000;
+
+	int *nx = malloc((N+1)*sizeof(int));
+	int *nu = malloc((N+1)*sizeof(int));
+	for(ii=0; ii<N; ii++)
+		{
+		nx[ii] = nx_;
+		nu[ii] = nu_;
+		}
+	nx[N] = nx_;
+	nu[N] = 0;
+
+	// problem data: random dynamics, diagonally dominant cost
+	struct blasfeo_dmat *hsBAbt = malloc(N*sizeof(struct blasfeo_dmat));
+	struct blasfeo_dmat *hsRSQrq = malloc((N+1)*sizeof(struct blasfeo_dmat));
+	struct blasfeo_dmat *hsL = malloc((N+1)*sizeof(struct blasfeo_dmat));
+	struct blasfeo_dmat hswork_mat[1];
+
+	for(ii=0; ii<=N; ii++)
+		{
+		int nv = nu[ii]+nx[ii];
+		blasfeo_allocate_dmat(nv+1, nv, &hsRSQrq[ii]);
+		blasfeo_allocate_dmat(nv+1, nv, &hsL[ii]);
+		blasfeo_dgese(nv+1, nv, 0.0, &hsRSQrq[ii], 0, 0);
+		blasfeo_dgese(nv+1, nv, 0.0, &hsL[ii], 0, 0);
+		for(jj=0; jj<nv; jj++)
+			{
+			BLASFEO_DMATEL(&hsRSQrq[ii], jj, jj) = nv;
+			for(rep=jj+1; rep<nv+1; rep++)
+				BLASFEO_DMATEL(&hsRSQrq[ii], rep, jj) = (double) rand() / RAND_MAX - 0.5;
+			}
+		}
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, nx[ii+1], &hsBAbt[ii]);
+		for(jj=0; jj<nx[ii+1]; jj++)
+			for(rep=0; rep<nu[ii]+nx[ii]+1; rep++)
+				BLASFEO_DMATEL(&hsBAbt[ii], rep, jj) = (double) rand() / RAND_MAX - 0.5;
+		}
+	blasfeo_allocate_dmat(nu_+nx_+1, nx_, &hswork_mat[0]);
+
+	// capture
+#if defined(BLASFEO_GRAPH)
+	struct blasfeo_graph graph;
+	void *graph_mem = malloc(blasfeo_graph_memsize(REPLAY_MAX_NODES(N)));
+	blasfeo_graph_create(REPLAY_MAX_NODES(N), &graph, graph_mem);
+	blasfeo_graph_begin(&graph);
+	d_back_ric_trf(N, nx, nu, hsBAbt, hsRSQrq, hsL, hswork_mat);
+	blasfeo_graph_end();
+	fprintf(stderr, "replay of %d recorded calls\n", graph.n_nodes);
+#else
+	fprintf(stderr, "library built without GRAPH=1: direct calls\n");
+#endif
+
+	// per-call times, and mean, p50, p99, p99.9, max
+	struct benchmark_latency_timer timer;
+	double *time_call = malloc(nrep*sizeof(double));
+	double stats[5];
+
+	for(rep=0; rep<nrep; rep++)
+		{
+#if defined(BENCHMARK_FLUSH_CACHE)
+		benchmark_flush_cache();
+#endif
+		benchmark_latency_tic(&timer);
+#if defined(BLASFEO_GRAPH)
+		blasfeo_graph_replay(&graph);
+#else
+		d_back_ric_trf(N, nx, nu, hsBAbt, hsRSQrq, hsL, hswork_mat);
+#endif
+		time_call[rep] = benchmark_latency_toc(&timer);
+		}
+
+	benchmark_latency_stats(nrep, time_call, stats);
+
+#if defined(BENCHMARK_OUTPUT_CSV)
+	printf("N,nx,nu,mean_us,p50_us,p99_us,p999_us,max_us\n");
+	printf("%d,%d,%d,%f,%f,%f,%f,%f\n",
+		N, nx_, nu_, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4]);
+#elif defined(BENCHMARK_OUTPUT_JSON)
+	printf("{\"N\": %d, \"nx\": %d, \"nu\": %d, \"mean_us\": %f, \"p50_us\": %f, \"p99_us\": %f, \"p999_us\": %f, \"max_us\": %f}\n",
+		N, nx_, nu_, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4]);
+#else
+	printf("%% N nx nu mean_us p50_us p99_us p999_us max_us\n");
+	printf("A = [%d %d %d %9.3f %9.3f %9.3f %9.3f %9.3f];\n",
+		N, nx_, nu_, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4]);
+#endif
+
+	// free
+	free(time_call);
+#if defined(BLASFEO_GRAPH)
+	free(graph_mem);
+#endif
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_free_dmat(&hsRSQrq[ii]);
+		blasfeo_free_dmat(&hsL[ii]);
+		}
+	for(ii=0; ii<N; ii++)
+		blasfeo_free_dmat(&hsBAbt[ii]);
+	blasfeo_free_dmat(&hswork_mat[0]);
+	free(hsBAbt);
+	free(hsRSQrq);
+	free(hsL);
+	free(nx);
+	free(nu);
+
+	return 0;
+
+	}
@@ -33,14 +33,15 @@
 *                                                                                                 *
 **************************************************************************************************/
 
-#if !defined(GHZ_MAX)
+#if !defined(GHZ_MAX) & !defined(BENCHMARK_CALIBRATE_FREQ)
 #include "cpu_freq.h"
 #if !defined(GHZ_MAX)
 int main()
 	{
 	printf("\n\n Define GHZ_MAX=x.x in the header file cpu_freq.h,\n");
 	printf("or recompile this benchmarks with GHZ_MAX=x.x\n");
-	printf("where x.x is the max frequency of the CPU of your current machine.\n");
+	printf("where x.x is the max frequency of the CPU of your current machine,\n");
+	printf("or recompile this benchmarks with BENCHMARK_CALIBRATE_FREQ=1 to measure it at startup.\n");
 	return 0;
 	}
 #endif
@@ -48,3 +49,232 @@ int main()
 
 
 
+#if defined(BENCHMARK_CALIBRATE_FREQ)
+
+// dependency chain of register-register integer additions, each one has one cycle latency
+// on all supported targets, so that nrep*BENCHMARK_CHAIN_LEN cycles are spent
+#define BENCHMARK_CHAIN_LEN 32
+
+static void benchmark_chain(long long nrep)
+	{
+	long long ii;
+	long long acc = 0;
+	for(ii=0; ii<nrep; ii++)
+		{
+#if (defined(__GNUC__) | defined(__clang__)) & defined(__x86_64__)
+		__asm__ volatile(
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			"addq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\taddq %0, %0\n\t"
+			: "+r" (acc));
+#elif (defined(__GNUC__) | defined(__clang__)) & defined(__aarch64__)
+		__asm__ volatile(
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			"add %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\tadd %0, %0, %0\n\t"
+			: "+r" (acc));
+#else
+#error BENCHMARK_CALIBRATE_FREQ not supported for this architecture, define GHZ_MAX instead
+#endif
+		}
+	return;
+	}
+
+
+
+// measure the sustained frequency in GHz, as the best of a few batches after a warm-up
+static double benchmark_calibrate_ghz()
+	{
+	blasfeo_timer timer;
+	long long nrep = 10000000;
+	double time, time_min = 1e15;
+	int rep_in;
+	benchmark_chain(nrep); // warm-up, let the frequency ramp up
+	for(rep_in=0; rep_in<10; rep_in++)
+		{
+		blasfeo_tic(&timer);
+		benchmark_chain(nrep);
+		time = blasfeo_toc(&timer);
+		time_min = time<time_min ? time : time_min;
+		}
+	return 1e-9 * nrep * BENCHMARK_CHAIN_LEN / time_min;
+	}
+
+#endif
+
+
+
+// sustained copy bandwidth in GB/s for a working set of the given size in bytes,
+// as measured by the microbenchmarks/microbenchmark_bandwidth.c copy kernel
+static double benchmark_bandwidth(double size)
+	{
+	blasfeo_timer timer;
+	int n = size / (2*sizeof(double));
+	n = n<64 ? 64 : n;
+	int nrep = 256*1024*1024 / (n*sizeof(double)); // about 256 MB of traffic per batch
+	nrep = nrep>1 ? nrep : 1;
+	int rep, rep_in;
+	double time, time_min = 1e15;
+	double *x; blasfeo_malloc_align((void **) &x, n*sizeof(double));
+	double *y; blasfeo_malloc_align((void **) &y, n*sizeof(double));
+	for(rep=0; rep<n; rep++)
+		x[rep] = 1.0;
+	kernel_dveccp_inc1(n, x, y);
+	for(rep_in=0; rep_in<3; rep_in++)
+		{
+		blasfeo_tic(&timer);
+		for(rep=0; rep<nrep; rep++)
+			kernel_dveccp_inc1(n, x, y);
+		time = blasfeo_toc(&timer) / nrep;
+		time_min = time<time_min ? time : time_min;
+		}
+	blasfeo_free_align(x);
+	blasfeo_free_align(y);
+	return 1e-9 * 2.0 * n * sizeof(double) / time_min;
+	}
+
+
+
+#if defined(BENCHMARK_CPU) & defined(__linux__)
+#include <sched.h>
+#endif
+
+// pin the calling thread to the cpu BENCHMARK_CPU (linux only), to avoid migrations in the timings
+static void benchmark_pin_cpu()
+	{
+#if defined(BENCHMARK_CPU) & defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(BENCHMARK_CPU, &set);
+	if(sched_setaffinity(0, sizeof(set), &set)!=0)
+		fprintf(stderr, "warning: can not pin to cpu %d\n", BENCHMARK_CPU);
+#endif
+	return;
+	}
+
+
+
+// size in bytes of the buffer streamed through the caches to evict the operands, larger than the LLC
+#ifndef BENCHMARK_FLUSH_SIZE
+#define BENCHMARK_FLUSH_SIZE (64*1024*1024)
+#endif
+
+// evict the caches, by reading and writing a buffer of BENCHMARK_FLUSH_SIZE bytes ; the buffer is allocated at the first call
+static void benchmark_flush_cache()
+	{
+	static double *buf = NULL;
+	static volatile double sink;
+	int n = BENCHMARK_FLUSH_SIZE / sizeof(double);
+	int ii;
+	double tmp = 0.0;
+	if(buf==NULL)
+		{
+		blasfeo_malloc_align((void **) &buf, n*sizeof(double));
+		for(ii=0; ii<n; ii++)
+			buf[ii] = 0.0;
+		}
+	for(ii=0; ii<n; ii+=8) // one element per cache line
+		{
+		tmp += buf[ii];
+		buf[ii] = tmp;
+		}
+	sink = tmp;
+	return;
+	}
+
+
+
+#if (defined(__GNUC__) | defined(__clang__)) & defined(__x86_64__)
+#include <x86intrin.h>
+#define BENCHMARK_TSC
+#endif
+
+// per-call timer: the invariant time-stamp counter where available, since the resolution of
+// blasfeo_tic/blasfeo_toc can be as coarse as one microsecond
+struct benchmark_latency_timer
+	{
+	blasfeo_timer timer;
+	unsigned long long tsc;
+	};
+
+#if defined(BENCHMARK_TSC)
+// time-stamp counter ticks per second, measured against blasfeo_tic/blasfeo_toc at the first call
+static double benchmark_tsc_hz()
+	{
+	static double hz = 0.0;
+	blasfeo_timer timer;
+	unsigned long long tsc;
+	double time;
+	if(hz==0.0)
+		{
+		blasfeo_tic(&timer);
+		tsc = __rdtsc();
+		do
+			time = blasfeo_toc(&timer);
+		while(time<0.05);
+		hz = (__rdtsc() - tsc) / time;
+		}
+	return hz;
+	}
+#endif
+
+static void benchmark_latency_tic(struct benchmark_latency_timer *t)
+	{
+#if defined(BENCHMARK_TSC)
+	benchmark_tsc_hz();
+	t->tsc = __rdtsc();
+#else
+	blasfeo_tic(&t->timer);
+#endif
+	return;
+	}
+
+// time in seconds since the last call to benchmark_latency_tic on t
+static double benchmark_latency_toc(struct benchmark_latency_timer *t)
+	{
+#if defined(BENCHMARK_TSC)
+	return (__rdtsc() - t->tsc) / benchmark_tsc_hz();
+#else
+	return blasfeo_toc(&t->timer);
+#endif
+	}
+
+
+
+static int benchmark_cmp_double(const void *a, const void *b)
+	{
+	double x = *(const double *) a;
+	double y = *(const double *) b;
+	return x<y ? -1 : x>y;
+	}
+
+// latency statistics of the n per-call times in time (sorted in place): mean, and p50, p99, p99.9, max (nearest rank)
+static void benchmark_latency_stats(int n, double *time, double *stats)
+	{
+	int ii;
+	double mean = 0.0;
+	double pct[4] = {50.0, 99.0, 99.9, 100.0};
+	for(ii=0; ii<n; ii++)
+		mean += time[ii];
+	stats[0] = mean/n;
+	qsort(time, n, sizeof(double), benchmark_cmp_double);
+	for(ii=0; ii<4; ii++)
+		{
+		double rank = pct[ii]/100.0*n;
+		int idx = (int) rank;
+		idx = idx<rank ? idx : idx-1; // ceil(rank)-1
+		idx = idx<0 ? 0 : idx>n-1 ? n-1 : idx;
+		stats[ii+1] = time[idx];
+		}
+	return;
+	}
@@ -70,9 +70,16 @@ void openblas_set_num_threads(int num_threads);
 
 
 
-int main()
+// optional command line arguments: list of sizes to benchmark, instead of the default sweep
+//
+// with BENCHMARK_LATENCY each call is timed on its own, and the mean and the p50, p99, p99.9 and
+// max latency over all calls are reported in place of the Gflops of the fastest batch;
+// with BENCHMARK_FLUSH_CACHE the caches are evicted before each call (cold-cache latency)
+int main(int argc, char **argv)
 	{
 
+	benchmark_pin_cpu();
+
 #if defined(EXTERNAL_BLAS_OPENBLAS)
 	openblas_set_num_threads(1);
 #endif
@@ -88,7 +95,12 @@ int main()
 //#endif
 
 	// maximum frequency of the processor
-	const float GHz_max = GHZ_MAX;
+#if defined(BENCHMARK_CALIBRATE_FREQ)
+	// measured at startup, as the sustained frequency under load
+	const double GHz_max = benchmark_calibrate_ghz();
+#else
+	const double GHz_max = GHZ_MAX;
+#endif
 
 #if defined(DOUBLE_PRECISION)
 
@@ -164,6 +176,21 @@ int main()
 //	FILE *f;
 //	f = fopen("./test_problems/results/test_blas.m", "w"); // a
 
+#if defined(DOUBLE_PRECISION)
+	const int size_el = sizeof(double);
+#elif defined(SINGLE_PRECISION)
+	const int size_el = sizeof(float);
+#endif
+
+#if defined(BENCHMARK_LATENCY) & defined(BENCHMARK_OUTPUT_CSV)
+	printf("# GHz %f, flops/cycle %f\n", GHz_max, flops_max);
+	printf("n,mean_us,p50_us,p99_us,p999_us,max_us,Gflops_p50\n");
+#elif defined(BENCHMARK_OUTPUT_CSV)
+	printf("# GHz %f, flops/cycle %f\n", GHz_max, flops_max);
+	printf("n,Gflops,peak_pct,bandwidth_GBs,roofline_Gflops,roofline_pct\n");
+#elif defined(BENCHMARK_OUTPUT_JSON)
+	printf("{\n\"GHz\": %f,\n\"flops_per_cycle\": %f,\n\"results\": [\n", GHz_max, flops_max);
+#else
 	printf("A = [%f %f];\n", GHz_max, flops_max);
 //	fprintf(f, "A = [%f %f];\n", GHz_max, flops_max);
 	printf("\n");
@@ -171,6 +198,7 @@ int main()
 
 	printf("B = [\n");
 //	fprintf(f, "B = [\n");
+#endif
 
 
 
@@ -183,15 +211,26 @@ int main()
 	int nn[] = {4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64, 68, 72, 76, 80, 84, 88, 92, 96, 100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 144, 148, 152, 156, 160, 164, 168, 172, 176, 180, 184, 188, 192, 196, 200, 204, 208, 212, 216, 220, 224, 228, 232, 236, 240, 244, 248, 252, 256, 260, 264, 268, 272, 276, 280, 284, 288, 292, 296, 300, 304, 308, 312, 316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 356, 360, 364, 368, 372, 376, 380, 384, 388, 392, 396, 400, 404, 408, 412, 416, 420, 424, 428, 432, 436, 440, 444, 448, 452, 456, 460, 500, 550, 600, 650, 700};
 	int nnrep[] = {10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 400, 400, 400, 400, 400, 200, 200, 200, 200, 200, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 20, 20, 20, 20, 20, 20, 20, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 4, 4, 4, 4, 4};
 
-//	for(ll=0; ll<24; ll++)
-	for(ll=0; ll<75; ll++)
-//	for(ll=0; ll<115; ll++)
-//	for(ll=0; ll<120; ll++)
+	int n_size = 75;
+//	int n_size = 115;
+//	int n_size = 120;
+	if(argc>1)
+		n_size = argc-1;
+
+	for(ll=0; ll<n_size; ll++)
 
 		{
 
 		int n = nn[ll];
 		int nrep = nnrep[ll]/nrep_in;
+		if(argc>1)
+			{
+			// repetitions of the closest size in the default sweep
+			n = atoi(argv[ll+1]);
+			for(ii=0; ii<119 && nn[ii]<n; ii++)
+				;
+			nrep = nnrep[ii]/nrep_in;
+			}
 		nrep = nrep>1 ? nrep : 1;
 //		int n = ll+1;
 //		int nrep = nnrep[0];
@@ -220,6 +259,11 @@ int main()
 
 		int rep_in;
 
+#if defined(BENCHMARK_LATENCY) & defined(BENCHMARK_FLUSH_CACHE)
+		// each flush streams BENCHMARK_FLUSH_SIZE bytes: at most 1000 calls, enough for the p99.9
+		nrep = nrep<1000/nrep_in ? nrep : 1000/nrep_in;
+#endif
+
 #if defined(DOUBLE_PRECISION)
 		struct blasfeo_dmat sA; blasfeo_allocate_dmat(n, n, &sA);
 		struct blasfeo_dmat sB; blasfeo_allocate_dmat(n, n, &sB);
@@ -319,6 +363,13 @@ int main()
 		double tmp_time_blasfeo;
 		double tmp_time_blas;
 
+#if defined(BENCHMARK_LATENCY)
+		// per-call times, and mean, p50, p99, p99.9, max
+		struct benchmark_latency_timer timer_call;
+		double *time_call = malloc(nrep_in*nrep*sizeof(double));
+		double stats[5];
+#endif
+
 		/* benchmarks */
 
 		// batches repetion, find minimum averaged time
@@ -332,6 +383,12 @@ int main()
 			// averaged repetions
 			for(rep=0; rep<nrep; rep++)
 				{
+#if defined(BENCHMARK_LATENCY)
+#if defined(BENCHMARK_FLUSH_CACHE)
+				benchmark_flush_cache();
+#endif
+				benchmark_latency_tic(&timer_call);
+#endif
 #if defined(DOUBLE_PRECISION)
 
 #if defined(GEMM_NN)
@@ -542,6 +599,9 @@ int main()
 #error wrong routine
 #endif
 
+#endif
+#if defined(BENCHMARK_LATENCY)
+				time_call[rep_in*nrep+rep] = benchmark_latency_toc(&timer_call);
 #endif
 
 				}
@@ -574,11 +634,57 @@ int main()
 #error wrong routine
 #endif
 
+		// minimum memory traffic, in number of matrix elements
+#if defined(GEMM_NN) | defined(GEMM_NT) | defined(GEMM_TN) | defined(GEMM_TT)
+		double el_operation = 3.0*n*n;
+#elif defined(SYRK_LN) | defined(SYRK_LT) | defined(SYRK_UN) | defined(SYRK_UT) | defined(TRMM) | defined(TRSM)
+		double el_operation = 2.0*n*n;
+#elif defined(GELQF) | defined(GEQRF) | defined(GETRF_NOPIVOT) | defined(GETRF_ROWPIVOT) | defined(POTRF_L) | defined(POTRF_U)
+		double el_operation = 2.0*n*n;
+#elif defined(GEMV_N) | defined(GEMV_T) | defined(GEMV_NT)
+		double el_operation = 1.0*n*n;
+#elif defined(SYMV_L) | defined(TRMV_LNN) | defined(TRMV_LTN) | defined(TRSV_LNN) | defined(TRSV_LTN)
+		double el_operation = 0.5*n*n;
+#endif
+
+		// roofline: bandwidth of the cache level holding the working set
+		double GBs_operation = benchmark_bandwidth(el_operation*size_el);
+		double Gflops_roofline = flop_operation/(el_operation*size_el)*GBs_operation;
+		Gflops_roofline = Gflops_roofline<Gflops_max ? Gflops_roofline : Gflops_max;
+
 		double Gflops_blasfeo  = 1e-9*flop_operation/time_blasfeo;
 
-		printf("%d\t%7.3f\t%7.3f\n",
+#if defined(BENCHMARK_LATENCY)
+		benchmark_latency_stats(nrep_in*nrep, time_call, stats);
+		free(time_call);
+#if defined(BENCHMARK_OUTPUT_CSV)
+		printf("%d,%f,%f,%f,%f,%f,%f\n",
+			n, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4], 1e-9*flop_operation/stats[1]);
+#elif defined(BENCHMARK_OUTPUT_JSON)
+		printf("%s{\"n\": %d, \"mean_us\": %f, \"p50_us\": %f, \"p99_us\": %f, \"p999_us\": %f, \"max_us\": %f, \"Gflops_p50\": %f}\n",
+			ll==0 ? "" : ",",
+			n, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4], 1e-9*flop_operation/stats[1]);
+#else
+		printf("%d\t%9.3f\t%9.3f\t%9.3f\t%9.3f\t%9.3f\t%7.3f\n",
+			n, 1e6*stats[0], 1e6*stats[1], 1e6*stats[2], 1e6*stats[3], 1e6*stats[4], 1e-9*flop_operation/stats[1]);
+#endif
+#elif defined(BENCHMARK_OUTPUT_CSV)
+		printf("%d,%f,%f,%f,%f,%f\n",
 			n,
-			Gflops_blasfeo, 100.0*Gflops_blasfeo/Gflops_max);
+			Gflops_blasfeo, 100.0*Gflops_blasfeo/Gflops_max,
+			GBs_operation, Gflops_roofline, 100.0*Gflops_blasfeo/Gflops_roofline);
+#elif defined(BENCHMARK_OUTPUT_JSON)
+		printf("%s{\"n\": %d, \"Gflops\": %f, \"peak_pct\": %f, \"bandwidth_GBs\": %f, \"roofline_Gflops\": %f, \"roofline_pct\": %f}\n",
+			ll==0 ? "" : ",",
+			n,
+			Gflops_blasfeo, 100.0*Gflops_blasfeo/Gflops_max,
+			GBs_operation, Gflops_roofline, 100.0*Gflops_blasfeo/Gflops_roofline);
+#else
+		printf("%d\t%7.3f\t%7.3f\t%7.3f\t%7.3f\n",
+			n,
+			Gflops_blasfeo, 100.0*Gflops_blasfeo/Gflops_max,
+			Gflops_roofline, 100.0*Gflops_blasfeo/Gflops_roofline);
+#endif
 
 #if defined(DOUBLE_PRECISION)
 		blasfeo_free_dmat(&sA);
@@ -611,7 +717,11 @@ int main()
 
 		}
 
+#if defined(BENCHMARK_OUTPUT_JSON)
+	printf("]\n}\n");
+#elif !defined(BENCHMARK_OUTPUT_CSV)
 	printf("];\n");
+#endif
 
 	return 0;
 
@@ -0,0 +1,129 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_api.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define GETRI blasfeo_cm_dgetri
+#define MAT blasfeo_cm_dmat
+#else
+#define GETRI blasfeo_dgetri
+#define MAT blasfeo_dmat
+#endif
+#define REAL double
+
+
+
+#if defined(FORTRAN_BLAS_API)
+#define GETRI_ dgetri_
+#else
+#define GETRI_ blasfeo_lapack_dgetri
+#endif
+
+
+
+void GETRI_(int *pm, REAL *C, int *pldc, int *ipiv, REAL *work, int *plwork, int *info)
+	{
+
+#if defined(PRINT_NAME)
+	printf("\nblasfeo_lapack_dgetri %d %p %d %p %p %d %d\n", *pm, C, *pldc, ipiv, work, *plwork, *info);
+#endif
+
+	int m = *pm;
+	int ldc = *pldc;
+
+	int ii;
+
+	*info = 0;
+
+	// workspace query: the inversion allocates its own workspace
+	if(*plwork==-1)
+		{
+		work[0] = 1.0;
+		return;
+		}
+
+	if(m==0)
+		return;
+
+	// check for singularity
+	for(ii=0; ii<m; ii++)
+		{
+		if(C[ii*(ldc+1)]==0.0)
+			{
+			*info = ii+1;
+			return;
+			}
+		}
+
+	int ipiv0[K_MAX_STACK];
+	int *ip;
+	if(m>K_MAX_STACK)
+		{
+		ip = (int *) malloc(m*sizeof(int));
+		}
+	else
+		{
+		ip = ipiv0;
+		}
+
+	// from 1-based to 0-based
+	for(ii=0; ii<m; ii++)
+		{
+		ip[ii] = ipiv[ii]-1;
+		}
+
+	struct MAT sC;
+	sC.pA = C;
+	sC.m = *pldc;
+
+	GETRI(m, &sC, 0, 0, ip, &sC, 0, 0);
+
+	if(m>K_MAX_STACK)
+		{
+		free(ip);
+		}
+
+	return;
+
+	}
+
+
@@ -0,0 +1,128 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_api.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define POTRI_L blasfeo_cm_dpotri_l
+#define MAT blasfeo_cm_dmat
+#else
+#define POTRI_L blasfeo_dpotri_l
+#define MAT blasfeo_dmat
+#endif
+#define REAL double
+
+
+
+#if defined(FORTRAN_BLAS_API)
+#define POTRI dpotri_
+#else
+#define POTRI blasfeo_lapack_dpotri
+#endif
+
+
+
+void POTRI(char *uplo, int *pm, REAL *C, int *pldc, int *info)
+	{
+
+#if defined(PRINT_NAME)
+	printf("\nblasfeo_lapack_dpotri %c %d %p %d %d\n", *uplo, *pm, C, *pldc, *info);
+#endif
+
+	int m = *pm;
+	int ldc = *pldc;
+
+	int ii, jj;
+	REAL *T;
+
+	*info = 0;
+
+	if(m==0)
+		return;
+
+	// check for singularity
+	for(ii=0; ii<m; ii++)
+		{
+		if(C[ii*(ldc+1)]==0.0)
+			{
+			*info = ii+1;
+			return;
+			}
+		}
+
+	struct MAT sC;
+
+	if(*uplo=='l' | *uplo=='L')
+		{
+
+		sC.pA = C;
+		sC.m = ldc;
+
+		POTRI_L(m, &sC, 0, 0, &sC, 0, 0);
+
+		}
+	else
+		{
+
+		// A = U^T * U = L * L^T with L = U^T: the lower inverse is computed on the transposed factor
+		T = (REAL *) malloc(m*m*sizeof(REAL));
+		for(jj=0; jj<m; jj++)
+			for(ii=jj; ii<m; ii++)
+				T[ii+jj*m] = C[jj+ii*ldc];
+
+		sC.pA = T;
+		sC.m = m;
+
+		POTRI_L(m, &sC, 0, 0, &sC, 0, 0);
+
+		for(jj=0; jj<m; jj++)
+			for(ii=jj; ii<m; ii++)
+				C[jj+ii*ldc] = T[ii+jj*m];
+
+		free(T);
+
+		}
+
+	return;
+
+	}
+
+
@@ -0,0 +1,162 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_api.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define SYTRS_L blasfeo_cm_dsytrs_l
+#define MAT blasfeo_cm_dmat
+#else
+#define SYTRS_L blasfeo_dsytrs_l
+#define MAT blasfeo_dmat
+#endif
+#define REAL double
+
+
+
+#if defined(FORTRAN_BLAS_API)
+#define SYTRS dsytrs_
+#else
+#define SYTRS blasfeo_lapack_dsytrs
+#endif
+
+
+
+void SYTRS(char *uplo, int *pm, int *pn, REAL *A, int *plda, int *ipiv, REAL *B, int *pldb, int *info)
+	{
+
+#if defined(PRINT_NAME)
+	printf("\nblasfeo_lapack_dsytrs %c %d %d %p %d %p %p %d %d\n", *uplo, *pm, *pn, A, *plda, ipiv, B, *pldb, *info);
+#endif
+
+	int m = *pm;
+	int n = *pn;
+	int lda = *plda;
+	int ldb = *pldb;
+
+	int ii, jj;
+	REAL tmp;
+	REAL *T = NULL;
+
+	*info = 0;
+
+	if(m==0 | n==0)
+		return;
+
+	int ipiv0[K_MAX_STACK];
+	int *ip;
+	if(m>K_MAX_STACK)
+		{
+		ip = (int *) malloc(m*sizeof(int));
+		}
+	else
+		{
+		ip = ipiv0;
+		}
+
+	struct MAT sA;
+	struct MAT sB;
+	sB.pA = B;
+	sB.m = ldb;
+
+	if(*uplo=='l' | *uplo=='L')
+		{
+
+		// from 1-based to 0-based, 2x2 pivots stay negative
+		for(ii=0; ii<m; ii++)
+			{
+			ip[ii] = ipiv[ii]>0 ? ipiv[ii]-1 : ipiv[ii];
+			}
+
+		sA.pA = A;
+		sA.m = lda;
+
+		SYTRS_L(m, n, &sA, 0, 0, ip, &sB, 0, 0, &sB, 0, 0);
+
+		}
+	else
+		{
+
+		// the upper factorization of A is the lower factorization of J*A*J, with J the reversal permutation:
+		// solve (J*A*J) * (J*X) = J*B
+		for(ii=0; ii<m; ii++)
+			{
+			ip[m-1-ii] = ipiv[ii]>0 ? m-ipiv[ii] : -m-ipiv[ii]-1;
+			}
+
+		T = (REAL *) malloc(m*m*sizeof(REAL));
+		for(jj=0; jj<m; jj++)
+			for(ii=jj; ii<m; ii++)
+				T[ii+jj*m] = A[(m-1-ii)+(m-1-jj)*lda];
+
+		sA.pA = T;
+		sA.m = m;
+
+		for(jj=0; jj<n; jj++)
+			for(ii=0; ii<m/2; ii++)
+				{
+				tmp = B[ii+jj*ldb];
+				B[ii+jj*ldb] = B[(m-1-ii)+jj*ldb];
+				B[(m-1-ii)+jj*ldb] = tmp;
+				}
+
+		SYTRS_L(m, n, &sA, 0, 0, ip, &sB, 0, 0, &sB, 0, 0);
+
+		for(jj=0; jj<n; jj++)
+			for(ii=0; ii<m/2; ii++)
+				{
+				tmp = B[ii+jj*ldb];
+				B[ii+jj*ldb] = B[(m-1-ii)+jj*ldb];
+				B[(m-1-ii)+jj*ldb] = tmp;
+				}
+
+		free(T);
+
+		}
+
+	if(m>K_MAX_STACK)
+		{
+		free(ip);
+		}
+
+	return;
+
+	}
@@ -59,6 +59,8 @@
 #include <blasfeo_timing.h>
 
 #include <blasfeo_memory.h>
+#include <blasfeo_profile.h>
+#include <blasfeo_hybrid.h>
 
 //void *blas_memory_alloc(int);
 //void blas_memory_free(void *);
@@ -2685,7 +2687,7 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 		goto nn_0; // small matrix: no pack
 		}
 #elif defined(TARGET_X64_INTEL_SANDY_BRIDGE)
-	if( m<=48 & n<=48 & k<=K_MAX_STACK )
+	if( m<=D_GEMM_SMALL_MN & n<=D_GEMM_SMALL_MN & k<=K_MAX_STACK )
 		{
 		goto nn_m1; // small matrix: pack A
 		}
@@ -2702,7 +2704,7 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 		}
 #endif
 #if defined(TARGET_X64_INTEL_SKYLAKE_X) | defined(TARGET_X64_INTEL_HASWELL)
-	if( m<n*4 )
+	if( m<n*D_GEMM_MN_RATIO )
 		{
 #if defined(TARGET_X64_INTEL_SKYLAKE_X)
 //		if( n<=2*m_kernel | k_b*n <= l2_cache_el ) // TODO k_block
@@ -2737,7 +2739,7 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 	if( m<=1*m_kernel | n<=1*m_kernel | k<12 )
 #endif
 		{
-		if( m<=n*4 )
+		if( m<=n*D_GEMM_MN_RATIO )
 			{
 //			printf("\nalg m0\n");
 			goto nn_m1; // long matrix: pack A
@@ -2757,6 +2759,9 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 
 nn_m1:
+
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_M1);
+	BLASFEO_PROFILE_PACKED((long long) m*k*sizeof(double));
 	
 //	if(K_MAX_STACK<=0)
 //		goto nn_2;
@@ -2834,6 +2839,9 @@ nn_m1:
 
 nn_n1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_N1);
+	BLASFEO_PROFILE_PACKED((long long) n*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto nn_2;
 
@@ -2890,6 +2898,10 @@ nn_n1:
 
 nn_2:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_2);
+	// B is packed once per block of MC rows of A
+	BLASFEO_PROFILE_PACKED((long long) (m + n*((m+MC-1)/MC))*k*sizeof(double));
+
 #if defined(TARGET_X64_INTEL_SKYLAKE_X) | defined(TARGET_X64_INTEL_HASWELL) | defined(TARGET_X64_INTEL_SANDY_BRIDGE) | defined(TARGET_ARMV8A_ARM_CORTEX_A57) | defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 
 	// cache blocking alg
@@ -3118,7 +3130,7 @@ if (thp_count.pages_available) {
 	tB_size = (tB_size + 4096 - 1) / 4096 * 4096;
 	if(blasfeo_is_init()==0)
 		{
-		mem = malloc(tA_size+tB_size+2*4096);
+		blasfeo_malloc(&mem, tA_size+tB_size+2*4096);
 		}
 	else
 		{
@@ -3212,7 +3224,7 @@ if (thp_count.pages_available) {
 		}
 
 //	printf("\ntime: pack_A %e, pack_B %e, kernel %e, kernel2 %e, kernel3 %e\n", time_pack_A, time_pack_B, time_kernel, time_kernel2, time_kernel3); 
-	free(mem);
+	blasfeo_free(mem);
 
 	return;
 
@@ -3243,7 +3255,7 @@ if (thp_count.pages_available) {
 	tB_size = blasfeo_pm_memsize_dmat(ps, nc0, kc0);
 	tA_size = (tA_size + 4096 - 1) / 4096 * 4096;
 	tB_size = (tB_size + 4096 - 1) / 4096 * 4096;
-	mem = malloc(tA_size+tB_size+2*4096);
+	blasfeo_malloc(&mem, tA_size+tB_size+2*4096);
 	blasfeo_align_4096_byte(mem, (void **) &mem_align);
 
 	blasfeo_pm_create_dmat(ps, mc0, oc0, &tA, (void *) mem_align);
@@ -3328,7 +3340,7 @@ if (thp_count.pages_available) {
 		}
 
 //	printf("\ntime: pack_A %e, pack_B %e, kernel %e, kernel2 %e, kernel3 %e\n", time_pack_A, time_pack_B, time_kernel, time_kernel2, time_kernel3); 
-	free(mem);
+	blasfeo_free(mem);
 
 	return;
 
@@ -3344,7 +3356,7 @@ if (thp_count.pages_available) {
 	tB_size = blasfeo_pm_memsize_dmat(ps, n1, k1);
 //	mem = malloc(tA_size+tB_size+64);
 //	blasfeo_align_64_byte(mem, (void **) &mem_align);
-	mem = malloc(tA_size+tB_size+4096);
+	blasfeo_malloc(&mem, tA_size+tB_size+4096);
 	blasfeo_align_4096_byte(mem, (void **) &mem_align);
 	blasfeo_pm_create_dmat(ps, m_kernel, k, &tA, (void *) mem_align);
 	blasfeo_pm_create_dmat(ps, n, k, &tB, (void *) (mem_align+tA_size));
@@ -3478,13 +3490,15 @@ nn_2_left_4:
 	goto nn_2_return;
 
 nn_2_return:
-	free(mem);
+	blasfeo_free(mem);
 	return;
 
 #endif
 
 
 nn_0:
+
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_0);
 	ii = 0;
 #if defined(TARGET_X64_INTEL_HASWELL)
 	for(; ii<m-11; ii+=12)
@@ -3740,7 +3754,7 @@ void blasfeo_hp_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat
 		goto nt_0; // small matrix: no pack
 		}
 #elif defined(TARGET_X64_INTEL_SANDY_BRIDGE)
-	if( m<=48 & n<=48 & k<=K_MAX_STACK )
+	if( m<=D_GEMM_SMALL_MN & n<=D_GEMM_SMALL_MN & k<=K_MAX_STACK )
 		{
 		goto nt_m1; // small matrix: pack A
 		}
@@ -3808,6 +3822,9 @@ void blasfeo_hp_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 nt_m1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_M1);
+	BLASFEO_PROFILE_PACKED((long long) m*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto nt_2;
 
@@ -3864,6 +3881,9 @@ nt_m1:
 
 nt_n1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_N1);
+	BLASFEO_PROFILE_PACKED((long long) n*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto nt_2;
 
@@ -3921,6 +3941,10 @@ nt_n1:
 
 nt_2:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_2);
+	// B is packed once per block of MC rows of A
+	BLASFEO_PROFILE_PACKED((long long) (m + n*((m+MC-1)/MC))*k*sizeof(double));
+
 //#if 0
 #if defined(TARGET_X64_INTEL_SKYLAKE_X) | defined(TARGET_X64_INTEL_HASWELL) | defined(TARGET_X64_INTEL_SANDY_BRIDGE) | defined(TARGET_ARMV8A_ARM_CORTEX_A57) | defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 
@@ -4060,7 +4084,7 @@ nt_2:
 	tB_size = blasfeo_pm_memsize_dmat(ps, n1, k1);
 //	mem = malloc(tA_size+tB_size+64);
 //	blasfeo_align_64_byte(mem, (void **) &mem_align);
-	mem = malloc(tA_size+tB_size+4096);
+	blasfeo_malloc(&mem, tA_size+tB_size+4096);
 	blasfeo_align_4096_byte(mem, (void **) &mem_align);
 	blasfeo_pm_create_dmat(ps, m_kernel, k, &tA, (void *) mem_align);
 	blasfeo_pm_create_dmat(ps, n, k, &tB, (void *) (mem_align+tA_size));
@@ -4173,7 +4197,7 @@ nt_2_left_4:
 	goto nt_2_return;
 
 nt_2_return:
-	free(mem);
+	blasfeo_free(mem);
 	return;
 
 #endif
@@ -4181,6 +4205,8 @@ nt_2_return:
 
 
 nt_0:
+
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_0);
 	ii = 0;
 #if defined(TARGET_X64_INTEL_HASWELL)
 	for(; ii<m-11; ii+=12)
@@ -4472,6 +4498,9 @@ void blasfeo_hp_dgemm_tn(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 tn_m1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_M1);
+	BLASFEO_PROFILE_PACKED((long long) m*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto tn_2;
 
@@ -4529,6 +4558,9 @@ tn_m1:
 
 tn_n1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_N1);
+	BLASFEO_PROFILE_PACKED((long long) n*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto tn_2;
 
@@ -4587,6 +4619,10 @@ tn_n1:
 
 tn_2:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_2);
+	// B is packed once per block of MC rows of A
+	BLASFEO_PROFILE_PACKED((long long) (m + n*((m+MC-1)/MC))*k*sizeof(double));
+
 //#if 0
 #if defined(TARGET_X64_INTEL_SKYLAKE_X) | defined(TARGET_X64_INTEL_HASWELL) | defined(TARGET_X64_INTEL_SANDY_BRIDGE) | defined(TARGET_ARMV8A_ARM_CORTEX_A57) | defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 
@@ -4721,7 +4757,7 @@ tn_2:
 	tB_size = blasfeo_pm_memsize_dmat(ps, n1, k1);
 //	mem = malloc(tA_size+tB_size+64);
 //	blasfeo_align_64_byte(mem, (void **) &mem_align);
-	mem = malloc(tA_size+tB_size+4096);
+	blasfeo_malloc(&mem, tA_size+tB_size+4096);
 	blasfeo_align_4096_byte(mem, (void **) &mem_align);
 	blasfeo_pm_create_dmat(ps, m_kernel, k, &tA, (void *) mem_align);
 	blasfeo_pm_create_dmat(ps, n, k, &tB, (void *) (mem_align+tA_size));
@@ -4861,7 +4897,7 @@ tn_2_left_4:
 	goto tn_2_return;
 
 tn_2_return:
-free(mem);
+blasfeo_free(mem);
 	return;
 
 #endif
@@ -4999,7 +5035,7 @@ void blasfeo_hp_dgemm_tt(int m, int n, int k, double alpha, struct blasfeo_dmat
 		goto tt_0; // small matrix: no pack
 		}
 #elif defined(TARGET_X64_INTEL_SANDY_BRIDGE)
-	if( m<=48 & n<=48 & k<=K_MAX_STACK )
+	if( m<=D_GEMM_SMALL_MN & n<=D_GEMM_SMALL_MN & k<=K_MAX_STACK )
 		{
 		goto tt_m1; // small matrix: pack A
 		}
@@ -5067,6 +5103,9 @@ void blasfeo_hp_dgemm_tt(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 tt_m1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_M1);
+	BLASFEO_PROFILE_PACKED((long long) m*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto tt_2;
 
@@ -5123,6 +5162,9 @@ tt_m1:
 
 tt_n1:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_N1);
+	BLASFEO_PROFILE_PACKED((long long) n*k*sizeof(double));
+
 //	if(K_MAX_STACK<=0)
 //		goto tt_2;
 
@@ -5179,6 +5221,10 @@ tt_n1:
 
 tt_2:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_2);
+	// B is packed once per block of MC rows of A
+	BLASFEO_PROFILE_PACKED((long long) (m + n*((m+MC-1)/MC))*k*sizeof(double));
+
 //#if 0
 #if defined(TARGET_X64_INTEL_SKYLAKE_X) | defined(TARGET_X64_INTEL_HASWELL) | defined(TARGET_X64_INTEL_SANDY_BRIDGE) | defined(TARGET_ARMV8A_ARM_CORTEX_A57) | defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 
@@ -5318,7 +5364,7 @@ tt_2:
 	tB_size = blasfeo_pm_memsize_dmat(ps, n1, k1);
 //	mem = malloc(tA_size+tB_size+64);
 //	blasfeo_align_64_byte(mem, (void **) &mem_align);
-	mem = malloc(tA_size+tB_size+4096);
+	blasfeo_malloc(&mem, tA_size+tB_size+4096);
 	blasfeo_align_4096_byte(mem, (void **) &mem_align);
 	blasfeo_pm_create_dmat(ps, m_kernel, k, &tA, (void *) mem_align);
 	blasfeo_pm_create_dmat(ps, n, k, &tB, (void *) (mem_align+tA_size));
@@ -5437,7 +5483,7 @@ tt_2_left_4:
 	goto tt_2_return;
 
 tt_2_return:
-	free(mem);
+	blasfeo_free(mem);
 	return;
 
 #endif
@@ -5446,6 +5492,8 @@ tt_2_return:
 
 tt_0:
 
+	BLASFEO_PROFILE_ALG(BLASFEO_PROFILE_ALG_0);
+
 	jj = 0;
 #if defined(TARGET_X64_INTEL_HASWELL)
 	for(; jj<n-11; jj+=12)
@@ -5585,28 +5633,48 @@ tt_0_return:
 
 void blasfeo_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NN, m, n, k);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dgemm('n', 'n', m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dgemm_nn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NT, m, n, k);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dgemm('n', 't', m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dgemm_nt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TN, m, n, k);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dgemm('t', 'n', m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dgemm_tn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TT, m, n, k);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dgemm('t', 't', m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dgemm_tt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -45,6 +45,7 @@
 #include <blasfeo_memory.h>
 
 #include <blasfeo_timing.h>
+#include <blasfeo_profile.h>
 
 
 
@@ -170,7 +171,9 @@ void blasfeo_hp_dgemv_t(int m, int n, double alpha, struct blasfeo_dmat *sA, int
 void blasfeo_dgemv_n(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_N, m, n, 0);
 	blasfeo_hp_dgemv_n(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -178,7 +181,9 @@ void blasfeo_dgemv_n(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai
 void blasfeo_dgemv_t(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_T, m, n, 0);
 	blasfeo_hp_dgemv_t(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
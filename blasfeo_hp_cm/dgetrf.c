@@ -44,6 +44,7 @@
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
 
 
 
@@ -1681,7 +1682,9 @@ end_1:
 
 void blasfeo_dgetrf_rp(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGETRF_RP, m, n, 0);
 	blasfeo_hp_dgetrf_rp(m, n, sC, ci, cj, sD, di, dj, ipiv);
+	BLASFEO_PROFILE_END();
 	}
 
 
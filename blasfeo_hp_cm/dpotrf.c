@@ -65,6 +65,8 @@
 #define blasfeo_hp_dsyrk3_ln blasfeo_hp_cm_dsyrk3_ln
 #endif
 #include <blasfeo_d_blasfeo_hp_api.h>
+#include <blasfeo_profile.h>
+#include <blasfeo_hybrid.h>
 
 
 
@@ -1841,7 +1843,12 @@ l_1:
 
 void blasfeo_dpotrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DPOTRF_L, m, m, 0);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dpotrf_l(m, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dpotrf_l(m, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -47,6 +47,8 @@
 #include <blasfeo_memory.h>
 
 #include <blasfeo_timing.h>
+#include <blasfeo_profile.h>
+#include <blasfeo_hybrid.h>
 
 
 
@@ -2235,7 +2237,7 @@ void blasfeo_hp_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, in
 	int ldc = sC->m;
 	int ldd = sD->m;
 	double *A = sA->pA + ai + aj*lda;
-	double *B = sB->pA + bi + bj*lda;
+	double *B = sB->pA + bi + bj*ldb;
 	double *C = sC->pA + ci + cj*ldc;
 	double *D = sD->pA + di + dj*ldd;
 
@@ -2590,7 +2592,7 @@ void blasfeo_hp_dsyrk_ln_mn(int m, int n, int k, double alpha, struct blasfeo_dm
 	int ldc = sC->m;
 	int ldd = sD->m;
 	double *A = sA->pA + ai + aj*lda;
-	double *B = sB->pA + bi + bj*lda;
+	double *B = sB->pA + bi + bj*ldb;
 	double *C = sC->pA + ci + cj*ldc;
 	double *D = sD->pA + di + dj*ldd;
 
@@ -3397,7 +3399,12 @@ void blasfeo_dsyrk3_ut(int m, int k, double alpha, struct blasfeo_dmat *sA, int
 
 void blasfeo_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DSYRK_LN, m, m, k);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dsyrk_ln(m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj))
+#endif
 	blasfeo_hp_dsyrk_ln(m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
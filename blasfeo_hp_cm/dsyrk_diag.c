@@ -0,0 +1,191 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo_target.h>
+#include <blasfeo_block_size.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_dmat blasfeo_cm_dmat
+#define blasfeo_dvec blasfeo_cm_dvec
+#define blasfeo_hp_dsyrk_diag_ln blasfeo_hp_cm_dsyrk_diag_ln
+#define blasfeo_hp_dsyrk_diag_dpotrf_ln blasfeo_hp_cm_dsyrk_diag_dpotrf_ln
+#define blasfeo_dsyrk_diag_ln blasfeo_cm_dsyrk_diag_ln
+#define blasfeo_dsyrk_diag_dpotrf_ln blasfeo_cm_dsyrk_diag_dpotrf_ln
+#endif
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_hp_dgemm_nt blasfeo_hp_cm_dgemm_nt
+#define blasfeo_hp_dsyrk_ln blasfeo_hp_cm_dsyrk_ln
+#define blasfeo_hp_dtrsm_rltn blasfeo_hp_cm_dtrsm_rltn
+#define blasfeo_hp_dpotrf_l blasfeo_hp_cm_dpotrf_l
+#endif
+#include <blasfeo_d_blasfeo_hp_api.h>
+
+
+
+// rows and columns of the blocks of A scaled by diag(x) in dsyrk_diag
+#define SYRK_DIAG_MB 16
+#define SYRK_DIAG_KB D_KC
+
+
+
+// D(ii:i1,0:i1) <= beta * C(ii:i1,0:i1) + alpha * A(ii:i1,:) * diag(x) * B(0:i1,:)^T, lower triangular in D(ii:i1,ii:i1)
+// the block of rows of A is scaled SYRK_DIAG_KB columns at a time into the stack buffer pW, used at once by gemm and syrk
+static void dsyrk_diag_ln_rows(int ii, int i1, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, double *pW)
+	{
+	int lda = sA->m;
+	double *pA = sA->pA + ai + ii + aj*lda;
+	double *x = sx->pa + xi;
+	int mb = i1-ii;
+
+	struct blasfeo_dmat sW;
+	sW.pA = pW;
+	sW.m = mb;
+	sW.use_dA = 0;
+
+	int iii, jj, kk, kb;
+	double x_jj;
+	kk = 0;
+	do
+		{
+		kb = k-kk<SYRK_DIAG_KB ? k-kk : SYRK_DIAG_KB;
+		sW.n = kb;
+		for(jj=0; jj<kb; jj++)
+			{
+			x_jj = x[kk+jj];
+			for(iii=0; iii<mb; iii++)
+				pW[iii+mb*jj] = pA[iii+lda*(kk+jj)] * x_jj;
+			}
+		if(kk==0)
+			{
+			blasfeo_hp_dgemm_nt(mb, ii, kb, alpha, &sW, 0, 0, sB, bi, bj, beta, sC, ci+ii, cj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(mb, kb, alpha, &sW, 0, 0, sB, bi+ii, bj, beta, sC, ci+ii, cj+ii, sD, di+ii, dj+ii);
+			}
+		else
+			{
+			blasfeo_hp_dgemm_nt(mb, ii, kb, alpha, &sW, 0, 0, sB, bi, bj+kk, 1.0, sD, di+ii, dj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(mb, kb, alpha, &sW, 0, 0, sB, bi+ii, bj+kk, 1.0, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+			}
+		kk += kb;
+		}
+	while(kk<k);
+	return;
+	}
+
+
+
+// dsyrk with diagonal scaling: D <= beta * C + alpha * A * diag(x) * B^T ; C, D lower triangular
+void blasfeo_hp_dsyrk_diag_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+#if defined(TARGET_GENERIC)
+	double pW[SYRK_DIAG_MB*SYRK_DIAG_KB];
+#else
+	ALIGNED( double pW[SYRK_DIAG_MB*SYRK_DIAG_KB], 64 );
+#endif
+	int ii, i1;
+
+	for(ii=0; ii<m; ii=i1)
+		{
+		i1 = m-ii<SYRK_DIAG_MB ? m : ii+SYRK_DIAG_MB;
+		dsyrk_diag_ln_rows(ii, i1, k, alpha, sA, ai, aj, sx, xi, sB, bi, bj, beta, sC, ci, cj, sD, di, dj, pW);
+		}
+
+	return;
+	}
+
+
+
+// D <= chol( C + A * diag(x) * B^T ) ; C, D lower triangular
+// row block by row block: each row block of C + A * diag(x) * B^T is factorized against the previous ones while in cache
+void blasfeo_hp_dsyrk_diag_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+#if defined(TARGET_GENERIC)
+	double pW[SYRK_DIAG_MB*SYRK_DIAG_KB];
+#else
+	ALIGNED( double pW[SYRK_DIAG_MB*SYRK_DIAG_KB], 64 );
+#endif
+	int ii, i1;
+
+	for(ii=0; ii<m; ii=i1)
+		{
+		i1 = m-ii<SYRK_DIAG_MB ? m : ii+SYRK_DIAG_MB;
+		dsyrk_diag_ln_rows(ii, i1, k, 1.0, sA, ai, aj, sx, xi, sB, bi, bj, 1.0, sC, ci, cj, sD, di, dj, pW);
+		if(ii>0)
+			{
+			blasfeo_hp_dtrsm_rltn(i1-ii, ii, 1.0, sD, di, dj, sD, di+ii, dj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(i1-ii, ii, -1.0, sD, di+ii, dj, sD, di+ii, dj, 1.0, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+			}
+		blasfeo_hp_dpotrf_l(i1-ii, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+		}
+
+	return;
+	}
+
+
+
+#if defined(LA_HIGH_PERFORMANCE)
+
+
+
+void blasfeo_dsyrk_diag_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsyrk_diag_ln(m, k, alpha, sA, ai, aj, sx, xi, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dsyrk_diag_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsyrk_diag_dpotrf_ln(m, k, sA, ai, aj, sx, xi, sB, bi, bj, sC, ci, cj, sD, di, dj);
+	}
+
+
+
+#endif
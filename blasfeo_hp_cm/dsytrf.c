@@ -0,0 +1,452 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_stdlib.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_dmat blasfeo_cm_dmat
+#define blasfeo_hp_dsytrf_l blasfeo_hp_cm_dsytrf_l
+#define blasfeo_hp_dsytrs_l blasfeo_hp_cm_dsytrs_l
+#define blasfeo_dsytrf_l blasfeo_cm_dsytrf_l
+#define blasfeo_dsytrs_l blasfeo_cm_dsytrs_l
+#endif
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_hp_dgemm_nn blasfeo_hp_cm_dgemm_nn
+#define blasfeo_hp_dgemm_nt blasfeo_hp_cm_dgemm_nt
+#define blasfeo_hp_dgemm_tn blasfeo_hp_cm_dgemm_tn
+#define blasfeo_hp_dsyrk_ln blasfeo_hp_cm_dsyrk_ln
+#endif
+#include <blasfeo_d_blasfeo_hp_api.h>
+
+
+
+// element access for the Bunch-Kaufman routines, relative to the submatrices
+#define DSYTRF_EL_A(i, j) pA[(i)+lda*(j)]
+#define DSYTRF_EL_D(i, j) pD[(i)+ldd*(j)]
+#define DSYTRF_EL_W(i, j) pW[(i)+ldw*(j)]
+
+
+
+// interchange the rows i and j of the (.)x(n) matrix D
+static void dsytrf_rowsw_cm(int n, double *pD, int ldd, int i, int j)
+	{
+	int jj;
+	double tmp;
+	for(jj=0; jj<n; jj++)
+		{
+		tmp = pD[i+ldd*jj];
+		pD[i+ldd*jj] = pD[j+ldd*jj];
+		pD[j+ldd*jj] = tmp;
+		}
+	return;
+	}
+
+
+
+// Bunch-Kaufman factorization of at most nb-1 leading columns of the lower triangle of the
+// (m)x(m) matrix at (di,dj), followed by the update of the trailing lower triangle;
+// W is a (m)x(nb) work matrix and the number of factorized columns is returned
+static int dsytrf_l_panel_cm(int m, int nb, struct blasfeo_dmat *sD, int di, int dj, int *ipiv, struct blasfeo_dmat *sW)
+	{
+
+	const double alpha = (1.0+sqrt(17.0))/8.0;
+
+	int ii, jj, j0, jp, k, kk, kp, kstep;
+	double absakk, colmax, rowmax, tmp, d11, d21, d22, t;
+
+	int ldd = sD->m;
+	int ldw = sW->m;
+	double *pD = sD->pA + di + dj*ldd;
+	double *pW = sW->pA;
+
+	k = 0;
+	while(k<m & (k<nb-1 | nb>=m))
+		{
+		// W(k:m,k) <= A(k:m,k) - A(k:m,0:k) * W(k,0:k)^T
+		for(ii=k; ii<m; ii++)
+			DSYTRF_EL_W(ii, k) = DSYTRF_EL_D(ii, k);
+		if(k>0)
+			blasfeo_hp_dgemm_nt(m-k, 1, k, -1.0, sD, di+k, dj, sW, k, 0, 1.0, sW, k, k, sW, k, k);
+		kstep = 1;
+		absakk = fabs(DSYTRF_EL_W(k, k));
+		kp = k;
+		colmax = 0.0;
+		for(ii=k+1; ii<m; ii++)
+			{
+			tmp = fabs(DSYTRF_EL_W(ii, k));
+			if(tmp>colmax)
+				{
+				colmax = tmp;
+				kp = ii;
+				}
+			}
+		if(absakk==0.0 & colmax==0.0)
+			{
+			// zero column: singular matrix, the column is left as it is
+			kp = k;
+			for(ii=k; ii<m; ii++)
+				DSYTRF_EL_D(ii, k) = DSYTRF_EL_W(ii, k);
+			}
+		else
+			{
+			if(absakk>=alpha*colmax)
+				{
+				// no interchange, 1x1 pivot block
+				kp = k;
+				}
+			else
+				{
+				// W(k:m,k+1) <= A(k:m,kp) - A(k:m,0:k) * W(kp,0:k)^T, the column kp is read from the lower triangle
+				for(ii=k; ii<kp; ii++)
+					DSYTRF_EL_W(ii, k+1) = DSYTRF_EL_D(kp, ii);
+				for(ii=kp; ii<m; ii++)
+					DSYTRF_EL_W(ii, k+1) = DSYTRF_EL_D(ii, kp);
+				if(k>0)
+					blasfeo_hp_dgemm_nt(m-k, 1, k, -1.0, sD, di+k, dj, sW, kp, 0, 1.0, sW, k, k+1, sW, k, k+1);
+				rowmax = 0.0;
+				for(ii=k; ii<m; ii++)
+					{
+					tmp = fabs(DSYTRF_EL_W(ii, k+1));
+					if(ii!=kp & tmp>rowmax)
+						rowmax = tmp;
+					}
+				if(absakk>=alpha*colmax*(colmax/rowmax))
+					{
+					// no interchange, 1x1 pivot block
+					kp = k;
+					}
+				else if(fabs(DSYTRF_EL_W(kp, k+1))>=alpha*rowmax)
+					{
+					// interchange rows and columns k and kp, 1x1 pivot block
+					for(ii=k; ii<m; ii++)
+						DSYTRF_EL_W(ii, k) = DSYTRF_EL_W(ii, k+1);
+					}
+				else
+					{
+					// interchange rows and columns k+1 and kp, 2x2 pivot block
+					kstep = 2;
+					}
+				}
+			kk = k+kstep-1;
+			if(kp!=kk)
+				{
+				// copy the non-updated column kk to column kp
+				DSYTRF_EL_D(kp, kp) = DSYTRF_EL_D(kk, kk);
+				for(ii=kk+1; ii<kp; ii++)
+					DSYTRF_EL_D(kp, ii) = DSYTRF_EL_D(ii, kk);
+				for(ii=kp+1; ii<m; ii++)
+					DSYTRF_EL_D(ii, kp) = DSYTRF_EL_D(ii, kk);
+				// interchange rows kk and kp in the first k columns of A and the first kk+1 columns of W
+				for(jj=0; jj<k; jj++)
+					{
+					tmp = DSYTRF_EL_D(kk, jj);
+					DSYTRF_EL_D(kk, jj) = DSYTRF_EL_D(kp, jj);
+					DSYTRF_EL_D(kp, jj) = tmp;
+					}
+				for(jj=0; jj<=kk; jj++)
+					{
+					tmp = DSYTRF_EL_W(kk, jj);
+					DSYTRF_EL_W(kk, jj) = DSYTRF_EL_W(kp, jj);
+					DSYTRF_EL_W(kp, jj) = tmp;
+					}
+				}
+			if(kstep==1)
+				{
+				// store the column k of W in A, and scale it to get the column k of L
+				for(ii=k; ii<m; ii++)
+					DSYTRF_EL_D(ii, k) = DSYTRF_EL_W(ii, k);
+				if(k<m-1)
+					{
+					tmp = 1.0/DSYTRF_EL_D(k, k);
+					for(ii=k+1; ii<m; ii++)
+						DSYTRF_EL_D(ii, k) *= tmp;
+					}
+				}
+			else
+				{
+				// store the columns k and k+1 of L, computed as W * inv(D_k)
+				if(k<m-2)
+					{
+					d21 = DSYTRF_EL_W(k+1, k);
+					d11 = DSYTRF_EL_W(k+1, k+1) / d21;
+					d22 = DSYTRF_EL_W(k, k) / d21;
+					t = 1.0 / (d11*d22 - 1.0);
+					d21 = t / d21;
+					for(ii=k+2; ii<m; ii++)
+						{
+						DSYTRF_EL_D(ii, k) = d21 * (d11*DSYTRF_EL_W(ii, k) - DSYTRF_EL_W(ii, k+1));
+						DSYTRF_EL_D(ii, k+1) = d21 * (d22*DSYTRF_EL_W(ii, k+1) - DSYTRF_EL_W(ii, k));
+						}
+					}
+				DSYTRF_EL_D(k, k) = DSYTRF_EL_W(k, k);
+				DSYTRF_EL_D(k+1, k) = DSYTRF_EL_W(k+1, k);
+				DSYTRF_EL_D(k+1, k+1) = DSYTRF_EL_W(k+1, k+1);
+				}
+			}
+		// 0-based pivot indices, negative for 2x2 pivot blocks
+		if(kstep==1)
+			{
+			ipiv[k] = kp;
+			}
+		else
+			{
+			ipiv[k] = -kp-1;
+			ipiv[k+1] = -kp-1;
+			}
+		k += kstep;
+		}
+
+	// A(k:m,k:m) <= A(k:m,k:m) - L(k:m,0:k) * W(k:m,0:k)^T, lower triangle
+	if(k<m)
+		{
+		blasfeo_hp_dsyrk_ln(m-k, k, -1.0, sD, di+k, dj, sW, k, 0, 1.0, sD, di+k, dj+k, sD, di+k, dj+k);
+		}
+
+	// put the columns 0:k of L in standard form, by partially undoing the interchanges
+	jj = k-1;
+	while(jj>=0)
+		{
+		j0 = jj;
+		jp = ipiv[jj];
+		if(jp<0)
+			{
+			jp = -jp-1;
+			jj--;
+			}
+		jj--;
+		if(jp!=j0 & jj>=0)
+			{
+			for(ii=0; ii<=jj; ii++)
+				{
+				tmp = DSYTRF_EL_D(jp, ii);
+				DSYTRF_EL_D(jp, ii) = DSYTRF_EL_D(j0, ii);
+				DSYTRF_EL_D(j0, ii) = tmp;
+				}
+			}
+		}
+
+	return k;
+
+	}
+
+
+
+// D <= ldl( C ), with Bunch-Kaufman pivoting; C, D lower triangular
+void blasfeo_hp_dsytrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, k, kb;
+
+	int ldc = sC->m;
+	int ldd = sD->m;
+	double *pC = sC->pA + ci + cj*ldc;
+	double *pD = sD->pA + di + dj*ldd;
+
+	if(pC!=pD)
+		{
+		for(jj=0; jj<m; jj++)
+			{
+			for(ii=jj; ii<m; ii++)
+				{
+				pD[ii+ldd*jj] = pC[ii+ldc*jj];
+				}
+			}
+		}
+
+	// panel width
+	const int nb = 32;
+
+	struct blasfeo_dmat sW;
+	void *mem;
+	blasfeo_malloc_align(&mem, m*nb*sizeof(double));
+	sW.pA = (double *) mem;
+	sW.m = m;
+	sW.n = nb;
+	sW.use_dA = 0;
+
+	for(k=0; k<m; k+=kb)
+		{
+		kb = dsytrf_l_panel_cm(m-k, nb, sD, di+k, dj+k, ipiv+k, &sW);
+		// pivot indices relative to the whole matrix
+		for(ii=k; ii<k+kb; ii++)
+			ipiv[ii] += ipiv[ii]>=0 ? k : -k;
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// D <= inv( A ) * B, with A factorized by dsytrf_l
+void blasfeo_hp_dsytrs_l(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0 | n<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, k, kp;
+	double tmp, akm1k, akm1, ak, denom, bkm1, bk;
+
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pB = sB->pA + bi + bj*ldb;
+	double *pD = sD->pA + di + dj*ldd;
+
+	if(pB!=pD)
+		{
+		for(jj=0; jj<n; jj++)
+			{
+			for(ii=0; ii<m; ii++)
+				{
+				pD[ii+ldd*jj] = pB[ii+ldb*jj];
+				}
+			}
+		}
+
+	// solve L * D * X = B
+	k = 0;
+	while(k<m)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			kp = ipiv[k];
+			if(kp!=k)
+				dsytrf_rowsw_cm(n, pD, ldd, k, kp);
+			if(k<m-1)
+				blasfeo_hp_dgemm_nn(m-k-1, n, 1, -1.0, sA, ai+k+1, aj+k, sD, di+k, dj, 1.0, sD, di+k+1, dj, sD, di+k+1, dj);
+			tmp = 1.0/DSYTRF_EL_A(k, k);
+			for(jj=0; jj<n; jj++)
+				DSYTRF_EL_D(k, jj) *= tmp;
+			k += 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			kp = -ipiv[k]-1;
+			if(kp!=k+1)
+				dsytrf_rowsw_cm(n, pD, ldd, k+1, kp);
+			if(k<m-2)
+				blasfeo_hp_dgemm_nn(m-k-2, n, 2, -1.0, sA, ai+k+2, aj+k, sD, di+k, dj, 1.0, sD, di+k+2, dj, sD, di+k+2, dj);
+			akm1k = DSYTRF_EL_A(k+1, k);
+			akm1 = DSYTRF_EL_A(k, k) / akm1k;
+			ak = DSYTRF_EL_A(k+1, k+1) / akm1k;
+			denom = akm1*ak - 1.0;
+			for(jj=0; jj<n; jj++)
+				{
+				bkm1 = DSYTRF_EL_D(k, jj) / akm1k;
+				bk = DSYTRF_EL_D(k+1, jj) / akm1k;
+				DSYTRF_EL_D(k, jj) = (ak*bkm1 - bk) / denom;
+				DSYTRF_EL_D(k+1, jj) = (akm1*bk - bkm1) / denom;
+				}
+			k += 2;
+			}
+		}
+
+	// solve L^T * X = B
+	k = m-1;
+	while(k>=0)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			if(k<m-1)
+				blasfeo_hp_dgemm_tn(1, n, m-k-1, -1.0, sA, ai+k+1, aj+k, sD, di+k+1, dj, 1.0, sD, di+k, dj, sD, di+k, dj);
+			kp = ipiv[k];
+			if(kp!=k)
+				dsytrf_rowsw_cm(n, pD, ldd, k, kp);
+			k -= 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			if(k<m-1)
+				blasfeo_hp_dgemm_tn(2, n, m-k-1, -1.0, sA, ai+k+1, aj+k-1, sD, di+k+1, dj, 1.0, sD, di+k-1, dj, sD, di+k-1, dj);
+			kp = -ipiv[k]-1;
+			if(kp!=k)
+				dsytrf_rowsw_cm(n, pD, ldd, k, kp);
+			k -= 2;
+			}
+		}
+
+	return;
+
+	}
+
+#if defined(LA_HIGH_PERFORMANCE)
+
+
+
+void blasfeo_dsytrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
+	{
+	blasfeo_hp_dsytrf_l(m, sC, ci, cj, sD, di, dj, ipiv);
+	}
+
+
+
+void blasfeo_dsytrs_l(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsytrs_l(m, n, sA, ai, aj, ipiv, sB, bi, bj, sD, di, dj);
+	}
+
+
+
+#endif
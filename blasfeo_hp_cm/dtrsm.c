@@ -90,6 +90,8 @@
 #define blasfeo_hp_dgemm_tn blasfeo_hp_cm_dgemm_tn
 #endif
 #include <blasfeo_d_blasfeo_hp_api.h>
+#include <blasfeo_profile.h>
+#include <blasfeo_hybrid.h>
 
 
 
@@ -7403,7 +7405,12 @@ void blasfeo_dtrsm_rlnu(int m, int n, double alpha, struct blasfeo_dmat *sA, int
 
 void blasfeo_dtrsm_rltn(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DTRSM_RLTN, m, n, 0);
+#if defined(HYBRID_EXTERNAL_BLAS)
+	if(!blasfeo_hybrid_dtrsm_rltn(m, n, alpha, sA, ai, aj, sB, bi, bj, sD, di, dj))
+#endif
 	blasfeo_hp_dtrsm_rltn(m, n, alpha, sA, ai, aj, sB, bi, bj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	return;
 	}
 
@@ -0,0 +1,388 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS for embedded optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_stdlib.h>
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_dmat blasfeo_cm_dmat
+#define blasfeo_hp_dtrtri_l blasfeo_hp_cm_dtrtri_l
+#define blasfeo_hp_dtrtri_u blasfeo_hp_cm_dtrtri_u
+#define blasfeo_hp_dpotri_l blasfeo_hp_cm_dpotri_l
+#define blasfeo_hp_dgetri blasfeo_hp_cm_dgetri
+#define blasfeo_dtrtri_l blasfeo_cm_dtrtri_l
+#define blasfeo_dtrtri_u blasfeo_cm_dtrtri_u
+#define blasfeo_dpotri_l blasfeo_cm_dpotri_l
+#define blasfeo_dgetri blasfeo_cm_dgetri
+#endif
+
+
+
+#if ( defined(BLAS_API) & defined(MF_PANELMAJ) )
+#define blasfeo_hp_dgemm_nn blasfeo_hp_cm_dgemm_nn
+#define blasfeo_hp_dsyrk_ln blasfeo_hp_cm_dsyrk_ln
+#define blasfeo_hp_dtrmm_rlnn blasfeo_hp_cm_dtrmm_rlnn
+#endif
+#include <blasfeo_d_blasfeo_hp_api.h>
+
+
+
+// T <= inv( L ), L the m x m lower triangular matrix in D (with unit diagonal if unit!=0), T dense with zero upper part
+static void dtrinv_l_cm(int m, int unit, double *pD, int ldd, double *pT, int ldt)
+	{
+	int ii, jj, ll;
+	double tmp, d_jj;
+	for(jj=0; jj<m; jj++)
+		for(ii=0; ii<jj; ii++)
+			pT[ii+ldt*jj] = 0.0;
+	for(jj=m-1; jj>=0; jj--)
+		{
+		d_jj = unit ? 1.0 : 1.0/pD[jj+ldd*jj];
+		pT[jj+ldt*jj] = d_jj;
+		for(ii=m-1; ii>jj; ii--)
+			{
+			tmp = 0.0;
+			for(ll=jj+1; ll<=ii; ll++)
+				tmp += pT[ii+ldt*ll] * pD[ll+ldd*jj];
+			pT[ii+ldt*jj] = - tmp * d_jj;
+			}
+		}
+	return;
+	}
+
+
+
+// inverse of a lower triangular matrix, blocked by rows
+void blasfeo_hp_dtrtri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, j, jb;
+
+	int lda = sA->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pD = sD->pA + di + dj*ldd;
+
+	if(pA!=pD)
+		{
+		for(jj=0; jj<m; jj++)
+			for(ii=jj; ii<m; ii++)
+				pD[ii+ldd*jj] = pA[ii+lda*jj];
+		}
+
+	const int nb = 32;
+
+	struct blasfeo_dmat sW, sT;
+	void *mem;
+	blasfeo_malloc_align(&mem, (nb*m+nb*nb)*sizeof(double));
+	sW.pA = (double *) mem;
+	sW.m = nb;
+	sW.n = m;
+	sW.use_dA = 0;
+	sT.pA = sW.pA + nb*m;
+	sT.m = nb;
+	sT.n = nb;
+	sT.use_dA = 0;
+
+	for(j=0; j<m; j+=nb)
+		{
+		jb = m-j<nb ? m-j : nb;
+		// D(j:j+jb,j:j+jb) <= inv( A(j:j+jb,j:j+jb) )
+		dtrinv_l_cm(jb, 0, pD+j+ldd*j, ldd, sT.pA, nb);
+		for(jj=0; jj<jb; jj++)
+			for(ii=jj; ii<jb; ii++)
+				pD[j+ii+ldd*(j+jj)] = sT.pA[ii+nb*jj];
+		if(j>0)
+			{
+			// W <= A(j:j+jb,0:j) * inv( A(0:j,0:j) )
+			blasfeo_hp_dtrmm_rlnn(jb, j, 1.0, sD, di, dj, sD, di+j, dj, &sW, 0, 0);
+			// D(j:j+jb,0:j) <= - inv( A(j:j+jb,j:j+jb) ) * W
+			blasfeo_hp_dgemm_nn(jb, j, jb, -1.0, &sT, 0, 0, &sW, 0, 0, 0.0, sD, di+j, dj, sD, di+j, dj);
+			}
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of an upper triangular matrix, as the transpose of the inverse of its lower triangular transpose
+void blasfeo_hp_dtrtri_u(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj;
+
+	int lda = sA->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pD = sD->pA + di + dj*ldd;
+
+	struct blasfeo_dmat sL;
+	void *mem;
+	blasfeo_malloc_align(&mem, m*m*sizeof(double));
+	sL.pA = (double *) mem;
+	sL.m = m;
+	sL.n = m;
+	sL.use_dA = 0;
+
+	for(jj=0; jj<m; jj++)
+		for(ii=0; ii<=jj; ii++)
+			sL.pA[jj+m*ii] = pA[ii+lda*jj];
+	blasfeo_hp_dtrtri_l(m, &sL, 0, 0, &sL, 0, 0);
+	// the strictly lower part of D is not accessed
+	for(jj=0; jj<m; jj++)
+		for(ii=0; ii<=jj; ii++)
+			pD[ii+ldd*jj] = sL.pA[jj+m*ii];
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of a SPD matrix from its lower Cholesky factor, as inv( A )^T * inv( A ) by block rows
+void blasfeo_hp_dpotri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// D <= X = inv( A )
+	blasfeo_hp_dtrtri_l(m, sA, ai, aj, sD, di, dj);
+
+	int ii, jj, i, ib;
+
+	int ldd = sD->m;
+	double *pD = sD->pA + di + dj*ldd;
+
+	const int nb = 32;
+
+	struct blasfeo_dmat sWt, sZ;
+	void *mem;
+	blasfeo_malloc_align(&mem, 2*nb*m*sizeof(double));
+	sWt.pA = (double *) mem;
+	sWt.m = nb;
+	sWt.n = m;
+	sWt.use_dA = 0;
+	sZ.pA = sWt.pA + nb*m;
+	sZ.m = nb;
+	sZ.n = m;
+	sZ.use_dA = 0;
+
+	for(i=0; i<m; i+=nb)
+		{
+		ib = m-i<nb ? m-i : nb;
+		// Wt <= X(i:m,i:i+ib)^T, with zero strictly lower part of the diagonal block
+		for(jj=0; jj<m-i; jj++)
+			for(ii=0; ii<ib; ii++)
+				sWt.pA[ii+nb*jj] = jj<ii ? 0.0 : pD[i+jj+ldd*(i+ii)];
+		if(i>0)
+			{
+			// D(i:i+ib,0:i) <= Wt * X(i:m,0:i)
+			blasfeo_hp_dgemm_nn(ib, i, m-i, 1.0, &sWt, 0, 0, sD, di+i, dj, 0.0, sD, di+i, dj, &sZ, 0, 0);
+			for(jj=0; jj<i; jj++)
+				for(ii=0; ii<ib; ii++)
+					pD[i+ii+ldd*jj] = sZ.pA[ii+nb*jj];
+			}
+		// D(i:i+ib,i:i+ib) <= Wt * Wt^T
+		blasfeo_hp_dsyrk_ln(ib, m-i, 1.0, &sWt, 0, 0, &sWt, 0, 0, 0.0, sD, di+i, dj+i, sD, di+i, dj+i);
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of a general matrix from its LU factorization with row pivoting, solving inv( A ) * L = inv( U ) by block columns
+void blasfeo_hp_dgetri(int m, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, j, jb;
+	double tmp;
+
+	int lda = sA->m;
+	int ldd = sD->m;
+	double *pA = sA->pA + ai + aj*lda;
+	double *pD = sD->pA + di + dj*ldd;
+
+	if(pA!=pD)
+		{
+		for(jj=0; jj<m; jj++)
+			for(ii=0; ii<m; ii++)
+				pD[ii+ldd*jj] = pA[ii+lda*jj];
+		}
+
+	// D upper <= inv( U )
+	blasfeo_hp_dtrtri_u(m, sD, di, dj, sD, di, dj);
+
+	const int nb = 32;
+
+	struct blasfeo_dmat sW, sZ, sT;
+	void *mem;
+	blasfeo_malloc_align(&mem, (2*m*nb+nb*nb)*sizeof(double));
+	sW.pA = (double *) mem;
+	sW.m = m;
+	sW.n = nb;
+	sW.use_dA = 0;
+	sZ.pA = sW.pA + m*nb;
+	sZ.m = m;
+	sZ.n = nb;
+	sZ.use_dA = 0;
+	sT.pA = sZ.pA + m*nb;
+	sT.m = nb;
+	sT.n = nb;
+	sT.use_dA = 0;
+
+	for(j=(m-1)/nb*nb; j>=0; j-=nb)
+		{
+		jb = m-j<nb ? m-j : nb;
+		// T <= inv( L(j:j+jb,j:j+jb) )
+		dtrinv_l_cm(jb, 1, pD+j+ldd*j, ldd, sT.pA, nb);
+		// W <= L(j+jb:m,j:j+jb), then zero the strictly lower part of D(:,j:j+jb)
+		for(jj=0; jj<jb; jj++)
+			{
+			for(ii=jj+1; ii<jb; ii++)
+				pD[j+ii+ldd*(j+jj)] = 0.0;
+			for(ii=j+jb; ii<m; ii++)
+				{
+				sW.pA[ii-j-jb+m*jj] = pD[ii+ldd*(j+jj)];
+				pD[ii+ldd*(j+jj)] = 0.0;
+				}
+			}
+		if(j+jb<m)
+			{
+			// Z <= D(:,j:j+jb) - D(:,j+jb:m) * W
+			blasfeo_hp_dgemm_nn(m, jb, m-j-jb, -1.0, sD, di, dj+j+jb, &sW, 0, 0, 1.0, sD, di, dj+j, &sZ, 0, 0);
+			}
+		else
+			{
+			for(jj=0; jj<jb; jj++)
+				for(ii=0; ii<m; ii++)
+					sZ.pA[ii+m*jj] = pD[ii+ldd*(j+jj)];
+			}
+		// D(:,j:j+jb) <= Z * T
+		blasfeo_hp_dgemm_nn(m, jb, jb, 1.0, &sZ, 0, 0, &sT, 0, 0, 0.0, sD, di, dj+j, sD, di, dj+j);
+		}
+
+	blasfeo_free_align(mem);
+
+	// apply the column interchanges in reverse order
+	for(j=m-2; j>=0; j--)
+		{
+		if(ipiv[j]!=j)
+			{
+			for(ii=0; ii<m; ii++)
+				{
+				tmp = pD[ii+ldd*j];
+				pD[ii+ldd*j] = pD[ii+ldd*ipiv[j]];
+				pD[ii+ldd*ipiv[j]] = tmp;
+				}
+			}
+		}
+
+	return;
+
+	}
+
+
+
+#if defined(LA_HIGH_PERFORMANCE)
+
+
+
+void blasfeo_dtrtri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dtrtri_l(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dtrtri_u(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dtrtri_u(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dpotri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dpotri_l(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dgetri(int m, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dgetri(m, sA, ai, aj, ipiv, sD, di, dj);
+	}
+
+
+
+#endif
+
+
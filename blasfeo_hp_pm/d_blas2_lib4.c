@@ -43,6 +43,8 @@
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
+#include <blasfeo_graph.h>
 
 
 
@@ -1837,20 +1839,330 @@ void blasfeo_hp_dger(int m, int n, double alpha, struct blasfeo_dvec *sx, int xi
 
 
 
+// multiple right-hand sides: sx, sy and sz are arrays of k vectors, processed in groups of 4 streaming A once per group
+void blasfeo_hp_dgemv_n_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+
+	if(m<=0 | k<=0)
+		return;
+
+	const int bs = 4;
+
+	int i, jj, ll, idx;
+
+	int sda = sA->cn;
+	double *pA = sA->pA + aj*bs + ai/bs*bs*sda;
+	int offA = ai%bs;
+
+	double *x[4], *y[4], *z[4];
+	double *yt[4], *zt[4];
+
+	for(jj=0; jj<k; jj+=4)
+		{
+		// the last group is padded by repeating its last vector
+		for(ll=0; ll<4; ll++)
+			{
+			idx = jj+ll<k ? jj+ll : k-1;
+			x[ll] = sx[idx].pa + xi;
+			y[ll] = sy[idx].pa + yi - offA;
+			z[ll] = sz[idx].pa + zi - offA;
+			}
+		i = 0;
+		// clean up at the beginning
+		if(offA!=0)
+			{
+			kernel_dgemv_n_4_k4_gen_lib4(n, &alpha, pA, x, &beta, y, z, offA, m+offA);
+			i += 4;
+			}
+		// main loop
+		for( ; i<m+offA-3; i+=4)
+			{
+			for(ll=0; ll<4; ll++)
+				{
+				yt[ll] = y[ll] + i;
+				zt[ll] = z[ll] + i;
+				}
+			kernel_dgemv_n_4_k4_lib4(n, &alpha, &pA[i*sda], x, &beta, yt, zt);
+			}
+		// clean up at the end
+		if(i<m+offA)
+			{
+			for(ll=0; ll<4; ll++)
+				{
+				yt[ll] = y[ll] + i;
+				zt[ll] = z[ll] + i;
+				}
+			kernel_dgemv_n_4_k4_gen_lib4(n, &alpha, &pA[i*sda], x, &beta, yt, zt, 0, m+offA-i);
+			}
+		}
+
+	return;
+
+	}
+
+
+
+void blasfeo_hp_dgemv_t_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+
+	if(n<=0 | k<=0)
+		return;
+
+	const int bs = 4;
+
+	int i, jj, ll, idx;
+
+	int sda = sA->cn;
+	double *pA = sA->pA + aj*bs + ai/bs*bs*sda + ai%bs;
+	int offsetA = ai%bs;
+
+	double *x[4], *y[4], *z[4];
+	double *yt[4], *zt[4];
+
+	for(jj=0; jj<k; jj+=4)
+		{
+		// the last group is padded by repeating its last vector
+		for(ll=0; ll<4; ll++)
+			{
+			idx = jj+ll<k ? jj+ll : k-1;
+			x[ll] = sx[idx].pa + xi;
+			y[ll] = sy[idx].pa + yi;
+			z[ll] = sz[idx].pa + zi;
+			}
+		i = 0;
+		for( ; i<n-3; i+=4)
+			{
+			for(ll=0; ll<4; ll++)
+				{
+				yt[ll] = y[ll] + i;
+				zt[ll] = z[ll] + i;
+				}
+			kernel_dgemv_t_4_k4_lib4(m, &alpha, offsetA, &pA[i*bs], sda, x, &beta, yt, zt);
+			}
+		if(i<n)
+			{
+			for(ll=0; ll<4; ll++)
+				{
+				yt[ll] = y[ll] + i;
+				zt[ll] = z[ll] + i;
+				}
+			kernel_dgemv_t_4_k4_vs_lib4(m, &alpha, offsetA, &pA[i*bs], sda, x, &beta, yt, zt, n-i);
+			}
+		}
+
+	return;
+
+	}
+
+
+
+void blasfeo_hp_dtrsv_lnn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	if(m==0 | k<=0)
+		return;
+#if defined(DIM_CHECK)
+	// non-negative size
+	if(m<0) printf("\n****** blasfeo_dtrsv_lnn_k : m<0 : %d<0 *****\n", m);
+	// non-negative offset
+	if(ai<0) printf("\n****** blasfeo_dtrsv_lnn_k : ai<0 : %d<0 *****\n", ai);
+	if(aj<0) printf("\n****** blasfeo_dtrsv_lnn_k : aj<0 : %d<0 *****\n", aj);
+	if(xi<0) printf("\n****** blasfeo_dtrsv_lnn_k : xi<0 : %d<0 *****\n", xi);
+	if(zi<0) printf("\n****** blasfeo_dtrsv_lnn_k : zi<0 : %d<0 *****\n", zi);
+	// inside matrix
+	// A: m x k
+	if(ai+m > sA->m) printf("\n***** blasfeo_dtrsv_lnn_k : ai+m > row(A) : %d+%d > %d *****\n", ai, m, sA->m);
+	if(aj+m > sA->n) printf("\n***** blasfeo_dtrsv_lnn_k : aj+m > col(A) : %d+%d > %d *****\n", aj, m, sA->n);
+#endif
+	if(ai!=0)
+		{
+#if defined(BLASFEO_REF_API)
+		blasfeo_ref_dtrsv_lnn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+		return;
+#else
+		printf("\nblasfeo_dtrsv_lnn_k: feature not implemented yet: ai=%d\n", ai);
+		exit(1);
+#endif
+		}
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + aj*bs; // TODO ai
+	double *inv_diag_A = sA->dA;
+	int ii, jj, ll, idx;
+	if(ai==0 & aj==0)
+		{
+		if(sA->use_dA!=1)
+			{
+			ddiaex_lib(m, 1.0, ai, pA, sda, inv_diag_A);
+			for(ii=0; ii<m; ii++)
+				inv_diag_A[ii] = 1.0 / inv_diag_A[ii];
+			sA->use_dA = 1;
+			}
+		}
+	else
+		{
+		ddiaex_lib(m, 1.0, ai, pA, sda, inv_diag_A);
+		for(ii=0; ii<m; ii++)
+			inv_diag_A[ii] = 1.0 / inv_diag_A[ii];
+		sA->use_dA = 0;
+		}
+
+	double *x, *z[4], *zt[4];
+
+	for(jj=0; jj<k; jj++)
+		{
+		x = sx[jj].pa + xi;
+		z[0] = sz[jj].pa + zi;
+		if(x!=z[0])
+			for(ii=0; ii<m; ii++)
+				z[0][ii] = x[ii];
+		}
+
+	for(jj=0; jj<k; jj+=4)
+		{
+		// the last group is padded by repeating its last vector
+		for(ll=0; ll<4; ll++)
+			{
+			idx = jj+ll<k ? jj+ll : k-1;
+			z[ll] = sz[idx].pa + zi;
+			}
+		ii = 0;
+		for( ; ii<m-3; ii+=4)
+			{
+			for(ll=0; ll<4; ll++)
+				zt[ll] = z[ll] + ii;
+			kernel_dtrsv_ln_inv_4_k4_lib4(ii, &pA[ii*sda], &inv_diag_A[ii], z, zt, zt);
+			}
+		if(ii<m)
+			{
+			for(ll=0; ll<4; ll++)
+				zt[ll] = z[ll] + ii;
+			kernel_dtrsv_ln_inv_4_k4_vs_lib4(ii, &pA[ii*sda], &inv_diag_A[ii], z, zt, zt, m-ii, m-ii);
+			}
+		}
+
+	return;
+	}
+
+
+
+void blasfeo_hp_dtrsv_ltn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	if(m==0 | k<=0)
+		return;
+#if defined(DIM_CHECK)
+	// non-negative size
+	if(m<0) printf("\n****** blasfeo_dtrsv_ltn_k : m<0 : %d<0 *****\n", m);
+	// non-negative offset
+	if(ai<0) printf("\n****** blasfeo_dtrsv_ltn_k : ai<0 : %d<0 *****\n", ai);
+	if(aj<0) printf("\n****** blasfeo_dtrsv_ltn_k : aj<0 : %d<0 *****\n", aj);
+	if(xi<0) printf("\n****** blasfeo_dtrsv_ltn_k : xi<0 : %d<0 *****\n", xi);
+	if(zi<0) printf("\n****** blasfeo_dtrsv_ltn_k : zi<0 : %d<0 *****\n", zi);
+	// inside matrix
+	// A: m x k
+	if(ai+m > sA->m) printf("\n***** blasfeo_dtrsv_ltn_k : ai+m > row(A) : %d+%d > %d *****\n", ai, m, sA->m);
+	if(aj+m > sA->n) printf("\n***** blasfeo_dtrsv_ltn_k : aj+m > col(A) : %d+%d > %d *****\n", aj, m, sA->n);
+#endif
+	if(ai!=0)
+		{
+#if defined(BLASFEO_REF_API)
+		blasfeo_ref_dtrsv_ltn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+		return;
+#else
+		printf("\nblasfeo_dtrsv_ltn_k: feature not implemented yet: ai=%d\n", ai);
+		exit(1);
+#endif
+		}
+	const int bs = 4;
+	int sda = sA->cn;
+	double *pA = sA->pA + aj*bs; // TODO ai
+	double *inv_diag_A = sA->dA;
+	int ii, jj, ll, idx;
+	if(ai==0 & aj==0)
+		{
+		if(sA->use_dA!=1)
+			{
+			ddiaex_lib(m, 1.0, ai, pA, sda, inv_diag_A);
+			for(ii=0; ii<m; ii++)
+				inv_diag_A[ii] = 1.0 / inv_diag_A[ii];
+			sA->use_dA = 1;
+			}
+		}
+	else
+		{
+		ddiaex_lib(m, 1.0, ai, pA, sda, inv_diag_A);
+		for(ii=0; ii<m; ii++)
+			inv_diag_A[ii] = 1.0 / inv_diag_A[ii];
+		sA->use_dA = 0;
+		}
+
+	double *x, *z[4], *zt[4];
+
+	for(jj=0; jj<k; jj++)
+		{
+		x = sx[jj].pa + xi;
+		z[0] = sz[jj].pa + zi;
+		if(x!=z[0])
+			for(ii=0; ii<m; ii++)
+				z[0][ii] = x[ii];
+		}
+
+	// clean up at the end of the matrix, one vector at a time
+	int m4 = m%4;
+	if(m4!=0)
+		{
+		for(jj=0; jj<k; jj++)
+			{
+			z[0] = sz[jj].pa + zi;
+			if(m4==1)
+				kernel_dtrsv_lt_inv_1_lib4(1, &pA[m/bs*bs*sda+(m-1)*bs], sda, &inv_diag_A[m-1], &z[0][m-1], &z[0][m-1], &z[0][m-1]);
+			else if(m4==2)
+				kernel_dtrsv_lt_inv_2_lib4(2, &pA[m/bs*bs*sda+(m-2)*bs], sda, &inv_diag_A[m-2], &z[0][m-2], &z[0][m-2], &z[0][m-2]);
+			else // if(m4==3)
+				kernel_dtrsv_lt_inv_3_lib4(3, &pA[m/bs*bs*sda+(m-3)*bs], sda, &inv_diag_A[m-3], &z[0][m-3], &z[0][m-3], &z[0][m-3]);
+			}
+		}
+
+	for(jj=0; jj<k; jj+=4)
+		{
+		// the last group is padded by repeating its last vector
+		for(ll=0; ll<4; ll++)
+			{
+			idx = jj+ll<k ? jj+ll : k-1;
+			z[ll] = sz[idx].pa + zi;
+			}
+		for(ii=m4; ii<m-3; ii+=4)
+			{
+			for(ll=0; ll<4; ll++)
+				zt[ll] = z[ll] + m-ii-4;
+			kernel_dtrsv_lt_inv_4_k4_lib4(ii+4, &pA[(m-ii-4)/bs*bs*sda+(m-ii-4)*bs], sda, &inv_diag_A[m-ii-4], zt, zt, zt);
+			}
+		}
+
+	return;
+	}
+
+
+
 #if defined(LA_HIGH_PERFORMANCE)
 
 
 
 void blasfeo_dgemv_n(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DGEMV_N, m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_N, m, n, 0);
 	blasfeo_hp_dgemv_n(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemv_t(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DGEMV_T, m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_T, m, n, 0);
 	blasfeo_hp_dgemv_t(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -1934,6 +2246,7 @@ void blasfeo_dtrsv_lnn_mn(int m, int n, struct blasfeo_dmat *sA, int ai, int aj,
 
 void blasfeo_dtrsv_lnn(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DTRSV_LNN, m, m, 0.0, sA, ai, aj, sx, xi, 0.0, NULL, 0, sz, zi);
 	blasfeo_hp_dtrsv_lnn(m, sA, ai, aj, sx, xi, sz, zi);
 	}
 
@@ -1955,6 +2268,7 @@ void blasfeo_dtrsv_ltn_mn(int m, int n, struct blasfeo_dmat *sA, int ai, int aj,
 
 void blasfeo_dtrsv_ltn(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DTRSV_LTN, m, m, 0.0, sA, ai, aj, sx, xi, 0.0, NULL, 0, sz, zi);
 	blasfeo_hp_dtrsv_ltn(m, sA, ai, aj, sx, xi, sz, zi);
 	}
 
@@ -1988,4 +2302,32 @@ void blasfeo_dger(int m, int n, double alpha, struct blasfeo_dvec *sx, int xi, s
 
 
 
+void blasfeo_dgemv_n_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dgemv_n_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_dgemv_t_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dgemv_t_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_dtrsv_lnn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dtrsv_lnn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
+void blasfeo_dtrsv_ltn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dtrsv_ltn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
 #endif
@@ -43,6 +43,8 @@
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
+#include <blasfeo_graph.h>
 
 
 
@@ -944,20 +946,67 @@ void blasfeo_hp_dger(int m, int n, double alpha, struct blasfeo_dvec *sx, int xi
 
 
 
+// multiple right-hand sides: sx, sy and sz are arrays of k vectors
+void blasfeo_hp_dgemv_n_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_dgemv_n(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_dgemv_t_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_dgemv_t(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_dtrsv_lnn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_dtrsv_lnn(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_dtrsv_ltn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_dtrsv_ltn(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
+
 #if defined(LA_HIGH_PERFORMANCE)
 
 
 
 void blasfeo_dgemv_n(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DGEMV_N, m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_N, m, n, 0);
 	blasfeo_hp_dgemv_n(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemv_t(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DGEMV_T, m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMV_T, m, n, 0);
 	blasfeo_hp_dgemv_t(m, n, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -1041,6 +1090,7 @@ void blasfeo_dtrsv_lnn_mn(int m, int n, struct blasfeo_dmat *sA, int ai, int aj,
 
 void blasfeo_dtrsv_lnn(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DTRSV_LNN, m, m, 0.0, sA, ai, aj, sx, xi, 0.0, NULL, 0, sz, zi);
 	blasfeo_hp_dtrsv_lnn(m, sA, ai, aj, sx, xi, sz, zi);
 	}
 
@@ -1062,6 +1112,7 @@ void blasfeo_dtrsv_ltn_mn(int m, int n, struct blasfeo_dmat *sA, int ai, int aj,
 
 void blasfeo_dtrsv_ltn(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
 	{
+	BLASFEO_GRAPH_RECORD_V(BLASFEO_GRAPH_DTRSV_LTN, m, m, 0.0, sA, ai, aj, sx, xi, 0.0, NULL, 0, sz, zi);
 	blasfeo_hp_dtrsv_ltn(m, sA, ai, aj, sx, xi, sz, zi);
 	}
 
@@ -1095,5 +1146,33 @@ void blasfeo_dger(int m, int n, double alpha, struct blasfeo_dvec *sx, int xi, s
 
 
 
+void blasfeo_dgemv_n_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dgemv_n_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_dgemv_t_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dgemv_t_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_dtrsv_lnn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dtrsv_lnn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
+void blasfeo_dtrsv_ltn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi)
+	{
+	blasfeo_hp_dtrsv_ltn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
 #endif
 
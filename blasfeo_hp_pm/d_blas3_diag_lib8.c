@@ -36,14 +36,26 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <blasfeo_target.h>
+#include <blasfeo_block_size.h>
 #include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
 #include <blasfeo_d_kernel.h>
+#include <blasfeo_d_blasfeo_hp_api.h>
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
 
 
 
+// rows and columns of the blocks of A scaled by diag(x) in dsyrk_diag
+#define SYRK_DIAG_MB 16
+#define SYRK_DIAG_KB D_KC
+// size of the stack buffer of a block, including the (unused) inverse diagonal of the work matrix
+#define SYRK_DIAG_W_SIZE (SYRK_DIAG_MB*SYRK_DIAG_KB+D_PS*D_PLD)
+
+
+
 // dgemm with A diagonal matrix (stored as strvec)
 void blasfeo_hp_dgemm_dn(int m, int n, double alpha, struct blasfeo_dvec *sA, int ai, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
@@ -70,6 +82,122 @@ void blasfeo_hp_dgemm_nd(int m, int n, double alpha, struct blasfeo_dmat *sA, in
 
 
 
+// W <= W * diag(x), W aligned (m)x(k)
+static void dsyrk_diag_scale(int m, int k, double *x, struct blasfeo_dmat *sW)
+	{
+	const int ps = 8;
+	int sdw = sW->cn;
+	double *pW;
+	int ii, jj;
+	for(ii=0; ii<m; ii+=ps)
+		{
+		pW = sW->pA + ii*sdw;
+		for(jj=0; jj<k; jj++)
+			{
+			pW[jj*ps+0] *= x[jj];
+			pW[jj*ps+1] *= x[jj];
+			pW[jj*ps+2] *= x[jj];
+			pW[jj*ps+3] *= x[jj];
+			pW[jj*ps+4] *= x[jj];
+			pW[jj*ps+5] *= x[jj];
+			pW[jj*ps+6] *= x[jj];
+			pW[jj*ps+7] *= x[jj];
+			}
+		}
+	return;
+	}
+
+
+
+// D(ii:i1,0:i1) <= beta * C(ii:i1,0:i1) + alpha * A(ii:i1,:) * diag(x) * B(0:i1,:)^T, lower triangular in D(ii:i1,ii:i1)
+// the block of rows of A is scaled SYRK_DIAG_KB columns at a time into the stack buffer pW, used at once by the gemm and syrk kernels
+static void dsyrk_diag_ln_rows(int ii, int i1, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, double *pW)
+	{
+	struct blasfeo_dmat sW;
+	int kk, kb;
+	kk = 0;
+	do
+		{
+		kb = k-kk<SYRK_DIAG_KB ? k-kk : SYRK_DIAG_KB;
+		blasfeo_create_dmat(i1-ii, kb, &sW, pW);
+		blasfeo_dgecp(i1-ii, kb, sA, ai+ii, aj+kk, &sW, 0, 0);
+		dsyrk_diag_scale(i1-ii, kb, sx->pa+xi+kk, &sW);
+		if(kk==0)
+			{
+			blasfeo_hp_dgemm_nt(i1-ii, ii, kb, alpha, &sW, 0, 0, sB, bi, bj, beta, sC, ci+ii, cj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(i1-ii, kb, alpha, &sW, 0, 0, sB, bi+ii, bj, beta, sC, ci+ii, cj+ii, sD, di+ii, dj+ii);
+			}
+		else
+			{
+			blasfeo_hp_dgemm_nt(i1-ii, ii, kb, alpha, &sW, 0, 0, sB, bi, bj+kk, 1.0, sD, di+ii, dj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(i1-ii, kb, alpha, &sW, 0, 0, sB, bi+ii, bj+kk, 1.0, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+			}
+		kk += kb;
+		}
+	while(kk<k);
+	return;
+	}
+
+
+
+// dsyrk with diagonal scaling: D <= beta * C + alpha * A * diag(x) * B^T ; C, D lower triangular
+void blasfeo_hp_dsyrk_diag_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+#if defined(TARGET_GENERIC)
+	double pW[SYRK_DIAG_W_SIZE];
+#else
+	ALIGNED( double pW[SYRK_DIAG_W_SIZE], 64 );
+#endif
+	int ii, i1;
+
+	// row blocks aligned to the panels of D
+	for(ii=0; ii<m; ii=i1)
+		{
+		i1 = ii + SYRK_DIAG_MB - (di+ii)%SYRK_DIAG_MB;
+		i1 = i1<m ? i1 : m;
+		dsyrk_diag_ln_rows(ii, i1, k, alpha, sA, ai, aj, sx, xi, sB, bi, bj, beta, sC, ci, cj, sD, di, dj, pW);
+		}
+
+	return;
+	}
+
+
+
+// D <= chol( C + A * diag(x) * B^T ) ; C, D lower triangular
+// row block by row block: each row block of C + A * diag(x) * B^T is factorized against the previous ones while in cache
+void blasfeo_hp_dsyrk_diag_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+#if defined(TARGET_GENERIC)
+	double pW[SYRK_DIAG_W_SIZE];
+#else
+	ALIGNED( double pW[SYRK_DIAG_W_SIZE], 64 );
+#endif
+	int ii, i1;
+
+	for(ii=0; ii<m; ii=i1)
+		{
+		i1 = ii + SYRK_DIAG_MB - (di+ii)%SYRK_DIAG_MB;
+		i1 = i1<m ? i1 : m;
+		dsyrk_diag_ln_rows(ii, i1, k, 1.0, sA, ai, aj, sx, xi, sB, bi, bj, 1.0, sC, ci, cj, sD, di, dj, pW);
+		if(ii>0)
+			{
+			blasfeo_hp_dtrsm_rltn(i1-ii, ii, 1.0, sD, di, dj, sD, di+ii, dj, sD, di+ii, dj);
+			blasfeo_hp_dsyrk_ln(i1-ii, ii, -1.0, sD, di+ii, dj, sD, di+ii, dj, 1.0, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+			}
+		blasfeo_hp_dpotrf_l(i1-ii, sD, di+ii, dj+ii, sD, di+ii, dj+ii);
+		}
+
+	return;
+	}
+
+
+
 #if defined(LA_HIGH_PERFORMANCE)
 
 
@@ -88,5 +216,19 @@ void blasfeo_dgemm_nd(int m, int n, double alpha, struct blasfeo_dmat *sA, int a
 
 
 
+void blasfeo_dsyrk_diag_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsyrk_diag_ln(m, k, alpha, sA, ai, aj, sx, xi, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dsyrk_diag_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsyrk_diag_dpotrf_ln(m, k, sA, ai, aj, sx, xi, sB, bi, bj, sC, ci, cj, sD, di, dj);
+	}
+
+
+
 #endif
 
@@ -36,13 +36,19 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <blasfeo_target.h>
+#include <blasfeo_block_size.h>
 #include <blasfeo_common.h>
 #include <blasfeo_d_kernel.h>
 #include <blasfeo_d_aux.h>
 #include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_d_blasfeo_hp_api.h>
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
+#include <blasfeo_graph.h>
+#include <blasfeo_jit.h>
 
 
 
@@ -310,6 +316,80 @@ void dlauum_blk_nt_l_lib(int m, int n, int nv, int *rv, int *cv, double *pA, int
 
 
 
+#if defined(TARGET_X64_INTEL_HASWELL) | defined(TARGET_X64_INTEL_SANDY_BRIDGE) | defined(TARGET_ARMV8A_ARM_CORTEX_A57) | defined(TARGET_ARMV8A_ARM_CORTEX_A53)
+// operands larger than the last level cache: cache blocking on NC columns of D, KC inner products
+// and MC rows of D, in the GotoBLAS loop order; the panel-major operands are accessed in place
+#define DGEMM_BLOCKED_LIB4
+
+// k>0, since the blocked loops set D to beta*C only through the first block of inner products
+static int dgemm_blocked_lib4(int m, int n, int k)
+	{
+	return (k>0) & (m>D_MC | n>D_NC | k>D_KC) & ((long long) m*k + (long long) k*n + (long long) m*n > D_LLC_CACHE_EL);
+	}
+
+
+
+static void dgemm_nn_blocked_lib4(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	const int ps = 4;
+	// multiples of the kernel and panel size, to keep the row alignment of each block
+	const int mc0 = D_MC/D_M_KERNEL*D_M_KERNEL;
+	const int nc0 = D_NC/ps*ps;
+	const int kc0 = D_KC/ps*ps;
+	int ii, jj, ll, mc, nc, kc;
+	for(jj=0; jj<n; jj+=nc)
+		{
+		nc = n-jj<nc0 ? n-jj : nc0;
+		for(ll=0; ll<k; ll+=kc)
+			{
+			kc = k-ll<kc0 ? k-ll : kc0;
+			for(ii=0; ii<m; ii+=mc)
+				{
+				mc = m-ii<mc0 ? m-ii : mc0;
+				// the first block of inner products reads C, the following ones accumulate into D
+				if(ll==0)
+					blasfeo_hp_dgemm_nn(mc, nc, kc, alpha, sA, ai+ii, aj+ll, sB, bi+ll, bj+jj, beta, sC, ci+ii, cj+jj, sD, di+ii, dj+jj);
+				else
+					blasfeo_hp_dgemm_nn(mc, nc, kc, alpha, sA, ai+ii, aj+ll, sB, bi+ll, bj+jj, 1.0, sD, di+ii, dj+jj, sD, di+ii, dj+jj);
+				}
+			}
+		}
+	return;
+	}
+
+
+
+static void dgemm_nt_blocked_lib4(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	const int ps = 4;
+	// multiples of the kernel and panel size, to keep the row alignment of each block
+	const int mc0 = D_MC/D_M_KERNEL*D_M_KERNEL;
+	const int nc0 = D_NC/ps*ps;
+	const int kc0 = D_KC/ps*ps;
+	int ii, jj, ll, mc, nc, kc;
+	for(jj=0; jj<n; jj+=nc)
+		{
+		nc = n-jj<nc0 ? n-jj : nc0;
+		for(ll=0; ll<k; ll+=kc)
+			{
+			kc = k-ll<kc0 ? k-ll : kc0;
+			for(ii=0; ii<m; ii+=mc)
+				{
+				mc = m-ii<mc0 ? m-ii : mc0;
+				// the first block of inner products reads C, the following ones accumulate into D
+				if(ll==0)
+					blasfeo_hp_dgemm_nt(mc, nc, kc, alpha, sA, ai+ii, aj+ll, sB, bi+jj, bj+ll, beta, sC, ci+ii, cj+jj, sD, di+ii, dj+jj);
+				else
+					blasfeo_hp_dgemm_nt(mc, nc, kc, alpha, sA, ai+ii, aj+ll, sB, bi+jj, bj+ll, 1.0, sD, di+ii, dj+jj, sD, di+ii, dj+jj);
+				}
+			}
+		}
+	return;
+	}
+#endif
+
+
+
 // dgemm nn
 void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
@@ -319,6 +399,14 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 	// invalidate stored inverse diagonal of result matrix
 	sD->use_dA = 0;
 
+#if defined(DGEMM_BLOCKED_LIB4)
+	if(dgemm_blocked_lib4(m, n, k))
+		{
+		dgemm_nn_blocked_lib4(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+		return;
+		}
+#endif
+
 	const int ps = 4;
 
 	int sda = sA->cn;
@@ -367,6 +455,22 @@ void blasfeo_hp_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 
 
+#if defined(BLASFEO_JIT)
+	// small matrices: kernel generated at runtime for the exact size
+	if(air==0 & bir==0 & offsetC==0 & offsetD==0 & m<=BLASFEO_JIT_MAX_M & n<=BLASFEO_JIT_MAX_N & k<=BLASFEO_JIT_MAX_K & m*n*k>=BLASFEO_JIT_MIN_MNK)
+		{
+		blasfeo_jit_dgemm_kernel kernel = blasfeo_jit_dgemm_get('n', m, n, k, alpha, beta);
+		if(kernel!=NULL)
+			{
+			struct blasfeo_jit_dgemm_args args = {pA, pB, pC, pD, (long long) ps*sda*sizeof(double), (long long) ps*sdb*sizeof(double), (long long) ps*sdc*sizeof(double), (long long) ps*sdd*sizeof(double), alpha, beta};
+			kernel(&args);
+			return;
+			}
+		}
+#endif
+
+
+
 	// algorithm scheme
 	if(air!=0)
 		{
@@ -731,6 +835,14 @@ void blasfeo_hp_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat
 	// invalidate stored inverse diagonal of result matrix
 	sD->use_dA = 0;
 
+#if defined(DGEMM_BLOCKED_LIB4)
+	if(dgemm_blocked_lib4(m, n, k))
+		{
+		dgemm_nt_blocked_lib4(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+		return;
+		}
+#endif
+
 	const int ps = 4;
 
 	int sda = sA->cn;
@@ -775,6 +887,22 @@ void blasfeo_hp_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat
 
 
 
+#if defined(BLASFEO_JIT)
+	// small matrices: kernel generated at runtime for the exact size
+	if(air==0 & bir==0 & offsetC==0 & offsetD==0 & m<=BLASFEO_JIT_MAX_M & n<=BLASFEO_JIT_MAX_N & k<=BLASFEO_JIT_MAX_K & m*n*k>=BLASFEO_JIT_MIN_MNK)
+		{
+		blasfeo_jit_dgemm_kernel kernel = blasfeo_jit_dgemm_get('t', m, n, k, alpha, beta);
+		if(kernel!=NULL)
+			{
+			struct blasfeo_jit_dgemm_args args = {pA, pB, pC, pD, (long long) ps*sda*sizeof(double), (long long) ps*sdb*sizeof(double), (long long) ps*sdc*sizeof(double), (long long) ps*sdd*sizeof(double), alpha, beta};
+			kernel(&args);
+			return;
+			}
+		}
+#endif
+
+
+
 	// algorithm scheme
 	if(air!=0)
 		{
@@ -5419,13 +5547,13 @@ loop_000:
 		// main loop
 		for(; j<i; j+=4)
 			{
-			kernel_dgemm_nt_12x4_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+			kernel_dgemm_nt_12x4_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 			}
-		kernel_dsyrk_nt_l_12x4_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+		kernel_dsyrk_nt_l_12x4_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 #if defined(TARGET_X64_INTEL_HASWELL)
-		kernel_dsyrk_nt_l_8x8_lib4(k, &alpha, pA2+4*sda2, sda, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd);
+		kernel_dsyrk_nt_l_8x8_lib4(k, &alpha, pA2+4*sda2, sda2, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd);
 #else
-		kernel_dsyrk_nt_l_8x4_lib4(k, &alpha, pA2+4*sda2, sda, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd);
+		kernel_dsyrk_nt_l_8x4_lib4(k, &alpha, pA2+4*sda2, sda2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd);
 		kernel_dsyrk_nt_l_4x4_lib4(k, &alpha, pA2+8*sda2, &pB[(j+8)*sdb], &beta, &pC[(j+8)*ps+(i+8)*sdc], &pD[(j+8)*ps+(i+8)*sdd]);
 #endif
 		}
@@ -5467,9 +5595,9 @@ loop_000:
 		// main loop
 		for(; j<i; j+=4)
 			{
-			kernel_dgemm_nt_8x4_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+			kernel_dgemm_nt_8x4_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 			}
-		kernel_dsyrk_nt_l_8x4_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+		kernel_dsyrk_nt_l_8x4_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 		kernel_dsyrk_nt_l_4x4_lib4(k, &alpha, pA2+4*sda2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], &pD[(j+4)*ps+(i+4)*sdd]);
 		}
 	if(m>i)
@@ -5625,10 +5753,10 @@ loop_0CD:
 		// main loop
 		for(; j<i; j+=4)
 			{
-			kernel_dgemm_nt_12x4_gen_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc], sdc, offsetD, &pD[j*ps+i*sdd], sdd, 0, m-i, 0, m-j);
+			kernel_dgemm_nt_12x4_gen_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc], sdc, offsetD, &pD[j*ps+i*sdd], sdd, 0, m-i, 0, m-j);
 			}
-		kernel_dsyrk_nt_l_12x4_gen_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc], sdc, offsetD, &pD[j*ps+i*sdd], sdd, 0, m-i, 0, m-j);
-		kernel_dsyrk_nt_l_8x8_gen_lib4(k, &alpha, pA2+4*sda2, sda, &pB[(j+4)*sdb], sdb, &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc], sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd], sdd, 0, m-i-4, 0, m-j-4);
+		kernel_dsyrk_nt_l_12x4_gen_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc], sdc, offsetD, &pD[j*ps+i*sdd], sdd, 0, m-i, 0, m-j);
+		kernel_dsyrk_nt_l_8x8_gen_lib4(k, &alpha, pA2+4*sda2, sda2, &pB[(j+4)*sdb], sdb, &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc], sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd], sdd, 0, m-i-4, 0, m-j-4);
 		}
 	if(m>i)
 		{
@@ -5730,7 +5858,8 @@ loop_BCD:
 			}
 		kernel_dsyrk_nt_l_8x4_gen_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc]-bir*ps, sdc, offsetD, &pD[j*ps+i*sdd]-bir*ps, sdd, 0, m-i, bir, bir+m-j);
 		kernel_dsyrk_nt_l_8x4_gen_lib4(k, &alpha, pA2, sda2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
-		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2+4*sda2, &pB[(j+8)*sdb], &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd]+(ps-bir)*ps, sdd, ps-bir, m-(i+4), 0, m-(j+4));
+		if(m-(j+4)>ps-bir) // the last panel of B is read only if it holds rows of the result
+			kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2+4*sda2, &pB[(j+8)*sdb], &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd]+(ps-bir)*ps, sdd, ps-bir, m-(i+4), 0, m-(j+4));
 		}
 	if(m>i)
 		{
@@ -5766,7 +5895,8 @@ loop_BCD:
 			j += bir;
 			}
 		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc]-bir*ps, sdc, offsetD, &pD[j*ps+i*sdd]-bir*ps, sdd, 0, m-i, bir, bir+m-j);
-		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
+		if(m-j>ps-bir) // the last panel of B is read only if it holds rows of the result
+			kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
 		}
 #endif
 	// common return if i==m
@@ -5799,13 +5929,13 @@ loop_BCD:
 	// main loop
 	for(; j<i; j+=4)
 		{
-		kernel_dgemm_nt_12x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_12x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		}
-	kernel_dsyrk_nt_l_12x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+	kernel_dsyrk_nt_l_12x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 #if defined(TARGET_X64_INTEL_HASWELL)
-	kernel_dsyrk_nt_l_8x8_vs_lib4(k, &alpha, pA2+4*sda2, sda, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd, m-i-4, m-j-4);
+	kernel_dsyrk_nt_l_8x8_vs_lib4(k, &alpha, pA2+4*sda2, sda2, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd, m-i-4, m-j-4);
 #else
-	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2+4*sda2, sda, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd, m-i-4, m-j-4);
+	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2+4*sda2, sda2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], sdc, &pD[(j+4)*ps+(i+4)*sdd], sdd, m-i-4, m-j-4);
 	kernel_dsyrk_nt_l_4x4_vs_lib4(k, &alpha, pA2+8*sda2, &pB[(j+8)*sdb], &beta, &pC[(j+8)*ps+(i+8)*sdc], &pD[(j+8)*ps+(i+8)*sdd], m-i-8, m-j-8);
 #endif
 	goto end;
@@ -5830,21 +5960,21 @@ loop_BCD:
 	// main loop
 	for(; j<i-8; j+=12)
 		{
-		kernel_dgemm_nt_8x8l_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
-		kernel_dgemm_nt_8x8u_vs_lib4(k, &alpha, pA2, sda, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+i*sdc], sdc, &pD[(j+4)*ps+i*sdd], sdd, m-i, m-(j+4));
+		kernel_dgemm_nt_8x8l_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_8x8u_vs_lib4(k, &alpha, pA2, sda2, &pB[(j+4)*sdb], sdb, &beta, &pC[(j+4)*ps+i*sdc], sdc, &pD[(j+4)*ps+i*sdd], sdd, m-i, m-(j+4));
 		}
 	if(j<i-4)
 		{
-		kernel_dgemm_nt_8x8l_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_8x8l_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		kernel_dgemm_nt_4x4_vs_lib4(k, &alpha, pA2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+i*sdc], &pD[(j+4)*ps+i*sdd], m-i, m-(j+4));
 		j += 8;
 		}
 	else if(j<i)
 		{
-		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		j += 4;
 		}
-	kernel_dsyrk_nt_l_8x8_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+	kernel_dsyrk_nt_l_8x8_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], sdb, &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 	goto end;
 #elif defined(TARGET_X64_INTEL_SANDY_BRIDGE)
 	left_8:
@@ -5863,9 +5993,9 @@ loop_BCD:
 	// main loop
 	for(; j<i; j+=4)
 		{
-		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		}
-	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 	kernel_dsyrk_nt_l_4x4_vs_lib4(k, &alpha, pA2+4*sda2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], &pD[(j+4)*ps+(i+4)*sdd], m-i-4, m-j-4);
 	goto end;
 #elif defined(TARGET_ARMV8A_ARM_CORTEX_A57) || defined(TARGET_ARMV8A_ARM_CORTEX_A53)
@@ -5886,9 +6016,9 @@ loop_BCD:
 	// main loop
 	for(; j<i; j+=4)
 		{
-		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_8x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		}
-	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+	kernel_dsyrk_nt_l_8x4_vs_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 	kernel_dsyrk_nt_l_4x4_vs_lib4(k, &alpha, pA2+4*sda2, &pB[(j+4)*sdb], &beta, &pC[(j+4)*ps+(i+4)*sdc], &pD[(j+4)*ps+(i+4)*sdd], m-i-4, m-j-4);
 	goto end;
 #endif
@@ -5925,7 +6055,8 @@ loop_BCD:
 		}
 	kernel_dsyrk_nt_l_8x4_gen_lib4(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc]-bir*ps, sdc, offsetD, &pD[j*ps+i*sdd]-bir*ps, sdd, 0, m-i, bir, bir+m-j);
 	kernel_dsyrk_nt_l_8x4_gen_lib4(k, &alpha, pA2, sda2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
-	kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2+4*sda2, &pB[(j+8)*sdb], &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd]+(ps-bir)*ps, sdd, ps-bir, m-(i+4), 0, m-(j+4));
+	if(m-(j+4)>ps-bir) // the last panel of B is read only if it holds rows of the result
+		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2+4*sda2, &pB[(j+8)*sdb], &beta, offsetC, &pC[(j+4)*ps+(i+4)*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[(j+4)*ps+(i+4)*sdd]+(ps-bir)*ps, sdd, ps-bir, m-(i+4), 0, m-(j+4));
 	goto end;
 #endif
 
@@ -6043,7 +6174,8 @@ loop_BCD:
 			j += bir;
 			}
 		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[j*sdb], &beta, offsetC, &pC[j*ps+i*sdc]-bir*ps, sdc, offsetD, &pD[j*ps+i*sdd]-bir*ps, sdd, 0, m-i, bir, bir+m-j);
-		kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
+		if(m-j>ps-bir) // the last panel of B is read only if it holds rows of the result
+			kernel_dsyrk_nt_l_4x4_gen_lib4(k, &alpha, pA2, &pB[(j+4)*sdb], &beta, offsetC, &pC[j*ps+i*sdc]+(ps-bir)*ps, sdc, offsetD, &pD[j*ps+i*sdd]+(ps-bir)*ps, sdd, ps-bir, m-i, 0, m-j);
 		}
 	else
 		{
@@ -7035,28 +7167,38 @@ void blasfeo_hp_dsyr2k_ut(int m, int k, double alpha, struct blasfeo_dmat *sA, i
 
 void blasfeo_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DGEMM_NN, m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NN, m, n, k);
 	blasfeo_hp_dgemm_nn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DGEMM_NT, m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NT, m, n, k);
 	blasfeo_hp_dgemm_nt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TN, m, n, k);
 	blasfeo_hp_dgemm_tn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TT, m, n, k);
 	blasfeo_hp_dgemm_tt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -7133,7 +7275,10 @@ void blasfeo_dtrsm_rlnu(int m, int n, double alpha, struct blasfeo_dmat *sA, int
 
 void blasfeo_dtrsm_rltn(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DTRSM_RLTN, m, n, 0, alpha, sA, ai, aj, sB, bi, bj, 0.0, NULL, 0, 0, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DTRSM_RLTN, m, n, 0);
 	blasfeo_hp_dtrsm_rltn(m, n, alpha, sA, ai, aj, sB, bi, bj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -7231,6 +7376,7 @@ void blasfeo_dtrmm_lutu(int m, int n, double alpha, struct blasfeo_dmat *sB, int
 
 void blasfeo_dtrmm_rlnn(int m, int n, double alpha, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DTRMM_RLNN, m, n, 0, alpha, sB, bi, bj, sA, ai, aj, 0.0, NULL, 0, 0, sD, di, dj);
 	blasfeo_hp_dtrmm_rlnn(m, n, alpha, sB, bi, bj, sA, ai, aj, sD, di, dj);
 	}
 
@@ -7287,7 +7433,10 @@ void blasfeo_dtrmm_rutu(int m, int n, double alpha, struct blasfeo_dmat *sB, int
 
 void blasfeo_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DSYRK_LN, m, m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DSYRK_LN, m, m, k);
 	blasfeo_hp_dsyrk_ln(m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -43,6 +43,8 @@
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
+#include <blasfeo_graph.h>
 
 
 
@@ -2093,9 +2095,9 @@ loop_000:
 		// main loop
 		for(; j<i; j+=8)
 			{
-			kernel_dgemm_nt_16x8_lib8(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+			kernel_dgemm_nt_16x8_lib8(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 			}
-		kernel_dsyrk_nt_l_16x8_lib8(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
+		kernel_dsyrk_nt_l_16x8_lib8(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd);
 		kernel_dsyrk_nt_l_8x8_lib8(k, &alpha, pA2+8*sda2, &pB[(j+8)*sdb], &beta, &pC[(j+8)*ps+(i+8)*sdc], &pD[(j+8)*ps+(i+8)*sdd]);
 		}
 	if(m>i)
@@ -2217,9 +2219,9 @@ loop_0CD:
 	// main loop
 	for(; j<i; j+=8)
 		{
-		kernel_dgemm_nt_16x8_vs_lib8(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+		kernel_dgemm_nt_16x8_vs_lib8(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 		}
-	kernel_dsyrk_nt_l_16x8_vs_lib8(k, &alpha, pA2, sda, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
+	kernel_dsyrk_nt_l_16x8_vs_lib8(k, &alpha, pA2, sda2, &pB[j*sdb], &beta, &pC[j*ps+i*sdc], sdc, &pD[j*ps+i*sdd], sdd, m-i, m-j);
 	kernel_dsyrk_nt_l_8x8_vs_lib8(k, &alpha, pA2+8*sda2, &pB[(j+8)*sdb], &beta, &pC[(j+8)*ps+(i+8)*sdc], &pD[(j+8)*ps+(i+8)*sdd], m-i-8, m-j-8);
 	goto end;
 
@@ -2639,28 +2641,38 @@ void blasfeo_hp_dsyr2k_ut(int m, int k, double alpha, struct blasfeo_dmat *sA, i
 
 void blasfeo_dgemm_nn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DGEMM_NN, m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NN, m, n, k);
 	blasfeo_hp_dgemm_nn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_nt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DGEMM_NT, m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_NT, m, n, k);
 	blasfeo_hp_dgemm_nt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tn(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TN, m, n, k);
 	blasfeo_hp_dgemm_tn(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
 
 void blasfeo_dgemm_tt(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGEMM_TT, m, n, k);
 	blasfeo_hp_dgemm_tt(m, n, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -2737,7 +2749,10 @@ void blasfeo_dtrsm_rlnu(int m, int n, double alpha, struct blasfeo_dmat *sA, int
 
 void blasfeo_dtrsm_rltn(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DTRSM_RLTN, m, n, 0, alpha, sA, ai, aj, sB, bi, bj, 0.0, NULL, 0, 0, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DTRSM_RLTN, m, n, 0);
 	blasfeo_hp_dtrsm_rltn(m, n, alpha, sA, ai, aj, sB, bi, bj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -2835,6 +2850,7 @@ void blasfeo_dtrmm_lutu(int m, int n, double alpha, struct blasfeo_dmat *sB, int
 
 void blasfeo_dtrmm_rlnn(int m, int n, double alpha, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DTRMM_RLNN, m, n, 0, alpha, sB, bi, bj, sA, ai, aj, 0.0, NULL, 0, 0, sD, di, dj);
 	blasfeo_hp_dtrmm_rlnn(m, n, alpha, sB, bi, bj, sA, ai, aj, sD, di, dj);
 	}
 
@@ -2891,7 +2907,10 @@ void blasfeo_dtrmm_rutu(int m, int n, double alpha, struct blasfeo_dmat *sB, int
 
 void blasfeo_dsyrk_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DSYRK_LN, m, m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DSYRK_LN, m, m, k);
 	blasfeo_hp_dsyrk_ln(m, k, alpha, sA, ai, aj, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
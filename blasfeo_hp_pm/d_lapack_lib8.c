@@ -41,9 +41,13 @@
 #include <blasfeo_d_aux.h>
 #include <blasfeo_d_kernel.h>
 #include <blasfeo_d_blasfeo_api.h>
+#include <blasfeo_d_blasfeo_hp_api.h>
+#include <blasfeo_stdlib.h>
 #if defined(BLASFEO_REF_API)
 #include <blasfeo_d_blasfeo_ref_api.h>
 #endif
+#include <blasfeo_profile.h>
+#include <blasfeo_graph.h>
 
 
 
@@ -1459,13 +1463,776 @@ void blasfeo_hp_dgelqf_pd_lla(int m, int n1, struct blasfeo_dmat *sD, int di, in
 
 
 
+// D <= chol( D * D^T + A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+void blasfeo_hp_dchud_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	const int ps = 8;
+
+	// extract dimensions
+	int sda = sA->cn;
+	int sdd = sD->cn;
+
+	// go to submatrix
+	int aoff = ai%ps;
+	int doff = di%ps;
+	double *pA = sA->pA + ai/ps*ps*sda + aj*ps;
+	double *pD = sD->pA + di/ps*ps*sdd + dj*ps;
+	double *dD = sD->dA;
+
+	if(di==0 & dj==0)
+		sD->use_dA = m;
+	else
+		sD->use_dA = 0;
+
+	int ii, jj, ll;
+	double d_jj, a_jl, r, c, s, d_tmp;
+	double *pD_jj, *pA_jl, *pd, *pa;
+
+	for(jj=0; jj<m; jj++)
+		{
+		pD_jj = pD + (doff+jj)/ps*ps*sdd + (doff+jj)%ps + jj*ps;
+		d_jj = pD_jj[0];
+		// Givens rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			pA_jl = pA + (aoff+jj)/ps*ps*sda + (aoff+jj)%ps + ll*ps;
+			a_jl = pA_jl[0];
+			if(a_jl==0.0)
+				continue;
+			r = sqrt(d_jj*d_jj + a_jl*a_jl);
+			c = d_jj / r;
+			s = a_jl / r;
+			d_jj = r;
+			pA_jl[0] = 0.0;
+			pd = pD_jj;
+			pa = pA_jl;
+			for(ii=jj+1; ii<m; ii++)
+				{
+				// step to the next row, jumping to the next panel at panel boundaries
+				pd += ((doff+ii)&(ps-1))==0 ? 1+ps*(sdd-1) : 1;
+				pa += ((aoff+ii)&(ps-1))==0 ? 1+ps*(sda-1) : 1;
+				d_tmp = c * pd[0] + s * pa[0];
+				pa[0] = c * pa[0] - s * pd[0];
+				pd[0] = d_tmp;
+				}
+			}
+		pD_jj[0] = d_jj;
+		if(di==0 & dj==0)
+			dD[jj] = d_jj>0.0 ? 1.0/d_jj : 0.0;
+		}
+
+	return;
+
+	}
+
+
+
+// D <= chol( D * D^T - A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+// if the result is not positive definite, the failing columns of D are set to zero
+void blasfeo_hp_dchdd_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	const int ps = 8;
+
+	// extract dimensions
+	int sda = sA->cn;
+	int sdd = sD->cn;
+
+	// go to submatrix
+	int aoff = ai%ps;
+	int doff = di%ps;
+	double *pA = sA->pA + ai/ps*ps*sda + aj*ps;
+	double *pD = sD->pA + di/ps*ps*sdd + dj*ps;
+	double *dD = sD->dA;
+
+	if(di==0 & dj==0)
+		sD->use_dA = m;
+	else
+		sD->use_dA = 0;
+
+	int ii, jj, ll;
+	double d_jj, a_jl, r, r2, c, s, d_tmp;
+	double *pD_jj, *pA_jl, *pd, *pa;
+
+	for(jj=0; jj<m; jj++)
+		{
+		pD_jj = pD + (doff+jj)/ps*ps*sdd + (doff+jj)%ps + jj*ps;
+		d_jj = pD_jj[0];
+		// hyperbolic rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			pA_jl = pA + (aoff+jj)/ps*ps*sda + (aoff+jj)%ps + ll*ps;
+			a_jl = pA_jl[0];
+			if(a_jl==0.0)
+				continue;
+			r2 = (d_jj - a_jl) * (d_jj + a_jl);
+			if(!(r2>0.0))
+				{
+				d_jj = 0.0;
+				break;
+				}
+			r = sqrt(r2);
+			c = r / d_jj;
+			s = a_jl / d_jj;
+			d_jj = r;
+			pA_jl[0] = 0.0;
+			pd = pD_jj;
+			pa = pA_jl;
+			// mixed form, numerically stable
+			for(ii=jj+1; ii<m; ii++)
+				{
+				// step to the next row, jumping to the next panel at panel boundaries
+				pd += ((doff+ii)&(ps-1))==0 ? 1+ps*(sdd-1) : 1;
+				pa += ((aoff+ii)&(ps-1))==0 ? 1+ps*(sda-1) : 1;
+				d_tmp = (pd[0] - s * pa[0]) / c;
+				pa[0] = c * pa[0] - s * d_tmp;
+				pd[0] = d_tmp;
+				}
+			}
+		if(d_jj==0.0)
+			{
+			pd = pD_jj;
+			for(ii=jj+1; ii<m; ii++)
+				{
+				pd += ((doff+ii)&(ps-1))==0 ? 1+ps*(sdd-1) : 1;
+				pd[0] = 0.0;
+				}
+			}
+		pD_jj[0] = d_jj;
+		if(di==0 & dj==0)
+			dD[jj] = d_jj>0.0 ? 1.0/d_jj : 0.0;
+		}
+
+	return;
+
+	}
+
+
+
+// element access for the Bunch-Kaufman routines
+#define DSYTRF_EL_A(i, j) BLASFEO_DMATEL(sA, ai+(i), aj+(j))
+#define DSYTRF_EL_D(i, j) BLASFEO_DMATEL(sD, di+(i), dj+(j))
+#define DSYTRF_EL_W(i, j) BLASFEO_DMATEL(sW, i, j)
+
+// Bunch-Kaufman factorization of at most nb-1 leading columns of the lower triangle of the
+// (m)x(m) matrix at (di,dj), followed by the update of the trailing lower triangle;
+// W is a (m)x(2*nb) work matrix, x and y are work vectors of size nb and m for the column updates
+// (done with dgemv_n, that handles any row offset of W), and the number of factorized columns is returned
+static int dsytrf_l_panel_lib8(int m, int nb, struct blasfeo_dmat *sD, int di, int dj, int *ipiv, struct blasfeo_dmat *sW, struct blasfeo_dvec *sx, struct blasfeo_dvec *sy)
+	{
+
+	const double alpha = (1.0+sqrt(17.0))/8.0;
+
+	int ii, jj, j0, jp, k, kk, kp, kstep;
+	double absakk, colmax, rowmax, tmp, d11, d21, d22, t;
+
+	k = 0;
+	while(k<m & (k<nb-1 | nb>=m))
+		{
+		// W(k:m,k) <= A(k:m,k) - A(k:m,0:k) * W(k,0:k)^T
+		for(ii=k; ii<m; ii++)
+			DSYTRF_EL_W(ii, k) = DSYTRF_EL_D(ii, k);
+		if(k>0)
+			{
+			blasfeo_drowex(k, 1.0, sW, k, 0, sx, 0);
+			blasfeo_dcolex(m-k, sW, k, k, sy, 0);
+			blasfeo_hp_dgemv_n(m-k, k, -1.0, sD, di+k, dj, sx, 0, 1.0, sy, 0, sy, 0);
+			blasfeo_dcolin(m-k, sy, 0, sW, k, k);
+			}
+		kstep = 1;
+		absakk = fabs(DSYTRF_EL_W(k, k));
+		kp = k;
+		colmax = 0.0;
+		for(ii=k+1; ii<m; ii++)
+			{
+			tmp = fabs(DSYTRF_EL_W(ii, k));
+			if(tmp>colmax)
+				{
+				colmax = tmp;
+				kp = ii;
+				}
+			}
+		if(absakk==0.0 & colmax==0.0)
+			{
+			// zero column: singular matrix, the column is left as it is
+			kp = k;
+			for(ii=k; ii<m; ii++)
+				DSYTRF_EL_D(ii, k) = DSYTRF_EL_W(ii, k);
+			}
+		else
+			{
+			if(absakk>=alpha*colmax)
+				{
+				// no interchange, 1x1 pivot block
+				kp = k;
+				}
+			else
+				{
+				// W(k:m,k+1) <= A(k:m,kp) - A(k:m,0:k) * W(kp,0:k)^T, the column kp is read from the lower triangle
+				for(ii=k; ii<kp; ii++)
+					DSYTRF_EL_W(ii, k+1) = DSYTRF_EL_D(kp, ii);
+				for(ii=kp; ii<m; ii++)
+					DSYTRF_EL_W(ii, k+1) = DSYTRF_EL_D(ii, kp);
+				if(k>0)
+					{
+					blasfeo_drowex(k, 1.0, sW, kp, 0, sx, 0);
+					blasfeo_dcolex(m-k, sW, k, k+1, sy, 0);
+					blasfeo_hp_dgemv_n(m-k, k, -1.0, sD, di+k, dj, sx, 0, 1.0, sy, 0, sy, 0);
+					blasfeo_dcolin(m-k, sy, 0, sW, k, k+1);
+					}
+				rowmax = 0.0;
+				for(ii=k; ii<m; ii++)
+					{
+					tmp = fabs(DSYTRF_EL_W(ii, k+1));
+					if(ii!=kp & tmp>rowmax)
+						rowmax = tmp;
+					}
+				if(absakk>=alpha*colmax*(colmax/rowmax))
+					{
+					// no interchange, 1x1 pivot block
+					kp = k;
+					}
+				else if(fabs(DSYTRF_EL_W(kp, k+1))>=alpha*rowmax)
+					{
+					// interchange rows and columns k and kp, 1x1 pivot block
+					for(ii=k; ii<m; ii++)
+						DSYTRF_EL_W(ii, k) = DSYTRF_EL_W(ii, k+1);
+					}
+				else
+					{
+					// interchange rows and columns k+1 and kp, 2x2 pivot block
+					kstep = 2;
+					}
+				}
+			kk = k+kstep-1;
+			if(kp!=kk)
+				{
+				// copy the non-updated column kk to column kp
+				DSYTRF_EL_D(kp, kp) = DSYTRF_EL_D(kk, kk);
+				for(ii=kk+1; ii<kp; ii++)
+					DSYTRF_EL_D(kp, ii) = DSYTRF_EL_D(ii, kk);
+				for(ii=kp+1; ii<m; ii++)
+					DSYTRF_EL_D(ii, kp) = DSYTRF_EL_D(ii, kk);
+				// interchange rows kk and kp in the first k columns of A and the first kk+1 columns of W
+				for(jj=0; jj<k; jj++)
+					{
+					tmp = DSYTRF_EL_D(kk, jj);
+					DSYTRF_EL_D(kk, jj) = DSYTRF_EL_D(kp, jj);
+					DSYTRF_EL_D(kp, jj) = tmp;
+					}
+				for(jj=0; jj<=kk; jj++)
+					{
+					tmp = DSYTRF_EL_W(kk, jj);
+					DSYTRF_EL_W(kk, jj) = DSYTRF_EL_W(kp, jj);
+					DSYTRF_EL_W(kp, jj) = tmp;
+					}
+				}
+			if(kstep==1)
+				{
+				// store the column k of W in A, and scale it to get the column k of L
+				for(ii=k; ii<m; ii++)
+					DSYTRF_EL_D(ii, k) = DSYTRF_EL_W(ii, k);
+				if(k<m-1)
+					{
+					tmp = 1.0/DSYTRF_EL_D(k, k);
+					for(ii=k+1; ii<m; ii++)
+						DSYTRF_EL_D(ii, k) *= tmp;
+					}
+				}
+			else
+				{
+				// store the columns k and k+1 of L, computed as W * inv(D_k)
+				if(k<m-2)
+					{
+					d21 = DSYTRF_EL_W(k+1, k);
+					d11 = DSYTRF_EL_W(k+1, k+1) / d21;
+					d22 = DSYTRF_EL_W(k, k) / d21;
+					t = 1.0 / (d11*d22 - 1.0);
+					d21 = t / d21;
+					for(ii=k+2; ii<m; ii++)
+						{
+						DSYTRF_EL_D(ii, k) = d21 * (d11*DSYTRF_EL_W(ii, k) - DSYTRF_EL_W(ii, k+1));
+						DSYTRF_EL_D(ii, k+1) = d21 * (d22*DSYTRF_EL_W(ii, k+1) - DSYTRF_EL_W(ii, k));
+						}
+					}
+				DSYTRF_EL_D(k, k) = DSYTRF_EL_W(k, k);
+				DSYTRF_EL_D(k+1, k) = DSYTRF_EL_W(k+1, k);
+				DSYTRF_EL_D(k+1, k+1) = DSYTRF_EL_W(k+1, k+1);
+				}
+			}
+		// 0-based pivot indices, negative for 2x2 pivot blocks
+		if(kstep==1)
+			{
+			ipiv[k] = kp;
+			}
+		else
+			{
+			ipiv[k] = -kp-1;
+			ipiv[k+1] = -kp-1;
+			}
+		k += kstep;
+		}
+
+	// A(k:m,k:m) <= A(k:m,k:m) - L(k:m,0:k) * W(k:m,0:k)^T, lower triangle
+	if(k<m)
+		{
+		// dsyrk_ln needs the B operand aligned to a panel, L(k:m,0:k) * D is copied to the columns nb:nb+k of W
+		blasfeo_dgecp(m-k, k, sW, k, 0, sW, 0, nb);
+		blasfeo_hp_dsyrk_ln(m-k, k, -1.0, sD, di+k, dj, sW, 0, nb, 1.0, sD, di+k, dj+k, sD, di+k, dj+k);
+		}
+
+	// put the columns 0:k of L in standard form, by partially undoing the interchanges
+	jj = k-1;
+	while(jj>=0)
+		{
+		j0 = jj;
+		jp = ipiv[jj];
+		if(jp<0)
+			{
+			jp = -jp-1;
+			jj--;
+			}
+		jj--;
+		if(jp!=j0 & jj>=0)
+			{
+			for(ii=0; ii<=jj; ii++)
+				{
+				tmp = DSYTRF_EL_D(jp, ii);
+				DSYTRF_EL_D(jp, ii) = DSYTRF_EL_D(j0, ii);
+				DSYTRF_EL_D(j0, ii) = tmp;
+				}
+			}
+		}
+
+	return k;
+
+	}
+
+
+
+// D <= ldl( C ), with Bunch-Kaufman pivoting; C, D lower triangular
+void blasfeo_hp_dsytrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	if(sC!=sD | ci!=di | cj!=dj)
+		blasfeo_dtrcp_l(m, sC, ci, cj, sD, di, dj);
+
+	// panel width
+	const int nb = 32;
+
+	int ii, k, kb;
+
+	struct blasfeo_dmat sW;
+	struct blasfeo_dvec sx, sy;
+	int w_size = blasfeo_memsize_dmat(m, 2*nb);
+	int x_size = blasfeo_memsize_dvec(nb);
+	void *mem;
+	blasfeo_malloc_align(&mem, w_size+x_size+blasfeo_memsize_dvec(m));
+	blasfeo_create_dmat(m, 2*nb, &sW, mem);
+	blasfeo_create_dvec(nb, &sx, (char *) mem+w_size);
+	blasfeo_create_dvec(m, &sy, (char *) mem+w_size+x_size);
+
+	for(k=0; k<m; k+=kb)
+		{
+		kb = dsytrf_l_panel_lib8(m-k, nb, sD, di+k, dj+k, ipiv+k, &sW, &sx, &sy);
+		// pivot indices relative to the whole matrix
+		for(ii=k; ii<k+kb; ii++)
+			ipiv[ii] += ipiv[ii]>=0 ? k : -k;
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// D <= inv( A ) * B, with A factorized by dsytrf_l
+void blasfeo_hp_dsytrs_l(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0 | n<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	if(sB!=sD | bi!=di | bj!=dj)
+		blasfeo_dgecp(m, n, sB, bi, bj, sD, di, dj);
+
+	const int ps = 8;
+
+	int ii, jj, k, kp;
+	double tmp, akm1k, akm1, ak, denom, bkm1, bk;
+
+	// the rank-1 and rank-2 updates go through dgemm_nn only if A and D have the same row offset
+	// within the panel, since dgemm_nn does not support A rows shifted with respect to the D ones
+	int use_gemm = ((ai-di)&(ps-1))==0;
+
+	// solve L * D * X = B
+	k = 0;
+	while(k<m)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			kp = ipiv[k];
+			if(kp!=k)
+				blasfeo_drowsw(n, sD, di+k, dj, sD, di+kp, dj);
+			if(k<m-1)
+				{
+				if(use_gemm)
+					{
+					blasfeo_hp_dgemm_nn(m-k-1, n, 1, -1.0, sA, ai+k+1, aj+k, sD, di+k, dj, 1.0, sD, di+k+1, dj, sD, di+k+1, dj);
+					}
+				else
+					{
+					for(jj=0; jj<n; jj++)
+						{
+						tmp = DSYTRF_EL_D(k, jj);
+						for(ii=k+1; ii<m; ii++)
+							DSYTRF_EL_D(ii, jj) -= DSYTRF_EL_A(ii, k) * tmp;
+						}
+					}
+				}
+			tmp = 1.0/DSYTRF_EL_A(k, k);
+			for(jj=0; jj<n; jj++)
+				DSYTRF_EL_D(k, jj) *= tmp;
+			k += 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			kp = -ipiv[k]-1;
+			if(kp!=k+1)
+				blasfeo_drowsw(n, sD, di+k+1, dj, sD, di+kp, dj);
+			if(k<m-2)
+				{
+				if(use_gemm)
+					{
+					blasfeo_hp_dgemm_nn(m-k-2, n, 2, -1.0, sA, ai+k+2, aj+k, sD, di+k, dj, 1.0, sD, di+k+2, dj, sD, di+k+2, dj);
+					}
+				else
+					{
+					for(jj=0; jj<n; jj++)
+						{
+						bkm1 = DSYTRF_EL_D(k, jj);
+						bk = DSYTRF_EL_D(k+1, jj);
+						for(ii=k+2; ii<m; ii++)
+							DSYTRF_EL_D(ii, jj) -= DSYTRF_EL_A(ii, k) * bkm1 + DSYTRF_EL_A(ii, k+1) * bk;
+						}
+					}
+				}
+			akm1k = DSYTRF_EL_A(k+1, k);
+			akm1 = DSYTRF_EL_A(k, k) / akm1k;
+			ak = DSYTRF_EL_A(k+1, k+1) / akm1k;
+			denom = akm1*ak - 1.0;
+			for(jj=0; jj<n; jj++)
+				{
+				bkm1 = DSYTRF_EL_D(k, jj) / akm1k;
+				bk = DSYTRF_EL_D(k+1, jj) / akm1k;
+				DSYTRF_EL_D(k, jj) = (ak*bkm1 - bk) / denom;
+				DSYTRF_EL_D(k+1, jj) = (akm1*bk - bkm1) / denom;
+				}
+			k += 2;
+			}
+		}
+
+	// solve L^T * X = B
+	k = m-1;
+	while(k>=0)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			if(k<m-1)
+				blasfeo_hp_dgemm_tn(1, n, m-k-1, -1.0, sA, ai+k+1, aj+k, sD, di+k+1, dj, 1.0, sD, di+k, dj, sD, di+k, dj);
+			kp = ipiv[k];
+			if(kp!=k)
+				blasfeo_drowsw(n, sD, di+k, dj, sD, di+kp, dj);
+			k -= 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			if(k<m-1)
+				blasfeo_hp_dgemm_tn(2, n, m-k-1, -1.0, sA, ai+k+1, aj+k-1, sD, di+k+1, dj, 1.0, sD, di+k-1, dj, sD, di+k-1, dj);
+			kp = -ipiv[k]-1;
+			if(kp!=k)
+				blasfeo_drowsw(n, sD, di+k, dj, sD, di+kp, dj);
+			k -= 2;
+			}
+		}
+
+	return;
+
+	}
+
+#undef DSYTRF_EL_A
+#undef DSYTRF_EL_D
+#undef DSYTRF_EL_W
+
+
+
+// T <= inv( L ), L the m x m lower triangular block of D at (di,dj) (with unit diagonal if unit!=0), T dense with zero upper part
+static void dtrinv_l_lib8(int m, int unit, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dmat *sT)
+	{
+	int ii, jj, ll;
+	double tmp, d_jj;
+	blasfeo_dgese(m, m, 0.0, sT, 0, 0);
+	for(jj=m-1; jj>=0; jj--)
+		{
+		d_jj = unit ? 1.0 : 1.0/BLASFEO_DMATEL(sD, di+jj, dj+jj);
+		BLASFEO_DMATEL(sT, jj, jj) = d_jj;
+		for(ii=m-1; ii>jj; ii--)
+			{
+			tmp = 0.0;
+			for(ll=jj+1; ll<=ii; ll++)
+				tmp += BLASFEO_DMATEL(sT, ii, ll) * BLASFEO_DMATEL(sD, di+ll, dj+jj);
+			BLASFEO_DMATEL(sT, ii, jj) = - tmp * d_jj;
+			}
+		}
+	return;
+	}
+
+
+
+// B <= A^T, A upper (if upper!=0) or lower triangular, element-wise since the lib8 triangular transpose kernels do not handle all offsets
+static void dtrtr_lib8(int m, int upper, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj)
+	{
+	int ii, jj;
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=upper ? 0 : jj; ii<(upper ? jj+1 : m); ii++)
+			BLASFEO_DMATEL(sB, bi+jj, bj+ii) = BLASFEO_DMATEL(sA, ai+ii, aj+jj);
+		}
+	return;
+	}
+
+
+
+// inverse of a lower triangular matrix, blocked by rows
+void blasfeo_hp_dtrtri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	if(sA!=sD | ai!=di | aj!=dj)
+		blasfeo_dtrcp_l(m, sA, ai, aj, sD, di, dj);
+
+	const int ps = 8;
+	const int nb = 32;
+
+	int j, jb, woff;
+
+	struct blasfeo_dmat sW, sT;
+	int w_size = blasfeo_memsize_dmat(nb+ps, m);
+	int t_size = blasfeo_memsize_dmat(nb, nb);
+	void *mem;
+	blasfeo_malloc_align(&mem, w_size+t_size);
+	blasfeo_create_dmat(nb+ps, m, &sW, mem);
+	blasfeo_create_dmat(nb, nb, &sT, (char *) mem+w_size);
+
+	for(j=0; j<m; j+=nb)
+		{
+		jb = m-j<nb ? m-j : nb;
+		// D(j:j+jb,j:j+jb) <= inv( A(j:j+jb,j:j+jb) )
+		dtrinv_l_lib8(jb, 0, sD, di+j, dj+j, &sT);
+		blasfeo_dtrcp_l(jb, &sT, 0, 0, sD, di+j, dj+j);
+		if(j>0)
+			{
+			// W <= A(j:j+jb,0:j) * inv( A(0:j,0:j) ), with W row offset within the panel matching the one of D
+			woff = (di+j)&(ps-1);
+			blasfeo_hp_dtrmm_rlnn(jb, j, 1.0, sD, di, dj, sD, di+j, dj, &sW, woff, 0);
+			// D(j:j+jb,0:j) <= - inv( A(j:j+jb,j:j+jb) ) * W
+			blasfeo_hp_dgemm_nn(jb, j, jb, -1.0, &sT, 0, 0, &sW, woff, 0, 0.0, sD, di+j, dj, sD, di+j, dj);
+			}
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of an upper triangular matrix, as the transpose of the inverse of its lower triangular transpose
+void blasfeo_hp_dtrtri_u(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	struct blasfeo_dmat sL;
+	void *mem;
+	blasfeo_malloc_align(&mem, blasfeo_memsize_dmat(m, m));
+	blasfeo_create_dmat(m, m, &sL, mem);
+
+	dtrtr_lib8(m, 1, sA, ai, aj, &sL, 0, 0);
+	blasfeo_hp_dtrtri_l(m, &sL, 0, 0, &sL, 0, 0);
+	// the strictly lower part of D is not accessed
+	dtrtr_lib8(m, 0, &sL, 0, 0, sD, di, dj);
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of a SPD matrix from its lower Cholesky factor, as inv( A )^T * inv( A ) by block rows
+void blasfeo_hp_dpotri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// D <= X = inv( A )
+	blasfeo_hp_dtrtri_l(m, sA, ai, aj, sD, di, dj);
+
+	const int nb = 32;
+
+	int i, ib, ii, jj;
+
+	struct blasfeo_dmat sWt, sZ;
+	int w_size = blasfeo_memsize_dmat(nb, m);
+	void *mem;
+	blasfeo_malloc_align(&mem, 2*w_size);
+	blasfeo_create_dmat(nb, m, &sWt, mem);
+	blasfeo_create_dmat(nb, m, &sZ, (char *) mem+w_size);
+
+	for(i=0; i<m; i+=nb)
+		{
+		ib = m-i<nb ? m-i : nb;
+		// Wt <= X(i:m,i:i+ib)^T, with zero strictly lower part of the diagonal block
+		blasfeo_dgetr(m-i, ib, sD, di+i, dj+i, &sWt, 0, 0);
+		for(jj=0; jj<ib; jj++)
+			for(ii=jj+1; ii<ib; ii++)
+				BLASFEO_DMATEL(&sWt, ii, jj) = 0.0;
+		if(i>0)
+			{
+			// D(i:i+ib,0:i) <= Wt * X(i:m,0:i)
+			blasfeo_hp_dgemm_nn(ib, i, m-i, 1.0, &sWt, 0, 0, sD, di+i, dj, 0.0, sD, di+i, dj, &sZ, 0, 0);
+			blasfeo_dgecp(ib, i, &sZ, 0, 0, sD, di+i, dj);
+			}
+		// D(i:i+ib,i:i+ib) <= Wt * Wt^T
+		blasfeo_hp_dsyrk_ln(ib, m-i, 1.0, &sWt, 0, 0, &sWt, 0, 0, 0.0, sD, di+i, dj+i, sD, di+i, dj+i);
+		}
+
+	blasfeo_free_align(mem);
+
+	return;
+
+	}
+
+
+
+// inverse of a general matrix from its LU factorization with row pivoting, solving inv( A ) * L = inv( U ) by block columns
+void blasfeo_hp_dgetri(int m, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sD, int di, int dj)
+	{
+
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	if(sA!=sD | ai!=di | aj!=dj)
+		blasfeo_dgecp(m, m, sA, ai, aj, sD, di, dj);
+
+	// D upper <= inv( U )
+	blasfeo_hp_dtrtri_u(m, sD, di, dj, sD, di, dj);
+
+	const int ps = 8;
+	const int nb = 32;
+
+	int j, jb, ii, jj, zoff;
+
+	struct blasfeo_dmat sW, sZ, sT;
+	int w_size = blasfeo_memsize_dmat(m, nb);
+	int z_size = blasfeo_memsize_dmat(m+ps, nb);
+	int t_size = blasfeo_memsize_dmat(nb, nb);
+	void *mem;
+	blasfeo_malloc_align(&mem, w_size+z_size+t_size);
+	blasfeo_create_dmat(m, nb, &sW, mem);
+	blasfeo_create_dmat(m+ps, nb, &sZ, (char *) mem+w_size);
+	blasfeo_create_dmat(nb, nb, &sT, (char *) mem+w_size+z_size);
+
+	// Z row offset within the panel matching the one of D
+	zoff = di&(ps-1);
+
+	for(j=(m-1)/nb*nb; j>=0; j-=nb)
+		{
+		jb = m-j<nb ? m-j : nb;
+		// T <= inv( L(j:j+jb,j:j+jb) )
+		dtrinv_l_lib8(jb, 1, sD, di+j, dj+j, &sT);
+		// W <= L(j+jb:m,j:j+jb), then zero the strictly lower part of D(:,j:j+jb)
+		for(jj=0; jj<jb; jj++)
+			for(ii=jj+1; ii<jb; ii++)
+				BLASFEO_DMATEL(sD, di+j+ii, dj+j+jj) = 0.0;
+		if(j+jb<m)
+			{
+			blasfeo_dgecp(m-j-jb, jb, sD, di+j+jb, dj+j, &sW, 0, 0);
+			blasfeo_dgese(m-j-jb, jb, 0.0, sD, di+j+jb, dj+j);
+			// Z <= D(:,j:j+jb) - D(:,j+jb:m) * W
+			blasfeo_hp_dgemm_nn(m, jb, m-j-jb, -1.0, sD, di, dj+j+jb, &sW, 0, 0, 1.0, sD, di, dj+j, &sZ, zoff, 0);
+			}
+		else
+			{
+			blasfeo_dgecp(m, jb, sD, di, dj+j, &sZ, zoff, 0);
+			}
+		// D(:,j:j+jb) <= Z * T
+		blasfeo_hp_dgemm_nn(m, jb, jb, 1.0, &sZ, zoff, 0, &sT, 0, 0, 0.0, sD, di, dj+j, sD, di, dj+j);
+		}
+
+	blasfeo_free_align(mem);
+
+	// apply the column interchanges in reverse order
+	for(j=m-2; j>=0; j--)
+		{
+		if(ipiv[j]!=j)
+			blasfeo_dcolsw(m, sD, di, dj+j, sD, di, dj+ipiv[j]);
+		}
+
+	return;
+
+	}
+
+
+
 #if defined(LA_HIGH_PERFORMANCE)
 
 
 
 void blasfeo_dpotrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DPOTRF_L, m, m, 0, 0.0, NULL, 0, 0, NULL, 0, 0, 0.0, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DPOTRF_L, m, m, 0);
 	blasfeo_hp_dpotrf_l(m, sC, ci, cj, sD, di, dj);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -1486,6 +2253,7 @@ void blasfeo_dpotrf_u(int m, struct blasfeo_dmat *sC, int ci, int cj, struct bla
 
 void blasfeo_dsyrk_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj)
 	{
+	BLASFEO_GRAPH_RECORD_M(BLASFEO_GRAPH_DSYRK_DPOTRF_LN, m, m, k, 0.0, sA, ai, aj, sB, bi, bj, 0.0, sC, ci, cj, sD, di, dj);
 	blasfeo_hp_dsyrk_dpotrf_ln(m, k, sA, ai, aj, sB, bi, bj, sC, ci, cj, sD, di, dj);
 	}
 
@@ -1507,7 +2275,9 @@ void blasfeo_dgetrf_np(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, st
 
 void blasfeo_dgetrf_rp(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
 	{
+	BLASFEO_PROFILE_START(BLASFEO_PROFILE_DGETRF_RP, m, n, 0);
 	blasfeo_hp_dgetrf_rp(m, n, sC, ci, cj, sD, di, dj, ipiv);
+	BLASFEO_PROFILE_END();
 	}
 
 
@@ -1575,5 +2345,61 @@ void blasfeo_dgelqf_pd_lla(int m, int n1, struct blasfeo_dmat *sD, int di, int d
 
 
 
+void blasfeo_dchud_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dchud_l(m, k, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dchdd_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dchdd_l(m, k, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dsytrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv)
+	{
+	blasfeo_hp_dsytrf_l(m, sC, ci, cj, sD, di, dj, ipiv);
+	}
+
+
+
+void blasfeo_dsytrs_l(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dsytrs_l(m, n, sA, ai, aj, ipiv, sB, bi, bj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dtrtri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dtrtri_l(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dtrtri_u(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dtrtri_u(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dpotri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dpotri_l(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void blasfeo_dgetri(int m, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sD, int di, int dj)
+	{
+	blasfeo_hp_dgetri(m, sA, ai, aj, ipiv, sD, di, dj);
+	}
+
+
+
 #endif
 
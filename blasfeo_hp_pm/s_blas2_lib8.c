@@ -1175,6 +1175,47 @@ void blasfeo_hp_sger(int m, int n, float alpha, struct blasfeo_svec *sx, int xi,
 
 
 
+// multiple right-hand sides: sx, sy and sz are arrays of k vectors
+void blasfeo_hp_sgemv_n_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_sgemv_n(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_sgemv_t_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_sgemv_t(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_strsv_lnn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_strsv_lnn(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
+
+void blasfeo_hp_strsv_ltn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		blasfeo_hp_strsv_ltn(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
+
 #if defined(LA_HIGH_PERFORMANCE)
 
 
@@ -1326,4 +1367,32 @@ void blasfeo_sger(int m, int n, float alpha, struct blasfeo_svec *sx, int xi, st
 
 
 
+void blasfeo_sgemv_n_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi)
+	{
+	blasfeo_hp_sgemv_n_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_sgemv_t_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi)
+	{
+	blasfeo_hp_sgemv_t_k(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void blasfeo_strsv_lnn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi)
+	{
+	blasfeo_hp_strsv_lnn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
+void blasfeo_strsv_ltn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi)
+	{
+	blasfeo_hp_strsv_ltn_k(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
 #endif
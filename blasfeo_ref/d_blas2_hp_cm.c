@@ -85,6 +85,10 @@
 #define REF_TRSV_UNN blasfeo_hp_dtrsv_unn
 #define REF_TRSV_UTN blasfeo_hp_dtrsv_utn
 #define REF_GER blasfeo_hp_dger
+#define REF_GEMV_N_K blasfeo_hp_dgemv_n_k
+#define REF_GEMV_T_K blasfeo_hp_dgemv_t_k
+#define REF_TRSV_LNN_K blasfeo_hp_dtrsv_lnn_k
+#define REF_TRSV_LTN_K blasfeo_hp_dtrsv_ltn_k
 
 #define GEMV_N blasfeo_dgemv_n
 #define GEMV_NT blasfeo_dgemv_nt
@@ -105,6 +109,10 @@
 #define TRSV_UNN blasfeo_dtrsv_unn
 #define TRSV_UTN blasfeo_dtrsv_utn
 #define GER blasfeo_dger
+#define GEMV_N_K blasfeo_dgemv_n_k
+#define GEMV_T_K blasfeo_dgemv_t_k
+#define TRSV_LNN_K blasfeo_dtrsv_lnn_k
+#define TRSV_LTN_K blasfeo_dtrsv_ltn_k
 
 
 
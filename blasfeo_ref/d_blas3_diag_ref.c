@@ -37,10 +37,12 @@
 #include <stdio.h>
 
 #include <blasfeo_common.h>
+#include <blasfeo_d_blasfeo_ref_api.h>
 
 
 
 #define REF
+#define DP
 
 
 
@@ -68,9 +70,14 @@
 
 #define REF_GEMM_R_DIAG blasfeo_ref_dgemm_nd
 #define REF_GEMM_L_DIAG blasfeo_ref_dgemm_dn
+#define REF_SYRK_DIAG_LN blasfeo_ref_dsyrk_diag_ln
+#define REF_SYRK_DIAG_POTRF_LN blasfeo_ref_dsyrk_diag_dpotrf_ln
+#define REF_POTRF_L blasfeo_ref_dpotrf_l
 
 #define GEMM_R_DIAG blasfeo_dgemm_nd
 #define GEMM_L_DIAG blasfeo_dgemm_dn
+#define SYRK_DIAG_LN blasfeo_dsyrk_diag_ln
+#define SYRK_DIAG_POTRF_LN blasfeo_dsyrk_diag_dpotrf_ln
 
 
 
@@ -93,6 +93,8 @@
 #define REF_PSTRF_L blasfeo_hp_dpstrf_l
 #define REF_SYRK_POTRF_LN blasfeo_hp_dsyrk_dpotrf_ln
 #define REF_SYRK_POTRF_LN_MN blasfeo_hp_dsyrk_dpotrf_ln_mn
+#define REF_CHUD_L blasfeo_hp_dchud_l
+#define REF_CHDD_L blasfeo_hp_dchdd_l
 
 #define GELQF_WORK_SIZE blasfeo_dgelqf_worksize
 #define GELQF blasfeo_dgelqf
@@ -112,6 +114,8 @@
 #define PSTRF_L blasfeo_dpstrf_l
 #define SYRK_POTRF_LN blasfeo_dsyrk_dpotrf_ln
 #define SYRK_POTRF_LN_MN blasfeo_dsyrk_dpotrf_ln_mn
+#define CHUD_L blasfeo_dchud_l
+#define CHDD_L blasfeo_dchdd_l
 
 
 
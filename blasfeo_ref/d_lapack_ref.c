@@ -43,6 +43,7 @@
 
 
 #define REF
+#define DP
 
 
 
@@ -92,6 +93,14 @@
 #define REF_PSTRF_L blasfeo_ref_dpstrf_l
 #define REF_SYRK_POTRF_LN blasfeo_ref_dsyrk_dpotrf_ln
 #define REF_SYRK_POTRF_LN_MN blasfeo_ref_dsyrk_dpotrf_ln_mn
+#define REF_CHUD_L blasfeo_ref_dchud_l
+#define REF_CHDD_L blasfeo_ref_dchdd_l
+#define REF_SYTRF_L blasfeo_ref_dsytrf_l
+#define REF_SYTRS_L blasfeo_ref_dsytrs_l
+#define REF_TRTRI_L blasfeo_ref_dtrtri_l
+#define REF_TRTRI_U blasfeo_ref_dtrtri_u
+#define REF_POTRI_L blasfeo_ref_dpotri_l
+#define REF_GETRI blasfeo_ref_dgetri
 
 #define GELQF_WORK_SIZE blasfeo_dgelqf_worksize
 #define GELQF blasfeo_dgelqf
@@ -111,6 +120,14 @@
 #define PSTRF_L blasfeo_dpstrf_l
 #define SYRK_POTRF_LN blasfeo_dsyrk_dpotrf_ln
 #define SYRK_POTRF_LN_MN blasfeo_dsyrk_dpotrf_ln_mn
+#define CHUD_L blasfeo_dchud_l
+#define CHDD_L blasfeo_dchdd_l
+#define SYTRF_L blasfeo_dsytrf_l
+#define SYTRS_L blasfeo_dsytrs_l
+#define TRTRI_L blasfeo_dtrtri_l
+#define TRTRI_U blasfeo_dtrtri_u
+#define POTRI_L blasfeo_dpotri_l
+#define GETRI blasfeo_dgetri
 
 
 
@@ -66,12 +66,24 @@
 #define REF_POTRF_L blasfeo_hp_cm_dpotrf_l
 #define REF_POTRF_U blasfeo_hp_cm_dpotrf_u
 #define REF_GETRF_ROWPIVOT blasfeo_hp_cm_dgetrf_rp
+#define REF_SYTRF_L blasfeo_hp_cm_dsytrf_l
+#define REF_SYTRS_L blasfeo_hp_cm_dsytrs_l
+#define REF_TRTRI_L blasfeo_hp_cm_dtrtri_l
+#define REF_TRTRI_U blasfeo_hp_cm_dtrtri_u
+#define REF_POTRI_L blasfeo_hp_cm_dpotri_l
+#define REF_GETRI blasfeo_hp_cm_dgetri
 
 
 // gemm
 #define POTRF_L blasfeo_cm_dpotrf_l
 #define POTRF_U blasfeo_cm_dpotrf_u
 #define GETRF_ROWPIVOT blasfeo_cm_dgetrf_rp
+#define SYTRF_L blasfeo_cm_dsytrf_l
+#define SYTRS_L blasfeo_cm_dsytrs_l
+#define TRTRI_L blasfeo_cm_dtrtri_l
+#define TRTRI_U blasfeo_cm_dtrtri_u
+#define POTRI_L blasfeo_cm_dpotri_l
+#define GETRI blasfeo_cm_dgetri
 
 
 
@@ -83,6 +83,10 @@
 #define REF_TRSV_UNN blasfeo_ref_strsv_unn
 #define REF_TRSV_UTN blasfeo_ref_strsv_utn
 #define REF_GER blasfeo_ref_sger
+#define REF_GEMV_N_K blasfeo_ref_sgemv_n_k
+#define REF_GEMV_T_K blasfeo_ref_sgemv_t_k
+#define REF_TRSV_LNN_K blasfeo_ref_strsv_lnn_k
+#define REF_TRSV_LTN_K blasfeo_ref_strsv_ltn_k
 
 #define GEMV_N blasfeo_sgemv_n
 #define GEMV_NT blasfeo_sgemv_nt
@@ -103,6 +107,10 @@
 #define TRSV_UNN blasfeo_strsv_unn
 #define TRSV_UTN blasfeo_strsv_utn
 #define GER blasfeo_sger
+#define GEMV_N_K blasfeo_sgemv_n_k
+#define GEMV_T_K blasfeo_sgemv_t_k
+#define TRSV_LNN_K blasfeo_strsv_lnn_k
+#define TRSV_LTN_K blasfeo_strsv_ltn_k
 
 
 
@@ -1499,6 +1499,55 @@ void REF_GER(int m, int n, REAL alpha, struct XVEC *sx, int xi, struct XVEC *sy,
 
 
 
+// multiple right-hand sides: sx, sy and sz are arrays of k vectors
+void REF_GEMV_N_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		{
+		REF_GEMV_N(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+		}
+	return;
+	}
+
+
+
+void REF_GEMV_T_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		{
+		REF_GEMV_T(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+		}
+	return;
+	}
+
+
+
+void REF_TRSV_LNN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		{
+		REF_TRSV_LNN(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+		}
+	return;
+	}
+
+
+
+void REF_TRSV_LTN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		{
+		REF_TRSV_LTN(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+		}
+	return;
+	}
+
+
+
 #if (defined(LA_REFERENCE) & defined(REF)) | (defined(LA_HIGH_PERFORMANCE) & defined(HP_CM))
 
 
@@ -1646,4 +1695,32 @@ void GER(int m, int n, REAL alpha, struct XVEC *sx, int xi, struct XVEC *sy, int
 
 
 
+void GEMV_N_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	REF_GEMV_N_K(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void GEMV_T_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	REF_GEMV_T_K(m, n, k, alpha, sA, ai, aj, sx, xi, beta, sy, yi, sz, zi);
+	}
+
+
+
+void TRSV_LNN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	REF_TRSV_LNN_K(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
+void TRSV_LTN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	REF_TRSV_LTN_K(m, k, sA, ai, aj, sx, xi, sz, zi);
+	}
+
+
+
 #endif
@@ -187,6 +187,75 @@ void REF_GEMM_R_DIAG(int m, int n, REAL alpha, struct XMAT *sA, int ai, int aj,
 
 
 
+#if defined(DP) & ! defined(HP_CM)
+
+
+
+// dsyrk with A scaled by a diagonal matrix (stored as strvec), lower triangle
+void REF_SYRK_DIAG_LN(int m, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, REAL beta, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, kk;
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldc = sC->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pB = sB->pA + bi + bj*ldb;
+	REAL *pC = sC->pA + ci + cj*ldc;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int bbi=0; const int bbj=0;
+	const int cci=0; const int ccj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int bbi=bi; int bbj=bj;
+	int cci=ci; int ccj=cj;
+	int ddi=di; int ddj=dj;
+#endif
+	REAL *x = sx->pa + xi;
+	REAL c_00;
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=jj; ii<m; ii++)
+			{
+			c_00 = 0.0;
+			for(kk=0; kk<k; kk++)
+				{
+				c_00 += XMATEL_A(aai+ii, aaj+kk) * x[kk] * XMATEL_B(bbi+jj, bbj+kk);
+				}
+			XMATEL_D(ddi+ii, ddj+jj) = beta * XMATEL_C(cci+ii, ccj+jj) + alpha * c_00;
+			}
+		}
+	return;
+	}
+
+
+
+// dsyrk_diag_ln with alpha=1.0 and beta=1.0, followed by the lower Cholesky factorization
+void REF_SYRK_DIAG_POTRF_LN(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	REF_SYRK_DIAG_LN(m, k, 1.0, sA, ai, aj, sx, xi, sB, bi, bj, 1.0, sC, ci, cj, sD, di, dj);
+	REF_POTRF_L(m, sD, di, dj, sD, di, dj);
+	return;
+	}
+
+
+
+#endif
+
+
+
 #if (defined(LA_REFERENCE) & defined(REF)) | (defined(LA_HIGH_PERFORMANCE) & defined(HP_CM))
 
 
@@ -205,4 +274,26 @@ void GEMM_R_DIAG(int m, int n, REAL alpha, struct XMAT *sA, int ai, int aj, stru
 
 
 
+#if defined(DP) & ! defined(HP_CM)
+
+
+
+void SYRK_DIAG_LN(int m, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, REAL beta, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	REF_SYRK_DIAG_LN(m, k, alpha, sA, ai, aj, sx, xi, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+	}
+
+
+
+void SYRK_DIAG_POTRF_LN(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	REF_SYRK_DIAG_POTRF_LN(m, k, sA, ai, aj, sx, xi, sB, bi, bj, sC, ci, cj, sD, di, dj);
+	}
+
+
+
+#endif
+
+
+
 #endif
@@ -3264,6 +3264,646 @@ void REF_GELQF_PD_LLA(int m, int n1, struct XMAT *sD, int di, int dj, struct XMA
 
 
 
+#if defined(DP) & ! ( defined(REF_BLAS) )
+// D <= chol( D * D^T + A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+void REF_CHUD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll;
+	REAL d_jj, a_jl, r, c, s, d_tmp;
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int ddi=di; int ddj=dj;
+#endif
+	REAL *dD = sD->dA;
+	if(di==0 & dj==0)
+		sD->use_dA = 1;
+	else
+		sD->use_dA = 0;
+	for(jj=0; jj<m; jj++)
+		{
+		d_jj = XMATEL_D(ddi+jj, ddj+jj);
+		// Givens rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			a_jl = XMATEL_A(aai+jj, aaj+ll);
+			if(a_jl==0.0)
+				continue;
+			r = SQRT(d_jj*d_jj + a_jl*a_jl);
+			c = d_jj / r;
+			s = a_jl / r;
+			d_jj = r;
+			XMATEL_A(aai+jj, aaj+ll) = 0.0;
+			for(ii=jj+1; ii<m; ii++)
+				{
+				d_tmp = c * XMATEL_D(ddi+ii, ddj+jj) + s * XMATEL_A(aai+ii, aaj+ll);
+				XMATEL_A(aai+ii, aaj+ll) = c * XMATEL_A(aai+ii, aaj+ll) - s * XMATEL_D(ddi+ii, ddj+jj);
+				XMATEL_D(ddi+ii, ddj+jj) = d_tmp;
+				}
+			}
+		XMATEL_D(ddi+jj, ddj+jj) = d_jj;
+		if(di==0 & dj==0)
+			dD[jj] = d_jj>0.0 ? 1.0/d_jj : 0.0;
+		}
+	return;
+	}
+
+
+
+// D <= chol( D * D^T - A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+// if the result is not positive definite, the failing columns of D are set to zero
+void REF_CHDD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll;
+	REAL d_jj, a_jl, r, r2, c, s, d_tmp;
+#if defined(MF_COLMAJ)
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int ddi=di; int ddj=dj;
+#endif
+	REAL *dD = sD->dA;
+	if(di==0 & dj==0)
+		sD->use_dA = 1;
+	else
+		sD->use_dA = 0;
+	for(jj=0; jj<m; jj++)
+		{
+		d_jj = XMATEL_D(ddi+jj, ddj+jj);
+		// hyperbolic rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			a_jl = XMATEL_A(aai+jj, aaj+ll);
+			if(a_jl==0.0)
+				continue;
+			r2 = (d_jj - a_jl) * (d_jj + a_jl);
+			if(!(r2>0.0))
+				{
+				d_jj = 0.0;
+				break;
+				}
+			r = SQRT(r2);
+			c = r / d_jj;
+			s = a_jl / d_jj;
+			d_jj = r;
+			XMATEL_A(aai+jj, aaj+ll) = 0.0;
+			// mixed form, numerically stable
+			for(ii=jj+1; ii<m; ii++)
+				{
+				d_tmp = (XMATEL_D(ddi+ii, ddj+jj) - s * XMATEL_A(aai+ii, aaj+ll)) / c;
+				XMATEL_A(aai+ii, aaj+ll) = c * XMATEL_A(aai+ii, aaj+ll) - s * d_tmp;
+				XMATEL_D(ddi+ii, ddj+jj) = d_tmp;
+				}
+			}
+		if(d_jj==0.0)
+			{
+			for(ii=jj+1; ii<m; ii++)
+				XMATEL_D(ddi+ii, ddj+jj) = 0.0;
+			}
+		XMATEL_D(ddi+jj, ddj+jj) = d_jj;
+		if(di==0 & dj==0)
+			dD[jj] = d_jj>0.0 ? 1.0/d_jj : 0.0;
+		}
+	return;
+	}
+#endif
+
+
+
+#if ( defined(REF) & defined(DP) ) | defined(REF_BLAS)
+// D <= ldl( C ), with Bunch-Kaufman pivoting; C, D lower triangular
+void REF_SYTRF_L(int m, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj, int *ipiv)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, k, kk, kp, kstep;
+	REAL alpha, absakk, colmax, rowmax, tmp, r1, d11, d21, d22, t, wk, wkp1;
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int ldc = sC->m;
+	int ldd = sD->m;
+	REAL *pC = sC->pA + ci + cj*ldc;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int cci=0; const int ccj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int cci=ci; int ccj=cj;
+	int ddi=di; int ddj=dj;
+#endif
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=jj; ii<m; ii++)
+			{
+			XMATEL_D(ddi+ii, ddj+jj) = XMATEL_C(cci+ii, ccj+jj);
+			}
+		}
+	alpha = (1.0+SQRT(17.0))/8.0;
+	k = 0;
+	while(k<m)
+		{
+		kstep = 1;
+		absakk = fabs(XMATEL_D(ddi+k, ddj+k));
+		kp = k;
+		colmax = 0.0;
+		for(ii=k+1; ii<m; ii++)
+			{
+			tmp = fabs(XMATEL_D(ddi+ii, ddj+k));
+			if(tmp>colmax)
+				{
+				colmax = tmp;
+				kp = ii;
+				}
+			}
+		if(absakk==0.0 & colmax==0.0)
+			{
+			// zero column: singular matrix, the column is left as it is
+			kp = k;
+			}
+		else
+			{
+			if(absakk>=alpha*colmax)
+				{
+				// no interchange, 1x1 pivot block
+				kp = k;
+				}
+			else
+				{
+				rowmax = 0.0;
+				for(jj=k; jj<kp; jj++)
+					{
+					tmp = fabs(XMATEL_D(ddi+kp, ddj+jj));
+					rowmax = tmp>rowmax ? tmp : rowmax;
+					}
+				for(ii=kp+1; ii<m; ii++)
+					{
+					tmp = fabs(XMATEL_D(ddi+ii, ddj+kp));
+					rowmax = tmp>rowmax ? tmp : rowmax;
+					}
+				if(absakk>=alpha*colmax*(colmax/rowmax))
+					{
+					// no interchange, 1x1 pivot block
+					kp = k;
+					}
+				else if(fabs(XMATEL_D(ddi+kp, ddj+kp))>=alpha*rowmax)
+					{
+					// interchange rows and columns k and kp, 1x1 pivot block
+					}
+				else
+					{
+					// interchange rows and columns k+1 and kp, 2x2 pivot block
+					kstep = 2;
+					}
+				}
+			kk = k+kstep-1;
+			if(kp!=kk)
+				{
+				// interchange rows and columns kk and kp in the trailing submatrix
+				for(ii=kp+1; ii<m; ii++)
+					{
+					tmp = XMATEL_D(ddi+ii, ddj+kk);
+					XMATEL_D(ddi+ii, ddj+kk) = XMATEL_D(ddi+ii, ddj+kp);
+					XMATEL_D(ddi+ii, ddj+kp) = tmp;
+					}
+				for(jj=kk+1; jj<kp; jj++)
+					{
+					tmp = XMATEL_D(ddi+jj, ddj+kk);
+					XMATEL_D(ddi+jj, ddj+kk) = XMATEL_D(ddi+kp, ddj+jj);
+					XMATEL_D(ddi+kp, ddj+jj) = tmp;
+					}
+				tmp = XMATEL_D(ddi+kk, ddj+kk);
+				XMATEL_D(ddi+kk, ddj+kk) = XMATEL_D(ddi+kp, ddj+kp);
+				XMATEL_D(ddi+kp, ddj+kp) = tmp;
+				if(kstep==2)
+					{
+					tmp = XMATEL_D(ddi+k+1, ddj+k);
+					XMATEL_D(ddi+k+1, ddj+k) = XMATEL_D(ddi+kp, ddj+k);
+					XMATEL_D(ddi+kp, ddj+k) = tmp;
+					}
+				}
+			if(kstep==1)
+				{
+				// rank-1 update of the trailing submatrix, and column k of L
+				if(k<m-1)
+					{
+					r1 = 1.0/XMATEL_D(ddi+k, ddj+k);
+					for(jj=k+1; jj<m; jj++)
+						{
+						tmp = - r1 * XMATEL_D(ddi+jj, ddj+k);
+						for(ii=jj; ii<m; ii++)
+							{
+							XMATEL_D(ddi+ii, ddj+jj) += XMATEL_D(ddi+ii, ddj+k) * tmp;
+							}
+						}
+					for(ii=k+1; ii<m; ii++)
+						{
+						XMATEL_D(ddi+ii, ddj+k) *= r1;
+						}
+					}
+				}
+			else
+				{
+				// rank-2 update of the trailing submatrix, and columns k and k+1 of L
+				if(k<m-2)
+					{
+					d21 = XMATEL_D(ddi+k+1, ddj+k);
+					d11 = XMATEL_D(ddi+k+1, ddj+k+1) / d21;
+					d22 = XMATEL_D(ddi+k, ddj+k) / d21;
+					t = 1.0 / (d11*d22 - 1.0);
+					d21 = t / d21;
+					for(jj=k+2; jj<m; jj++)
+						{
+						wk = d21 * (d11*XMATEL_D(ddi+jj, ddj+k) - XMATEL_D(ddi+jj, ddj+k+1));
+						wkp1 = d21 * (d22*XMATEL_D(ddi+jj, ddj+k+1) - XMATEL_D(ddi+jj, ddj+k));
+						for(ii=jj; ii<m; ii++)
+							{
+							XMATEL_D(ddi+ii, ddj+jj) -= XMATEL_D(ddi+ii, ddj+k) * wk + XMATEL_D(ddi+ii, ddj+k+1) * wkp1;
+							}
+						XMATEL_D(ddi+jj, ddj+k) = wk;
+						XMATEL_D(ddi+jj, ddj+k+1) = wkp1;
+						}
+					}
+				}
+			}
+		// 0-based pivot indices, negative for 2x2 pivot blocks
+		if(kstep==1)
+			{
+			ipiv[k] = kp;
+			}
+		else
+			{
+			ipiv[k] = -kp-1;
+			ipiv[k+1] = -kp-1;
+			}
+		k += kstep;
+		}
+	return;
+	}
+
+
+
+// D <= inv( A ) * B, with A factorized by sytrf_l
+void REF_SYTRS_L(int m, int n, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sB, int bi, int bj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0 | n<=0)
+		return;
+	int ii, jj, k, kp;
+	REAL tmp, akm1k, akm1, ak, denom, bkm1, bk;
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pB = sB->pA + bi + bj*ldb;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int bbi=0; const int bbj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int bbi=bi; int bbj=bj;
+	int ddi=di; int ddj=dj;
+#endif
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+	for(jj=0; jj<n; jj++)
+		{
+		for(ii=0; ii<m; ii++)
+			{
+			XMATEL_D(ddi+ii, ddj+jj) = XMATEL_B(bbi+ii, bbj+jj);
+			}
+		}
+	// solve L * D * X = B
+	k = 0;
+	while(k<m)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			kp = ipiv[k];
+			if(kp!=k)
+				{
+				for(jj=0; jj<n; jj++)
+					{
+					tmp = XMATEL_D(ddi+k, ddj+jj);
+					XMATEL_D(ddi+k, ddj+jj) = XMATEL_D(ddi+kp, ddj+jj);
+					XMATEL_D(ddi+kp, ddj+jj) = tmp;
+					}
+				}
+			tmp = 1.0/XMATEL_A(aai+k, aaj+k);
+			for(jj=0; jj<n; jj++)
+				{
+				for(ii=k+1; ii<m; ii++)
+					{
+					XMATEL_D(ddi+ii, ddj+jj) -= XMATEL_A(aai+ii, aaj+k) * XMATEL_D(ddi+k, ddj+jj);
+					}
+				XMATEL_D(ddi+k, ddj+jj) *= tmp;
+				}
+			k += 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			kp = -ipiv[k]-1;
+			if(kp!=k+1)
+				{
+				for(jj=0; jj<n; jj++)
+					{
+					tmp = XMATEL_D(ddi+k+1, ddj+jj);
+					XMATEL_D(ddi+k+1, ddj+jj) = XMATEL_D(ddi+kp, ddj+jj);
+					XMATEL_D(ddi+kp, ddj+jj) = tmp;
+					}
+				}
+			akm1k = XMATEL_A(aai+k+1, aaj+k);
+			akm1 = XMATEL_A(aai+k, aaj+k) / akm1k;
+			ak = XMATEL_A(aai+k+1, aaj+k+1) / akm1k;
+			denom = akm1*ak - 1.0;
+			for(jj=0; jj<n; jj++)
+				{
+				for(ii=k+2; ii<m; ii++)
+					{
+					XMATEL_D(ddi+ii, ddj+jj) -= XMATEL_A(aai+ii, aaj+k) * XMATEL_D(ddi+k, ddj+jj) + XMATEL_A(aai+ii, aaj+k+1) * XMATEL_D(ddi+k+1, ddj+jj);
+					}
+				bkm1 = XMATEL_D(ddi+k, ddj+jj) / akm1k;
+				bk = XMATEL_D(ddi+k+1, ddj+jj) / akm1k;
+				XMATEL_D(ddi+k, ddj+jj) = (ak*bkm1 - bk) / denom;
+				XMATEL_D(ddi+k+1, ddj+jj) = (akm1*bk - bkm1) / denom;
+				}
+			k += 2;
+			}
+		}
+	// solve L^T * X = B
+	k = m-1;
+	while(k>=0)
+		{
+		if(ipiv[k]>=0)
+			{
+			// 1x1 pivot block
+			for(jj=0; jj<n; jj++)
+				{
+				tmp = XMATEL_D(ddi+k, ddj+jj);
+				for(ii=k+1; ii<m; ii++)
+					{
+					tmp -= XMATEL_A(aai+ii, aaj+k) * XMATEL_D(ddi+ii, ddj+jj);
+					}
+				XMATEL_D(ddi+k, ddj+jj) = tmp;
+				}
+			kp = ipiv[k];
+			if(kp!=k)
+				{
+				for(jj=0; jj<n; jj++)
+					{
+					tmp = XMATEL_D(ddi+k, ddj+jj);
+					XMATEL_D(ddi+k, ddj+jj) = XMATEL_D(ddi+kp, ddj+jj);
+					XMATEL_D(ddi+kp, ddj+jj) = tmp;
+					}
+				}
+			k -= 1;
+			}
+		else
+			{
+			// 2x2 pivot block
+			for(jj=0; jj<n; jj++)
+				{
+				bkm1 = XMATEL_D(ddi+k-1, ddj+jj);
+				bk = XMATEL_D(ddi+k, ddj+jj);
+				for(ii=k+1; ii<m; ii++)
+					{
+					bkm1 -= XMATEL_A(aai+ii, aaj+k-1) * XMATEL_D(ddi+ii, ddj+jj);
+					bk -= XMATEL_A(aai+ii, aaj+k) * XMATEL_D(ddi+ii, ddj+jj);
+					}
+				XMATEL_D(ddi+k-1, ddj+jj) = bkm1;
+				XMATEL_D(ddi+k, ddj+jj) = bk;
+				}
+			kp = -ipiv[k]-1;
+			if(kp!=k)
+				{
+				for(jj=0; jj<n; jj++)
+					{
+					tmp = XMATEL_D(ddi+k, ddj+jj);
+					XMATEL_D(ddi+k, ddj+jj) = XMATEL_D(ddi+kp, ddj+jj);
+					XMATEL_D(ddi+kp, ddj+jj) = tmp;
+					}
+				}
+			k -= 2;
+			}
+		}
+	return;
+	}
+
+
+
+// D <= inv( A ), with A lower triangular
+void REF_TRTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll;
+	REAL tmp, ajj;
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int ddi=di; int ddj=dj;
+#endif
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=jj; ii<m; ii++)
+			{
+			XMATEL_D(ddi+ii, ddj+jj) = XMATEL_A(aai+ii, aaj+jj);
+			}
+		}
+	for(jj=m-1; jj>=0; jj--)
+		{
+		XMATEL_D(ddi+jj, ddj+jj) = 1.0 / XMATEL_D(ddi+jj, ddj+jj);
+		ajj = - XMATEL_D(ddi+jj, ddj+jj);
+		// D(jj+1:m,jj) <= - inv( A(jj+1:m,jj+1:m) ) * A(jj+1:m,jj) / A(jj,jj), bottom-up to keep the column in place
+		for(ii=m-1; ii>jj; ii--)
+			{
+			tmp = 0.0;
+			for(ll=jj+1; ll<=ii; ll++)
+				{
+				tmp += XMATEL_D(ddi+ii, ddj+ll) * XMATEL_D(ddi+ll, ddj+jj);
+				}
+			XMATEL_D(ddi+ii, ddj+jj) = ajj * tmp;
+			}
+		}
+	return;
+	}
+
+
+
+// D <= inv( A ), with A upper triangular
+void REF_TRTRI_U(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll;
+	REAL tmp, ajj;
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int ddi=di; int ddj=dj;
+#endif
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=0; ii<=jj; ii++)
+			{
+			XMATEL_D(ddi+ii, ddj+jj) = XMATEL_A(aai+ii, aaj+jj);
+			}
+		}
+	for(jj=0; jj<m; jj++)
+		{
+		XMATEL_D(ddi+jj, ddj+jj) = 1.0 / XMATEL_D(ddi+jj, ddj+jj);
+		ajj = - XMATEL_D(ddi+jj, ddj+jj);
+		// D(0:jj,jj) <= - inv( A(0:jj,0:jj) ) * A(0:jj,jj) / A(jj,jj), top-down to keep the column in place
+		for(ii=0; ii<jj; ii++)
+			{
+			tmp = 0.0;
+			for(ll=ii; ll<jj; ll++)
+				{
+				tmp += XMATEL_D(ddi+ii, ddj+ll) * XMATEL_D(ddi+ll, ddj+jj);
+				}
+			XMATEL_D(ddi+ii, ddj+jj) = ajj * tmp;
+			}
+		}
+	return;
+	}
+
+
+
+// D <= inv( A * A^T ), with A lower triangular (Cholesky factor); D lower triangular
+void REF_POTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll;
+	REAL tmp;
+	REF_TRTRI_L(m, sA, ai, aj, sD, di, dj);
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int ldd = sD->m;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int ddi=0; const int ddj=0;
+#else
+	int ddi=di; int ddj=dj;
+#endif
+	// D <= inv( A )^T * inv( A ), row by row; the diagonal element is computed last
+	for(ii=0; ii<m; ii++)
+		{
+		for(jj=0; jj<=ii; jj++)
+			{
+			tmp = 0.0;
+			for(ll=ii; ll<m; ll++)
+				{
+				tmp += XMATEL_D(ddi+ll, ddj+ii) * XMATEL_D(ddi+ll, ddj+jj);
+				}
+			XMATEL_D(ddi+ii, ddj+jj) = tmp;
+			}
+		}
+	return;
+	}
+
+
+
+// D <= inv( A ), with A factorized by getrf_rp
+void REF_GETRI(int m, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+	int ii, jj, ll, jp;
+	REAL tmp;
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+#if defined(MF_COLMAJ) | defined(REF_BLAS)
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pD = sD->pA + di + dj*ldd;
+	const int aai=0; const int aaj=0;
+	const int ddi=0; const int ddj=0;
+#else
+	int aai=ai; int aaj=aj;
+	int ddi=di; int ddj=dj;
+#endif
+	for(jj=0; jj<m; jj++)
+		{
+		for(ii=0; ii<m; ii++)
+			{
+			XMATEL_D(ddi+ii, ddj+jj) = XMATEL_A(aai+ii, aaj+jj);
+			}
+		}
+	// inv( U )
+	REF_TRTRI_U(m, sD, di, dj, sD, di, dj);
+	// solve inv( A ) * L = inv( U ), the strictly lower part of the column jj of L is moved to work
+	REAL *work = malloc(m*sizeof(REAL));
+	for(jj=m-2; jj>=0; jj--)
+		{
+		for(ii=jj+1; ii<m; ii++)
+			{
+			work[ii] = XMATEL_D(ddi+ii, ddj+jj);
+			XMATEL_D(ddi+ii, ddj+jj) = 0.0;
+			}
+		for(ii=0; ii<m; ii++)
+			{
+			tmp = XMATEL_D(ddi+ii, ddj+jj);
+			for(ll=jj+1; ll<m; ll++)
+				{
+				tmp -= XMATEL_D(ddi+ii, ddj+ll) * work[ll];
+				}
+			XMATEL_D(ddi+ii, ddj+jj) = tmp;
+			}
+		}
+	free(work);
+	// apply the column interchanges in reverse order
+	for(jj=m-2; jj>=0; jj--)
+		{
+		jp = ipiv[jj];
+		if(jp!=jj)
+			{
+			for(ii=0; ii<m; ii++)
+				{
+				tmp = XMATEL_D(ddi+ii, ddj+jj);
+				XMATEL_D(ddi+ii, ddj+jj) = XMATEL_D(ddi+ii, ddj+jp);
+				XMATEL_D(ddi+ii, ddj+jp) = tmp;
+				}
+			}
+		}
+	return;
+	}
+#endif
+
+
+
 #if (defined(LA_REFERENCE) & defined(REF)) | (defined(LA_HIGH_PERFORMANCE) & defined(HP_CM)) | (defined(REF_BLAS))
 
 
@@ -3336,6 +3976,66 @@ void PSTRF_L(int m, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, in
 
 
 
+#if defined(DP) & ! ( defined(REF_BLAS) )
+void CHUD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	REF_CHUD_L(m, k, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void CHDD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	REF_CHDD_L(m, k, sA, ai, aj, sD, di, dj);
+	}
+#endif
+
+
+
+#if ( defined(REF) & defined(DP) ) | defined(REF_BLAS)
+void SYTRF_L(int m, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj, int *ipiv)
+	{
+	REF_SYTRF_L(m, sC, ci, cj, sD, di, dj, ipiv);
+	}
+
+
+
+void SYTRS_L(int m, int n, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sB, int bi, int bj, struct XMAT *sD, int di, int dj)
+	{
+	REF_SYTRS_L(m, n, sA, ai, aj, ipiv, sB, bi, bj, sD, di, dj);
+	}
+
+
+
+void TRTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	REF_TRTRI_L(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void TRTRI_U(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	REF_TRTRI_U(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void POTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	REF_POTRI_L(m, sA, ai, aj, sD, di, dj);
+	}
+
+
+
+void GETRI(int m, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sD, int di, int dj)
+	{
+	REF_GETRI(m, sA, ai, aj, ipiv, sD, di, dj);
+	}
+#endif
+
+
+
 #if ! ( defined(HP_CM) & defined(DP) )
 #if ! ( defined(REF_BLAS) )
 void GETRF_NOPIVOT(int m, int n, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
@@ -78,6 +78,10 @@
 #define TRSV_UNN blasfeo_dtrsv_unn
 #define TRSV_UTN blasfeo_dtrsv_utn
 #define GER blasfeo_dger
+#define GEMV_N_K blasfeo_dgemv_n_k
+#define GEMV_T_K blasfeo_dgemv_t_k
+#define TRSV_LNN_K blasfeo_dtrsv_lnn_k
+#define TRSV_LTN_K blasfeo_dtrsv_ltn_k
 
 #define COPY dcopy_
 #define GEMV dgemv_
@@ -37,6 +37,13 @@
 #include <stdio.h>
 
 #include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_stdlib.h>
+#include <blasfeo_d_blasfeo_api.h>
+
+
+
+#define DP
 
 
 
@@ -57,6 +64,13 @@
 
 #define GEMM_R_DIAG blasfeo_dgemm_nd
 #define GEMM_L_DIAG blasfeo_dgemm_dn
+#define SYRK_DIAG_LN blasfeo_dsyrk_diag_ln
+#define SYRK_DIAG_POTRF_LN blasfeo_dsyrk_diag_dpotrf_ln
+
+#define SYRK_LN blasfeo_dsyrk_ln
+#define POTRF_L blasfeo_dpotrf_l
+#define MEMSIZE_MAT blasfeo_memsize_dmat
+#define CREATE_MAT blasfeo_create_dmat
 
 
 
@@ -56,6 +56,8 @@
 
 
 
+#define DP
+
 #define REAL double
 #define XMAT blasfeo_dmat
 #define XMATEL BLASFEO_DMATEL
@@ -83,6 +85,14 @@
 #define PSTRF_L dpstrf_l_libstr
 #define SYRK_POTRF_LN blasfeo_dsyrk_dpotrf_ln
 #define SYRK_POTRF_LN_MN blasfeo_dsyrk_dpotrf_ln_mn
+#define CHUD_L blasfeo_dchud_l
+#define CHDD_L blasfeo_dchdd_l
+#define SYTRF_L blasfeo_dsytrf_l
+#define SYTRS_L blasfeo_dsytrs_l
+#define TRTRI_L blasfeo_dtrtri_l
+#define TRTRI_U blasfeo_dtrtri_u
+#define POTRI_L blasfeo_dpotri_l
+#define GETRI_ blasfeo_dgetri
 
 #define COPY dcopy_
 #define GELQF_ dgelqf_
@@ -92,10 +102,15 @@
 #define GEQRF_ dgeqrf_
 #define GEQR2 dgeqr2_
 #define GETRF dgetrf_
+#define GETRI dgetri_
+#define SYTRF dsytrf_
+#define SYTRS dsytrs_
 #define POTRF dpotrf_
+#define POTRI dpotri_
 #define SCAL dscal_
 #define SYRK dsyrk_
 #define TRSM dtrsm_
+#define TRTRI dtrtri_
 
 
 #include "x_lapack_lib.c"
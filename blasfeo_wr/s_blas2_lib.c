@@ -78,6 +78,10 @@
 #define TRSV_UNN blasfeo_strsv_unn
 #define TRSV_UTN blasfeo_strsv_utn
 #define GER blasfeo_sger
+#define GEMV_N_K blasfeo_sgemv_n_k
+#define GEMV_T_K blasfeo_sgemv_t_k
+#define TRSV_LNN_K blasfeo_strsv_lnn_k
+#define TRSV_LTN_K blasfeo_strsv_ltn_k
 
 #define COPY scopy_
 #define GEMV sgemv_
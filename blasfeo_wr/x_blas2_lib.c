@@ -640,6 +640,46 @@ void GER(int m, int n, REAL alpha, struct XVEC *sx, int xi, struct XVEC *sy, int
 
 
 
+// multiple right-hand sides: sx, sy and sz are arrays of k vectors
+void GEMV_N_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		GEMV_N(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void GEMV_T_K(int m, int n, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, REAL beta, struct XVEC *sy, int yi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		GEMV_T(m, n, alpha, sA, ai, aj, sx+jj, xi, beta, sy+jj, yi, sz+jj, zi);
+	return;
+	}
+
+
+
+void TRSV_LNN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		TRSV_LNN(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
+
+void TRSV_LTN_K(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XVEC *sz, int zi)
+	{
+	int jj;
+	for(jj=0; jj<k; jj++)
+		TRSV_LTN(m, sA, ai, aj, sx+jj, xi, sz+jj, zi);
+	return;
+	}
+
+
 #else
 
 #error : wrong LA choice
@@ -179,6 +179,70 @@ void GEMM_R_DIAG(int m, int n, REAL alpha, struct XMAT *sA, int ai, int aj, stru
 
 
 
+#if defined(DP)
+
+
+
+// W <= A * diag(x), W column-major (m)x(k) with leading dimension m
+static void syrk_diag_scale(int m, int k, struct XMAT *sA, int ai, int aj, REAL *x, struct XMAT *sW)
+	{
+	int ii, jj;
+	int lda = sA->m;
+	REAL *pA = sA->pA + ai + aj*lda;
+	REAL *pW = sW->pA;
+	for(jj=0; jj<k; jj++)
+		for(ii=0; ii<m; ii++)
+			pW[ii+m*jj] = pA[ii+lda*jj] * x[jj];
+	return;
+	}
+
+
+
+// dsyrk with diagonal scaling: D <= beta * C + alpha * A * diag(x) * B^T ; C, D lower triangular
+void SYRK_DIAG_LN(int m, int k, REAL alpha, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, REAL beta, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	struct XMAT sW;
+	void *mem;
+	blasfeo_malloc_align(&mem, MEMSIZE_MAT(m, k));
+	CREATE_MAT(m, k, &sW, mem);
+
+	syrk_diag_scale(m, k, sA, ai, aj, sx->pa+xi, &sW);
+	SYRK_LN(m, k, alpha, &sW, 0, 0, sB, bi, bj, beta, sC, ci, cj, sD, di, dj);
+
+	blasfeo_free_align(mem);
+	return;
+	}
+
+
+
+// D <= chol( C + A * diag(x) * B^T ) ; C, D lower triangular
+void SYRK_DIAG_POTRF_LN(int m, int k, struct XMAT *sA, int ai, int aj, struct XVEC *sx, int xi, struct XMAT *sB, int bi, int bj, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	struct XMAT sW;
+	void *mem;
+	blasfeo_malloc_align(&mem, MEMSIZE_MAT(m, k));
+	CREATE_MAT(m, k, &sW, mem);
+
+	syrk_diag_scale(m, k, sA, ai, aj, sx->pa+xi, &sW);
+	SYRK_LN(m, k, 1.0, &sW, 0, 0, sB, bi, bj, 1.0, sC, ci, cj, sD, di, dj);
+	POTRF_L(m, sD, di, dj, sD, di, dj);
+
+	blasfeo_free_align(mem);
+	return;
+	}
+
+
+
+#endif
+
+
+
 #else
 
 #error : wrong LA choice
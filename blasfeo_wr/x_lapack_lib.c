@@ -613,6 +613,326 @@ void GELQF_PD_LLA(int m, int n1, struct XMAT *sD, int di, int dj, struct XMAT *s
 	}
 
 
+
+#if defined(DP)
+// D <= chol( D * D^T + A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+void CHUD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, ll;
+	REAL d_jj, a_jl, r, c, s, d_tmp;
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA+ai+aj*lda;
+	REAL *pD = sD->pA+di+dj*ldd;
+	for(jj=0; jj<m; jj++)
+		{
+		d_jj = pD[jj+jj*ldd];
+		// Givens rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			a_jl = pA[jj+ll*lda];
+			if(a_jl==0.0)
+				continue;
+			r = sqrt(d_jj*d_jj + a_jl*a_jl);
+			c = d_jj / r;
+			s = a_jl / r;
+			d_jj = r;
+			pA[jj+ll*lda] = 0.0;
+			for(ii=jj+1; ii<m; ii++)
+				{
+				d_tmp = c * pD[ii+jj*ldd] + s * pA[ii+ll*lda];
+				pA[ii+ll*lda] = c * pA[ii+ll*lda] - s * pD[ii+jj*ldd];
+				pD[ii+jj*ldd] = d_tmp;
+				}
+			}
+		pD[jj+jj*ldd] = d_jj;
+		}
+	return;
+	}
+
+
+
+// D <= chol( D * D^T - A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+// if the result is not positive definite, the failing columns of D are set to zero
+void CHDD_L(int m, int k, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int ii, jj, ll;
+	REAL d_jj, a_jl, r, r2, c, s, d_tmp;
+	int lda = sA->m;
+	int ldd = sD->m;
+	REAL *pA = sA->pA+ai+aj*lda;
+	REAL *pD = sD->pA+di+dj*ldd;
+	for(jj=0; jj<m; jj++)
+		{
+		d_jj = pD[jj+jj*ldd];
+		// hyperbolic rotation of column jj of D and column ll of A, annihilating A[jj,ll]
+		for(ll=0; ll<k; ll++)
+			{
+			a_jl = pA[jj+ll*lda];
+			if(a_jl==0.0)
+				continue;
+			r2 = (d_jj - a_jl) * (d_jj + a_jl);
+			if(!(r2>0.0))
+				{
+				d_jj = 0.0;
+				break;
+				}
+			r = sqrt(r2);
+			c = r / d_jj;
+			s = a_jl / d_jj;
+			d_jj = r;
+			pA[jj+ll*lda] = 0.0;
+			// mixed form, numerically stable
+			for(ii=jj+1; ii<m; ii++)
+				{
+				d_tmp = (pD[ii+jj*ldd] - s * pA[ii+ll*lda]) / c;
+				pA[ii+ll*lda] = c * pA[ii+ll*lda] - s * d_tmp;
+				pD[ii+jj*ldd] = d_tmp;
+				}
+			}
+		if(d_jj==0.0)
+			{
+			for(ii=jj+1; ii<m; ii++)
+				pD[ii+jj*ldd] = 0.0;
+			}
+		pD[jj+jj*ldd] = d_jj;
+		}
+	return;
+	}
+
+
+
+// D <= ldl( C ), with Bunch-Kaufman pivoting; C, D lower triangular
+void SYTRF_L(int m, struct XMAT *sC, int ci, int cj, struct XMAT *sD, int di, int dj, int *ipiv)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	char cl = 'l';
+	REAL *pC = sC->pA+ci+cj*sC->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int tmp;
+	int ldc = sC->m;
+	int ldd = sD->m;
+	int lwork = -1;
+	REAL work0;
+	REAL *work;
+	if(!(pC==pD))
+		{
+		for(jj=0; jj<m; jj++)
+			{
+			tmp = m-jj;
+			COPY(&tmp, pC+jj+jj*ldc, &i1, pD+jj+jj*ldd, &i1);
+			}
+		}
+	// workspace query
+	SYTRF(&cl, &m, pD, &ldd, ipiv, &work0, &lwork, &info);
+	lwork = work0;
+	work = malloc(lwork*sizeof(REAL));
+	SYTRF(&cl, &m, pD, &ldd, ipiv, work, &lwork, &info);
+	free(work);
+	// from 1-based to 0-based, the 2x2 pivot blocks keep the negative index
+	for(jj=0; jj<m; jj++)
+		{
+		if(ipiv[jj]>0)
+			ipiv[jj] -= 1;
+		}
+	return;
+	}
+
+
+
+// D <= inv( A ) * B, with A factorized by sytrf_l
+void SYTRS_L(int m, int n, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sB, int bi, int bj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0 | n<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	char cl = 'l';
+	REAL *pA = sA->pA+ai+aj*sA->m;
+	REAL *pB = sB->pA+bi+bj*sB->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int lda = sA->m;
+	int ldb = sB->m;
+	int ldd = sD->m;
+	if(!(pB==pD))
+		{
+		for(jj=0; jj<n; jj++)
+			COPY(&m, pB+jj*ldb, &i1, pD+jj*ldd, &i1);
+		}
+	// from 0-based to 1-based
+	int *ipiv1 = malloc(m*sizeof(int));
+	for(jj=0; jj<m; jj++)
+		ipiv1[jj] = ipiv[jj]>=0 ? ipiv[jj]+1 : ipiv[jj];
+	SYTRS(&cl, &m, &n, pA, &lda, ipiv1, pD, &ldd, &info);
+	free(ipiv1);
+	return;
+	}
+
+
+
+// D <= inv( A ) ; A, D lower triangular
+void TRTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	char cl = 'l';
+	char cn = 'n';
+	REAL *pA = sA->pA+ai+aj*sA->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int tmp;
+	int lda = sA->m;
+	int ldd = sD->m;
+	if(!(pA==pD))
+		{
+		for(jj=0; jj<m; jj++)
+			{
+			tmp = m-jj;
+			COPY(&tmp, pA+jj+jj*lda, &i1, pD+jj+jj*ldd, &i1);
+			}
+		}
+	TRTRI(&cl, &cn, &m, pD, &ldd, &info);
+	return;
+	}
+
+
+
+// D <= inv( A ) ; A, D upper triangular
+void TRTRI_U(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	char cu = 'u';
+	char cn = 'n';
+	REAL *pA = sA->pA+ai+aj*sA->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int tmp;
+	int lda = sA->m;
+	int ldd = sD->m;
+	if(!(pA==pD))
+		{
+		for(jj=0; jj<m; jj++)
+			{
+			tmp = jj+1;
+			COPY(&tmp, pA+jj*lda, &i1, pD+jj*ldd, &i1);
+			}
+		}
+	TRTRI(&cu, &cn, &m, pD, &ldd, &info);
+	return;
+	}
+
+
+
+// D <= inv( A * A^T ) ; A lower triangular, D lower triangular
+void POTRI_L(int m, struct XMAT *sA, int ai, int aj, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	char cl = 'l';
+	REAL *pA = sA->pA+ai+aj*sA->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int tmp;
+	int lda = sA->m;
+	int ldd = sD->m;
+	if(!(pA==pD))
+		{
+		for(jj=0; jj<m; jj++)
+			{
+			tmp = m-jj;
+			COPY(&tmp, pA+jj+jj*lda, &i1, pD+jj+jj*ldd, &i1);
+			}
+		}
+	POTRI(&cl, &m, pD, &ldd, &info);
+	return;
+	}
+
+
+
+// D <= inv( A ) ; A factorized by getrf_rp
+void GETRI_(int m, struct XMAT *sA, int ai, int aj, int *ipiv, struct XMAT *sD, int di, int dj)
+	{
+	if(m<=0)
+		return;
+
+	// invalidate stored inverse diagonal of result matrix
+	sD->use_dA = 0;
+
+	int jj;
+	REAL *pA = sA->pA+ai+aj*sA->m;
+	REAL *pD = sD->pA+di+dj*sD->m;
+	int i1 = 1;
+	int info;
+	int lda = sA->m;
+	int ldd = sD->m;
+	int lwork = -1;
+	REAL work0;
+	REAL *work;
+	if(!(pA==pD))
+		{
+		for(jj=0; jj<m; jj++)
+			COPY(&m, pA+jj*lda, &i1, pD+jj*ldd, &i1);
+		}
+	// from 0-based to 1-based
+	int *ipiv1 = malloc(m*sizeof(int));
+	for(jj=0; jj<m; jj++)
+		ipiv1[jj] = ipiv[jj]+1;
+	// workspace query
+	GETRI(&m, pD, &ldd, ipiv1, &work0, &lwork, &info);
+	lwork = work0;
+	work = malloc(lwork*sizeof(REAL));
+	GETRI(&m, pD, &ldd, ipiv1, work, &lwork, &info);
+	free(work);
+	free(ipiv1);
+	return;
+	}
+#endif
+
+
 #else
 
 #error : wrong LA choice
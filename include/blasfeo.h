@@ -50,3 +50,12 @@
 #include "blasfeo_v_aux_ext_dep.h"
 #include "blasfeo_timing.h"
 #include "blasfeo_memory.h"
+#include "blasfeo_profile.h"
+#include "blasfeo_graph.h"
+#include "blasfeo_arena.h"
+#include "blasfeo_batch.h"
+#include "blasfeo_epilogue.h"
+#include "blasfeo_expm.h"
+#include "blasfeo_dare.h"
+#include "blasfeo_cond.h"
+#include "blasfeo_hybrid.h"
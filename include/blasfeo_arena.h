@@ -0,0 +1,87 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#ifndef BLASFEO_ARENA_H_
+#define BLASFEO_ARENA_H_
+
+#include <stdlib.h>
+
+#include "blasfeo_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// arena item types
+#define BLASFEO_ARENA_DMAT 0
+#define BLASFEO_ARENA_DVEC 1
+
+// arena layout flags
+// pad the panel stride of panel-major matrices away from multiples of BLASFEO_ARENA_CONFLICT_STRIDE
+#define BLASFEO_ARENA_PAD 1
+// store the items by increasing stage instead of in list order (stable within a stage)
+#define BLASFEO_ARENA_INTERLEAVE 2
+
+// panel strides multiple of this number of bytes map the same row of consecutive panels
+// to a few L1 cache sets only
+#define BLASFEO_ARENA_CONFLICT_STRIDE 2048
+
+// a matrix or vector to be created in the arena
+struct blasfeo_arena_item
+	{
+	void *obj; // struct blasfeo_dmat * or struct blasfeo_dvec *
+	int type; // BLASFEO_ARENA_DMAT or BLASFEO_ARENA_DVEC
+	int m; // rows
+	int n; // cols (ignored for vectors)
+	int stage; // stage index, used with BLASFEO_ARENA_INTERLEAVE
+	};
+
+
+
+// memory size (in bytes) of an arena holding the n_items items
+size_t blasfeo_arena_memsize(int n_items, struct blasfeo_arena_item *items, int flags);
+// create all the items over the memory passed by a pointer (aligned to cache line size),
+// each item starts at a cache line boundary
+void blasfeo_arena_create(int n_items, struct blasfeo_arena_item *items, int flags, void *memory);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLASFEO_ARENA_H_
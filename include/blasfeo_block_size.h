@@ -432,6 +432,34 @@
 
 
 
+#if defined(BLASFEO_HUGE_PAGES)
+// large buffers backed by 2 MB pages: the blocking is limited by the cache size only,
+// not by the DTLB reach of 4 kB pages
+#define HUGE_PAGE_SIZE (2*1024*1024)
+#if defined( TARGET_X64_INTEL_SKYLAKE_X )
+#undef L2_CACHE_SIZE
+#define L2_CACHE_SIZE (1024*1024) // L2 data cache size: 1 MB
+#undef LLC_CACHE_SIZE
+#define LLC_CACHE_SIZE (8*1024*1024) // LLC cache size: 8 MB
+#endif
+#endif
+
+// per-machine blocking parameters and algorithm switch points, generated by `make autotune`
+#if defined(BLASFEO_AUTOTUNE)
+#include <blasfeo_autotune.h>
+#endif
+
+// column-major dgemm: max m and n handled by the small-matrix algorithm (sandy bridge)
+#ifndef D_GEMM_SMALL_MN
+#define D_GEMM_SMALL_MN 48
+#endif
+// column-major dgemm_nn: min m/n ratio for which B is packed instead of A
+#ifndef D_GEMM_MN_RATIO
+#define D_GEMM_MN_RATIO 4
+#endif
+
+
+
 #define D_CACHE_LINE_EL (CACHE_LINE_SIZE/D_EL_SIZE)
 #define D_L1_CACHE_EL (L1_CACHE_SIZE/D_EL_SIZE)
 #define D_L2_CACHE_EL (L2_CACHE_SIZE/D_EL_SIZE)
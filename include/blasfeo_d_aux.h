@@ -129,7 +129,7 @@ void blasfeo_dgead(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai,
 void blasfeo_dvecad(int m, double alpha, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sy, int yi);
 
 // --- traspositions
-// B <= A'
+// B <= A' ; in place if B and A are the same square block
 void blasfeo_dgetr(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj);
 // B <= A', A lower triangular
 void blasfeo_dtrtr_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj);
@@ -206,6 +206,11 @@ void blasfeo_dveccl_mask(int m,
 void blasfeo_dvecze(int m, struct blasfeo_dvec *sm, int mi, struct blasfeo_dvec *sv, int vi, struct blasfeo_dvec *se, int ei);
 void blasfeo_dvecnrm_inf(int m, struct blasfeo_dvec *sx, int xi, double *ptr_norm);
 void blasfeo_dvecnrm_2(int m, struct blasfeo_dvec *sx, int xi, double *ptr_norm);
+// matrix norms: 1 (max abs column sum), inf (max abs row sum), Frobenius, max abs element
+void blasfeo_dgenrm_1(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_dgenrm_inf(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_dgenrm_fro(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_dgenrm_max(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
 void blasfeo_dvecpe(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi);
 void blasfeo_dvecpei(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi);
 
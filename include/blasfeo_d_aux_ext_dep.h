@@ -133,6 +133,21 @@ void blasfeo_print_exp_tran_dvec(int m, struct blasfeo_dvec *sa, int ai);
 void blasfeo_print_to_file_tran_dvec(FILE *file, int m, struct blasfeo_dvec *sa, int ai);
 // print to string the transposed of a strvec
 void blasfeo_print_to_string_tran_dvec(char **buf_out, int m, struct blasfeo_dvec *sa, int ai);
+// save a strmat to a binary file, together with its memory format; return 0 on success
+int blasfeo_save_dmat(char *file_name, struct blasfeo_dmat *sA);
+// create a strmat over the memory of a binary file saved by blasfeo_save_dmat, mapped without copy
+// (copy-on-write); return 0 on success, 1 if the file can not be read, 2 if it is not a valid file
+// of the right type and version, 3 if its memory format does not match the one of this library
+int blasfeo_load_dmat(char *file_name, struct blasfeo_dmat *sA);
+// release a strmat created by blasfeo_load_dmat
+void blasfeo_unload_dmat(struct blasfeo_dmat *sA);
+// save a strvec to a binary file, together with its memory format; return 0 on success
+int blasfeo_save_dvec(char *file_name, struct blasfeo_dvec *sa);
+// create a strvec over the memory of a binary file saved by blasfeo_save_dvec, mapped without copy
+// (copy-on-write); return values as blasfeo_load_dmat
+int blasfeo_load_dvec(char *file_name, struct blasfeo_dvec *sa);
+// release a strvec created by blasfeo_load_dvec
+void blasfeo_unload_dvec(struct blasfeo_dvec *sa);
 
 #endif // EXT_DEP
 
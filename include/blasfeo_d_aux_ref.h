@@ -196,6 +196,10 @@ void blasfeo_ref_dveccl_mask(int m,
 
 void blasfeo_ref_dvecze(int m, struct blasfeo_dvec *sm, int mi, struct blasfeo_dvec *sv, int vi, struct blasfeo_dvec *se, int ei);
 void blasfeo_ref_dvecnrm_inf(int m, struct blasfeo_dvec *sx, int xi, double *ptr_norm);
+void blasfeo_ref_dgenrm_1(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_ref_dgenrm_inf(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_ref_dgenrm_fro(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
+void blasfeo_ref_dgenrm_max(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, double *ptr_norm);
 void blasfeo_ref_dvecpe(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi);
 void blasfeo_ref_dvecpei(int kmax, int *ipiv, struct blasfeo_dvec *sx, int xi);
 
@@ -120,6 +120,8 @@ void dgesv_(int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb,
 //
 void dgetrf_(int *m, int *n, double *A, int *lda, int *ipiv, int *info);
 //
+void dgetri_(int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
+//
 void dgetrf_np_(int *m, int *n, double *A, int *lda, int *info);
 //
 void dgetrs_(char *trans, int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb, int *info);
@@ -130,8 +132,16 @@ void dposv_(char *uplo, int *m, int *n, double *A, int *lda, double *B, int *ldb
 //
 void dpotrf_(char *uplo, int *m, double *A, int *lda, int *info);
 //
+void dpotri_(char *uplo, int *m, double *A, int *lda, int *info);
+//
 void dpotrs_(char *uplo, int *m, int *n, double *A, int *lda, double *B, int *ldb, int *info);
 //
+void dsytrf_(char *uplo, int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
+//
+void dsytrs_(char *uplo, int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb, int *info);
+//
+void dtrtri_(char *uplo, char *diag, int *m, double *A, int *lda, int *info);
+//
 void dtrtrs_(char *uplo, char *trans, char *diag, int *m, int *n, double *A, int *lda, double *B, int *ldb, int *info);
 
 
@@ -213,6 +223,8 @@ void blasfeo_lapack_dgesv(int *m, int *n, double *A, int *lda, int *ipiv, double
 //
 void blasfeo_lapack_dgetrf(int *m, int *n, double *A, int *lda, int *ipiv, int *info);
 //
+void blasfeo_lapack_dgetri(int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
+//
 void blasfeo_lapack_dgetrf_np(int *m, int *n, double *A, int *lda, int *info);
 //
 void blasfeo_lapack_dgetrs(char *trans, int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb, int *info);
@@ -223,8 +235,16 @@ void blasfeo_lapack_dposv(char *uplo, int *m, int *n, double *A, int *lda, doubl
 //
 void blasfeo_lapack_dpotrf(char *uplo, int *m, double *A, int *lda, int *info);
 //
+void blasfeo_lapack_dpotri(char *uplo, int *m, double *A, int *lda, int *info);
+//
 void blasfeo_lapack_dpotrs(char *uplo, int *m, int *n, double *A, int *lda, double *B, int *ldb, int *info);
 //
+void blasfeo_lapack_dsytrf(char *uplo, int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
+//
+void blasfeo_lapack_dsytrs(char *uplo, int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb, int *info);
+//
+void blasfeo_lapack_dtrtri(char *uplo, char *diag, int *m, double *A, int *lda, int *info);
+//
 void blasfeo_lapack_dtrtrs(char *uplo, char *trans, char *diag, int *m, int *n, double *A, int *lda, double *B, int *ldb, int *info);
 
 
@@ -123,6 +123,15 @@ void blasfeo_dsymv_l_mn(int m, int n, double alpha, struct blasfeo_dmat *sA, int
 void blasfeo_dsymv_u(int m, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi);
 // D = C + alpha * x * y^T
 void blasfeo_dger(int m, int n, double alpha, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sy, int yi, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
+// multiple right-hand sides: sx, sy, sz are arrays of k vectors, and A is streamed once for (groups of) all of them
+// z[j] <= beta * y[j] + alpha * A * x[j], j=0,...,k-1
+void blasfeo_dgemv_n_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi);
+// z[j] <= beta * y[j] + alpha * A^T * x[j], j=0,...,k-1
+void blasfeo_dgemv_t_k(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi);
+// z[j] <= inv( A ) * x[j], j=0,...,k-1, A (m)x(m) lower, not_transposed
+void blasfeo_dtrsv_lnn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi);
+// z[j] <= inv( A^T ) * x[j], j=0,...,k-1, A (m)x(m) lower, transposed
+void blasfeo_dtrsv_ltn_k(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dvec *sz, int zi);
 
 // diagonal
 
@@ -246,6 +255,8 @@ void dgemm_diag_left_lib(int m, int n, double alpha, double *dA, double *pB, int
 void blasfeo_dgemm_dn(int m, int n, double alpha, struct blasfeo_dvec *sA, int ai, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
 // D <= alpha * A * B + beta * C, with B diagonal (stored as strvec)
 void blasfeo_dgemm_nd(int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sB, int bi, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= beta * C + alpha * A * diag(x) * B^T ; C, D lower triangular, x stored as strvec
+void blasfeo_dsyrk_diag_ln(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
 
 
 
@@ -262,10 +273,25 @@ void blasfeo_dpotrf_u(int m, struct blasfeo_dmat *sC, int ci, int cj, struct bla
 // D <= chol( C + A * B^T ) ; C, D lower triangular
 void blasfeo_dsyrk_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
 void blasfeo_dsyrk_dpotrf_ln_mn(int m, int n, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= chol( C + A * diag(x) * B^T ) ; C, D lower triangular, x stored as strvec
+void blasfeo_dsyrk_diag_dpotrf_ln(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
 // D <= lu( C ) ; no pivoting
 void blasfeo_dgetrf_np(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
 // D <= lu( C ) ; row pivoting
 void blasfeo_dgetrf_rp(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv);
+// D <= ldl( C ) ; Bunch-Kaufman pivoting, C, D lower triangular, D holds the unit lower triangular factor and the 1x1 and 2x2 diagonal blocks
+// ipiv[k]>=0: 1x1 block, rows k and ipiv[k] interchanged ; ipiv[k]=ipiv[k+1]=-p-1: 2x2 block, rows k+1 and p interchanged
+void blasfeo_dsytrf_l(int m, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, int *ipiv);
+// D <= inv( A ) * B ; A factorized by dsytrf_l
+void blasfeo_dsytrs_l(int m, int n, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sB, int bi, int bj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= inv( A ) ; A, D lower triangular
+void blasfeo_dtrtri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= inv( A ) ; A, D upper triangular
+void blasfeo_dtrtri_u(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= inv( A * A^T ) ; A lower triangular (Cholesky factor), D lower triangular
+void blasfeo_dpotri_l(int m, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= inv( A ) ; A factorized by dgetrf_rp
+void blasfeo_dgetri(int m, struct blasfeo_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_dmat *sD, int di, int dj);
 // D <= qr( C )
 int blasfeo_dgeqrf_worksize(int m, int n); // in bytes
 void blasfeo_dgeqrf(int m, int n, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, void *work);
@@ -285,6 +311,10 @@ void blasfeo_dgelqf_pd_la(int m, int n1, struct blasfeo_dmat *sL, int li, int lj
 // L lower triangular, of size (m)x(m)
 // A full, of size (m)x(n1)
 void blasfeo_dgelqf_pd_lla(int m, int n1, struct blasfeo_dmat *sL0, int l0i, int l0j, struct blasfeo_dmat *sL1, int l1i, int l1j, struct blasfeo_dmat *sA, int ai, int aj, void *work);
+// D <= chol( D * D^T + A * A^T ) ; D lower triangular, A (m)x(k) overwritten
+void blasfeo_dchud_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj);
+// D <= chol( D * D^T - A * A^T ) ; D lower triangular, A (m)x(k) overwritten, failing columns of D set to zero
+void blasfeo_dchdd_l(int m, int k, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sD, int di, int dj);
 
 
 
@@ -352,6 +382,12 @@ void blasfeo_cm_dger(int m, int n, double alpha, struct blasfeo_cm_dvec *sx, int
 void blasfeo_cm_dpotrf_l(int m, struct blasfeo_cm_dmat *sC, int ci, int cj, struct blasfeo_cm_dmat *sD, int di, int dj);
 void blasfeo_cm_dpotrf_u(int m, struct blasfeo_cm_dmat *sC, int ci, int cj, struct blasfeo_cm_dmat *sD, int di, int dj);
 void blasfeo_cm_dgetrf_rp(int m, int n, struct blasfeo_cm_dmat *sC, int ci, int cj, struct blasfeo_cm_dmat *sD, int di, int dj, int *ipiv);
+void blasfeo_cm_dsytrf_l(int m, struct blasfeo_cm_dmat *sC, int ci, int cj, struct blasfeo_cm_dmat *sD, int di, int dj, int *ipiv);
+void blasfeo_cm_dsytrs_l(int m, int n, struct blasfeo_cm_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_cm_dmat *sB, int bi, int bj, struct blasfeo_cm_dmat *sD, int di, int dj);
+void blasfeo_cm_dtrtri_l(int m, struct blasfeo_cm_dmat *sA, int ai, int aj, struct blasfeo_cm_dmat *sD, int di, int dj);
+void blasfeo_cm_dtrtri_u(int m, struct blasfeo_cm_dmat *sA, int ai, int aj, struct blasfeo_cm_dmat *sD, int di, int dj);
+void blasfeo_cm_dpotri_l(int m, struct blasfeo_cm_dmat *sA, int ai, int aj, struct blasfeo_cm_dmat *sD, int di, int dj);
+void blasfeo_cm_dgetri(int m, struct blasfeo_cm_dmat *sA, int ai, int aj, int *ipiv, struct blasfeo_cm_dmat *sD, int di, int dj);
 #endif
 
 
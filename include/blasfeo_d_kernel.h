@@ -244,6 +244,14 @@ void kernel_dgemv_nt_4_lib4(int kmax, double *alpha_n, double *alpha_t, double *
 void kernel_dgemv_nt_4_vs_lib4(int kmax, double *alpha_n, double *alpha_t, double *A, int sda, double *x_n, double *x_t, double *beta_t, double *y_t, double *z_n, double *z_t, int km);
 void kernel_dsymv_l_4_lib4(int kmax, double *alpha, double *A, int sda, double *x, double *z);
 void kernel_dsymv_l_4_gen_lib4(int kmax, double *alpha, int offA, double *A, int sda, double *x, double *z, int km);
+// 4 rows, 4 right-hand sides
+void kernel_dgemv_n_4_k4_lib4(int k, double *alpha, double *A, double **x, double *beta, double **y, double **z);
+void kernel_dgemv_n_4_k4_gen_lib4(int k, double *alpha, double *A, double **x, double *beta, double **y, double **z, int k0, int k1);
+void kernel_dgemv_t_4_k4_lib4(int k, double *alpha, int offsetA, double *A, int sda, double **x, double *beta, double **y, double **z);
+void kernel_dgemv_t_4_k4_vs_lib4(int k, double *alpha, int offsetA, double *A, int sda, double **x, double *beta, double **y, double **z, int k1);
+void kernel_dtrsv_ln_inv_4_k4_lib4(int k, double *A, double *inv_diag_A, double **x, double **y, double **z);
+void kernel_dtrsv_ln_inv_4_k4_vs_lib4(int k, double *A, double *inv_diag_A, double **x, double **y, double **z, int km, int kn);
+void kernel_dtrsv_lt_inv_4_k4_lib4(int k, double *A, int sda, double *inv_diag_A, double **x, double **y, double **z);
 
 
 
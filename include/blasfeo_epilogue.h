@@ -0,0 +1,85 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+#ifndef BLASFEO_EPILOGUE_H_
+#define BLASFEO_EPILOGUE_H_
+
+#include "blasfeo_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// post-operations of a gemm/syrk epilogue, or-ed in the flags of blasfeo_dgemm_ep;
+// they are applied in this order to each tile of D right after it is computed, while it is in cache
+#define BLASFEO_EP_SCALE 1 // D <= scale * D (folded into alpha and beta)
+#define BLASFEO_EP_DIAAD 2 // D[i][i] <= D[i][i] + dia_alpha * x_dia[i] ; dia_alpha only if sx_dia is NULL
+#define BLASFEO_EP_COLAD 4 // D[i][j] <= D[i][j] + x_col[i] ; column vector added to each column
+#define BLASFEO_EP_ROWAD 8 // D[i][j] <= D[i][j] + x_row[j] ; row vector added to each row
+#define BLASFEO_EP_CLIP 16 // D[i][j] <= min( max( D[i][j], lo ), up )
+#define BLASFEO_EP_SYMM 32 // D[j][i] <= D[i][j] for i>j in the leading square of D ; the upper part is not computed
+
+// epilogue descriptor: the fields of the post-operations not in flags are not accessed
+struct blasfeo_dgemm_ep
+	{
+	struct blasfeo_dvec *sx_dia; // diagonal add vector (may be NULL)
+	struct blasfeo_dvec *sx_col; // column add vector
+	struct blasfeo_dvec *sx_row; // row add vector
+	double scale;
+	double dia_alpha;
+	double lo; // lower clip bound
+	double up; // upper clip bound
+	int xi_dia;
+	int xi_col;
+	int xi_row;
+	int flags;
+	};
+
+
+
+// D <= ep( beta * C + alpha * A * B^T ) ; ep NULL is plain gemm_nt
+void blasfeo_dgemm_nt_ep(int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dgemm_ep *ep);
+// D <= ep( beta * C + alpha * A * B^T ) ; C, D lower triangular, the post-operations only touch the lower triangle (and the upper one with BLASFEO_EP_SYMM)
+void blasfeo_dsyrk_ln_ep(int m, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj, struct blasfeo_dgemm_ep *ep);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLASFEO_EPILOGUE_H_
@@ -0,0 +1,131 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+
+#ifndef BLASFEO_GRAPH_H_
+#define BLASFEO_GRAPH_H_
+
+#include <stdlib.h>
+
+#include "blasfeo_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// recorded routines
+enum blasfeo_graph_op
+	{
+	BLASFEO_GRAPH_DGEMM_NN,
+	BLASFEO_GRAPH_DGEMM_NT,
+	BLASFEO_GRAPH_DSYRK_LN,
+	BLASFEO_GRAPH_DTRSM_RLTN,
+	BLASFEO_GRAPH_DTRMM_RLNN,
+	BLASFEO_GRAPH_DPOTRF_L,
+	BLASFEO_GRAPH_DSYRK_DPOTRF_LN,
+	BLASFEO_GRAPH_DGEMV_N,
+	BLASFEO_GRAPH_DGEMV_T,
+	BLASFEO_GRAPH_DTRSV_LNN,
+	BLASFEO_GRAPH_DTRSV_LTN,
+	BLASFEO_GRAPH_N_OPS
+	};
+
+// a recorded call, matrix and vector arguments in the order of the routine signature
+struct blasfeo_graph_node
+	{
+	void (*fun)(struct blasfeo_graph_node *node); // implementation, resolved at record time
+	int op; // enum blasfeo_graph_op
+	int m;
+	int n;
+	int k;
+	double alpha;
+	double beta;
+	struct blasfeo_dmat *sM[4];
+	int mi[4];
+	int mj[4];
+	struct blasfeo_dvec *sv[3];
+	int vi[3];
+	};
+
+struct blasfeo_graph
+	{
+	struct blasfeo_graph_node *nodes;
+	int max_nodes;
+	int n_nodes;
+	int overflow; // set if more than max_nodes calls were recorded
+	size_t memsize;
+	};
+
+
+
+// memory size of a graph of up to max_nodes calls
+size_t blasfeo_graph_memsize(int max_nodes);
+//
+void blasfeo_graph_create(int max_nodes, struct blasfeo_graph *graph, void *memory);
+// start the capture: the following blasfeo_d* calls are executed as usual and appended to graph
+// (panel-major LA=HIGH_PERFORMANCE library built with BLASFEO_GRAPH, a single capture at a time)
+void blasfeo_graph_begin(struct blasfeo_graph *graph);
+// stop the capture
+void blasfeo_graph_end();
+// replace each dsyrk_ln with alpha=beta=1 followed by an in-place dpotrf_l of its result
+// by a single dsyrk_dpotrf_ln; return the number of fused pairs
+int blasfeo_graph_fuse(struct blasfeo_graph *graph);
+// execute the recorded calls on the current content of the recorded operands
+void blasfeo_graph_replay(struct blasfeo_graph *graph);
+
+
+
+// internal hooks, called by the recorded routines
+void blasfeo_graph_record_m(int op, int m, int n, int k, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dmat *sB, int bi, int bj, double beta, struct blasfeo_dmat *sC, int ci, int cj, struct blasfeo_dmat *sD, int di, int dj);
+void blasfeo_graph_record_v(int op, int m, int n, double alpha, struct blasfeo_dmat *sA, int ai, int aj, struct blasfeo_dvec *sx, int xi, double beta, struct blasfeo_dvec *sy, int yi, struct blasfeo_dvec *sz, int zi);
+
+#if defined(BLASFEO_GRAPH)
+#define BLASFEO_GRAPH_RECORD_M(...) blasfeo_graph_record_m(__VA_ARGS__)
+#define BLASFEO_GRAPH_RECORD_V(...) blasfeo_graph_record_v(__VA_ARGS__)
+#else
+#define BLASFEO_GRAPH_RECORD_M(...)
+#define BLASFEO_GRAPH_RECORD_V(...)
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLASFEO_GRAPH_H_
@@ -0,0 +1,87 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+
+#ifndef BLASFEO_JIT_H_
+#define BLASFEO_JIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// max size of the gemm generated at runtime, larger calls use the fixed kernels
+#define BLASFEO_JIT_MAX_M 24
+#define BLASFEO_JIT_MAX_N 24
+#define BLASFEO_JIT_MAX_K 512
+// min m*n*k of the gemm generated at runtime, smaller calls are faster with the fixed kernels
+#define BLASFEO_JIT_MIN_MNK 512
+// max number of kernels in the cache
+#define BLASFEO_JIT_CACHE_SIZE 1024
+
+// arguments of a generated kernel, panel-major lib4 operands aligned to the panel edge
+struct blasfeo_jit_dgemm_args
+	{
+	double *pA;
+	double *pB;
+	double *pC;
+	double *pD;
+	long long sda_bytes; // distance between consecutive panels, in bytes
+	long long sdb_bytes;
+	long long sdc_bytes;
+	long long sdd_bytes;
+	double alpha;
+	double beta;
+	};
+
+typedef void (*blasfeo_jit_dgemm_kernel)(struct blasfeo_jit_dgemm_args *args);
+
+
+
+// kernel computing D <= beta * C + alpha * A * B (tb=='n') or alpha * A * B^T (tb=='t') for
+// the exact m, n, k and alpha/beta class; generated on first use, NULL if not available
+blasfeo_jit_dgemm_kernel blasfeo_jit_dgemm_get(char tb, int m, int n, int k, double alpha, double beta);
+// number of kernels in the cache
+int blasfeo_jit_cache_size();
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLASFEO_JIT_H_
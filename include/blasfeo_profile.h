@@ -0,0 +1,135 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2020 by Gianluca Frison.                                                          *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+
+#ifndef BLASFEO_PROFILE_H_
+#define BLASFEO_PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// instrumented routines
+enum blasfeo_profile_routine
+	{
+	BLASFEO_PROFILE_DGEMM_NN,
+	BLASFEO_PROFILE_DGEMM_NT,
+	BLASFEO_PROFILE_DGEMM_TN,
+	BLASFEO_PROFILE_DGEMM_TT,
+	BLASFEO_PROFILE_DSYRK_LN,
+	BLASFEO_PROFILE_DTRSM_RLTN,
+	BLASFEO_PROFILE_DPOTRF_L,
+	BLASFEO_PROFILE_DGETRF_RP,
+	BLASFEO_PROFILE_DGEMV_N,
+	BLASFEO_PROFILE_DGEMV_T,
+	BLASFEO_PROFILE_N_ROUTINES
+	};
+
+// selected algorithm, i.e. packing strategy of the column-major gemm
+enum blasfeo_profile_alg
+	{
+	BLASFEO_PROFILE_ALG_NONE, // single algorithm
+	BLASFEO_PROFILE_ALG_0, // no packing
+	BLASFEO_PROFILE_ALG_M1, // pack A
+	BLASFEO_PROFILE_ALG_N1, // pack B
+	BLASFEO_PROFILE_ALG_2, // pack A and B
+	BLASFEO_PROFILE_N_ALGS
+	};
+
+// histogram bin i counts the calls with max(m,n,k) in [2^i, 2^(i+1))
+#define BLASFEO_PROFILE_N_BINS 16
+
+struct blasfeo_profile_entry
+	{
+	const char *name;
+	long long calls;
+	long long cycles; // rdtsc on x86_64, cntvct on aarch64, 0 elsewhere
+	long long bytes_packed;
+	long long alg[BLASFEO_PROFILE_N_ALGS];
+	long long size_hist[BLASFEO_PROFILE_N_BINS];
+	};
+
+// passed to the callback at the end of each instrumented call
+struct blasfeo_profile_event
+	{
+	int routine; // enum blasfeo_profile_routine
+	int m;
+	int n;
+	int k;
+	int alg; // enum blasfeo_profile_alg
+	long long cycles;
+	long long bytes_packed;
+	};
+
+
+
+// statistics of a routine, all zero unless the library is built with BLASFEO_PROFILE
+struct blasfeo_profile_entry *blasfeo_profile_get(int routine);
+//
+void blasfeo_profile_reset();
+// register a callback called at the end of each instrumented call, NULL to unregister
+void blasfeo_profile_set_callback(void (*callback)(struct blasfeo_profile_event *event, void *data), void *data);
+// print the statistics of the called routines (requires EXT_DEP)
+void blasfeo_profile_print();
+
+
+
+// internal hooks, called by the instrumented routines
+void blasfeo_profile_start(int routine, int m, int n, int k);
+void blasfeo_profile_alg(int alg);
+void blasfeo_profile_packed(long long bytes);
+void blasfeo_profile_end();
+
+#if defined(BLASFEO_PROFILE)
+#define BLASFEO_PROFILE_START(routine, m, n, k) blasfeo_profile_start(routine, m, n, k)
+#define BLASFEO_PROFILE_ALG(alg) blasfeo_profile_alg(alg)
+#define BLASFEO_PROFILE_PACKED(bytes) blasfeo_profile_packed(bytes)
+#define BLASFEO_PROFILE_END() blasfeo_profile_end()
+#else
+#define BLASFEO_PROFILE_START(routine, m, n, k)
+#define BLASFEO_PROFILE_ALG(alg)
+#define BLASFEO_PROFILE_PACKED(bytes)
+#define BLASFEO_PROFILE_END()
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLASFEO_PROFILE_H_
@@ -147,6 +147,11 @@ void blasfeo_sveccl_mask(int m, struct blasfeo_svec *sxm, int xim, struct blasfe
 void blasfeo_svecze(int m, struct blasfeo_svec *sm, int mi, struct blasfeo_svec *sv, int vi, struct blasfeo_svec *se, int ei);
 void blasfeo_svecnrm_inf(int m, struct blasfeo_svec *sx, int xi, float *ptr_norm);
 void blasfeo_svecnrm_2(int m, struct blasfeo_svec *sx, int xi, float *ptr_norm);
+// matrix norms: 1 (max abs column sum), inf (max abs row sum), Frobenius, max abs element
+void blasfeo_sgenrm_1(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm);
+void blasfeo_sgenrm_inf(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm);
+void blasfeo_sgenrm_fro(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm);
+void blasfeo_sgenrm_max(int m, int n, struct blasfeo_smat *sA, int ai, int aj, float *ptr_norm);
 void blasfeo_svecpe(int kmax, int *ipiv, struct blasfeo_svec *sx, int xi);
 void blasfeo_svecpei(int kmax, int *ipiv, struct blasfeo_svec *sx, int xi);
 
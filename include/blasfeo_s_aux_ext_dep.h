@@ -127,6 +127,21 @@ void blasfeo_print_exp_tran_svec(int m, struct blasfeo_svec *sa, int ai);
 void blasfeo_print_to_file_tran_svec(FILE *file, int m, struct blasfeo_svec *sa, int ai);
 // print to string the transposed of a strvec
 void blasfeo_print_to_string_tran_svec(char **buf_out, int m, struct blasfeo_svec *sa, int ai);
+// save a strmat to a binary file, together with its memory format; return 0 on success
+int blasfeo_save_smat(char *file_name, struct blasfeo_smat *sA);
+// create a strmat over the memory of a binary file saved by blasfeo_save_smat, mapped without copy
+// (copy-on-write); return 0 on success, 1 if the file can not be read, 2 if it is not a valid file
+// of the right type and version, 3 if its memory format does not match the one of this library
+int blasfeo_load_smat(char *file_name, struct blasfeo_smat *sA);
+// release a strmat created by blasfeo_load_smat
+void blasfeo_unload_smat(struct blasfeo_smat *sA);
+// save a strvec to a binary file, together with its memory format; return 0 on success
+int blasfeo_save_svec(char *file_name, struct blasfeo_svec *sa);
+// create a strvec over the memory of a binary file saved by blasfeo_save_svec, mapped without copy
+// (copy-on-write); return values as blasfeo_load_smat
+int blasfeo_load_svec(char *file_name, struct blasfeo_svec *sa);
+// release a strvec created by blasfeo_load_svec
+void blasfeo_unload_svec(struct blasfeo_svec *sa);
 
 #endif // EXT_DEP
 
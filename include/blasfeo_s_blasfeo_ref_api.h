@@ -119,6 +119,15 @@ void blasfeo_ref_ssymv_l_mn(int m, int n, float alpha, struct blasfeo_smat *sA,
 void blasfeo_ref_ssymv_u(int m, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi);
 // D = C + alpha * x * y^T
 void blasfeo_ref_sger(int m, int n, float alpha, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sy, int yi, struct blasfeo_smat *sC, int ci, int cj, struct blasfeo_smat *sD, int di, int dj);
+// multiple right-hand sides: sx, sy, sz are arrays of k vectors, and A is streamed once for (groups of) all of them
+// z[j] <= beta * y[j] + alpha * A * x[j], j=0,...,k-1
+void blasfeo_ref_sgemv_n_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi);
+// z[j] <= beta * y[j] + alpha * A^T * x[j], j=0,...,k-1
+void blasfeo_ref_sgemv_t_k(int m, int n, int k, float alpha, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, float beta, struct blasfeo_svec *sy, int yi, struct blasfeo_svec *sz, int zi);
+// z[j] <= inv( A ) * x[j], j=0,...,k-1, A (m)x(m) lower, not_transposed
+void blasfeo_ref_strsv_lnn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi);
+// z[j] <= inv( A^T ) * x[j], j=0,...,k-1, A (m)x(m) lower, transposed
+void blasfeo_ref_strsv_ltn_k(int m, int k, struct blasfeo_smat *sA, int ai, int aj, struct blasfeo_svec *sx, int xi, struct blasfeo_svec *sz, int zi);
 
 // diagonal
 
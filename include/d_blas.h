@@ -70,6 +70,11 @@ void dgeqrf_(int *m, int *n, double *A, int *lda, double *tau, double *work, int
 void dgeqr2_(int *m, int *n, double *A, int *lda, double *tau, double *work, int *info);
 void dgelqf_(int *m, int *n, double *A, int *lda, double *tau, double *work, int *lwork, int *info);
 void dorglq_(int *m, int *n, int *k, double *A, int *lda, double *tau, double *work, int *lwork, int *info);
+void dsytrf_(char *uplo, int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
+void dsytrs_(char *uplo, int *m, int *n, double *A, int *lda, int *ipiv, double *B, int *ldb, int *info);
+void dtrtri_(char *uplo, char *diag, int *m, double *A, int *lda, int *info);
+void dpotri_(char *uplo, int *m, double *A, int *lda, int *info);
+void dgetri_(int *m, double *A, int *lda, int *ipiv, double *work, int *lwork, int *info);
 
 
 
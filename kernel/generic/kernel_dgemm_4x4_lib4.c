@@ -42,7 +42,7 @@
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA)
 void kernel_dgemm_nt_4x4_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D)
 	{
 
@@ -711,7 +711,7 @@ void kernel_dgemm_nt_4x4_gen_lib4(int kmax, double *alpha, double *A, double *B,
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) //|| defined(TARGET_X64_AMD_BULLDOZER)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) //|| defined(TARGET_X64_AMD_BULLDOZER)
 void kernel_dgemm_nn_4x4_lib4(int kmax, double *alpha, double *A, int offsetB, double *B, int sdb, double *beta, double *C, double *D)
 	{
 
@@ -2285,7 +2285,7 @@ void kernel_dsyrk_nn_u_4x4_vs_lib4(int kmax, double *alpha, double *A, int offse
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR)
 void kernel_dsyrk_nt_l_4x4_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D)
 	{
 
@@ -2320,7 +2320,7 @@ void kernel_dsyrk_nt_l_4x4_lib4(int kmax, double *alpha, double *A, double *B, d
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
 void kernel_dsyrk_nt_l_4x4_vs_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D, int km, int kn)
 	{
 
@@ -2413,6 +2413,7 @@ void kernel_dsyrk_nt_l_4x4_gen_lib4(int kmax, double *alpha, double *A, double *
 	double
 		*C1, *D1;
 
+	// load the full block, since the n0 shift moves upper entries into the stored lower part
 	if(offsetC==0)
 		{
 		CC[0+bs*0] = beta[0]*C0[0+bs*0];
@@ -2420,13 +2421,19 @@ void kernel_dsyrk_nt_l_4x4_gen_lib4(int kmax, double *alpha, double *A, double *
 		CC[2+bs*0] = beta[0]*C0[2+bs*0];
 		CC[3+bs*0] = beta[0]*C0[3+bs*0];
 
+		CC[0+bs*1] = beta[0]*C0[0+bs*1];
 		CC[1+bs*1] = beta[0]*C0[1+bs*1];
 		CC[2+bs*1] = beta[0]*C0[2+bs*1];
 		CC[3+bs*1] = beta[0]*C0[3+bs*1];
 
+		CC[0+bs*2] = beta[0]*C0[0+bs*2];
+		CC[1+bs*2] = beta[0]*C0[1+bs*2];
 		CC[2+bs*2] = beta[0]*C0[2+bs*2];
 		CC[3+bs*2] = beta[0]*C0[3+bs*2];
 
+		CC[0+bs*3] = beta[0]*C0[0+bs*3];
+		CC[1+bs*3] = beta[0]*C0[1+bs*3];
+		CC[2+bs*3] = beta[0]*C0[2+bs*3];
 		CC[3+bs*3] = beta[0]*C0[3+bs*3];
 		}
 	else if(offsetC==1)
@@ -2438,13 +2445,19 @@ void kernel_dsyrk_nt_l_4x4_gen_lib4(int kmax, double *alpha, double *A, double *
 		CC[2+bs*0] = beta[0]*C0[3+bs*0];
 		CC[3+bs*0] = beta[0]*C1[0+bs*0];
 
+		CC[0+bs*1] = beta[0]*C0[1+bs*1];
 		CC[1+bs*1] = beta[0]*C0[2+bs*1];
 		CC[2+bs*1] = beta[0]*C0[3+bs*1];
 		CC[3+bs*1] = beta[0]*C1[0+bs*1];
 
+		CC[0+bs*2] = beta[0]*C0[1+bs*2];
+		CC[1+bs*2] = beta[0]*C0[2+bs*2];
 		CC[2+bs*2] = beta[0]*C0[3+bs*2];
 		CC[3+bs*2] = beta[0]*C1[0+bs*2];
 
+		CC[0+bs*3] = beta[0]*C0[1+bs*3];
+		CC[1+bs*3] = beta[0]*C0[2+bs*3];
+		CC[2+bs*3] = beta[0]*C0[3+bs*3];
 		CC[3+bs*3] = beta[0]*C1[0+bs*3];
 		}
 	else if(offsetC==2)
@@ -2456,13 +2469,19 @@ void kernel_dsyrk_nt_l_4x4_gen_lib4(int kmax, double *alpha, double *A, double *
 		CC[2+bs*0] = beta[0]*C1[0+bs*0];
 		CC[3+bs*0] = beta[0]*C1[1+bs*0];
 
+		CC[0+bs*1] = beta[0]*C0[2+bs*1];
 		CC[1+bs*1] = beta[0]*C0[3+bs*1];
 		CC[2+bs*1] = beta[0]*C1[0+bs*1];
 		CC[3+bs*1] = beta[0]*C1[1+bs*1];
 
+		CC[0+bs*2] = beta[0]*C0[2+bs*2];
+		CC[1+bs*2] = beta[0]*C0[3+bs*2];
 		CC[2+bs*2] = beta[0]*C1[0+bs*2];
 		CC[3+bs*2] = beta[0]*C1[1+bs*2];
 
+		CC[0+bs*3] = beta[0]*C0[2+bs*3];
+		CC[1+bs*3] = beta[0]*C0[3+bs*3];
+		CC[2+bs*3] = beta[0]*C1[0+bs*3];
 		CC[3+bs*3] = beta[0]*C1[1+bs*3];
 		}
 	else //if(offsetC==3)
@@ -2474,13 +2493,19 @@ void kernel_dsyrk_nt_l_4x4_gen_lib4(int kmax, double *alpha, double *A, double *
 		CC[2+bs*0] = beta[0]*C1[1+bs*0];
 		CC[3+bs*0] = beta[0]*C1[2+bs*0];
 
+		CC[0+bs*1] = beta[0]*C0[3+bs*1];
 		CC[1+bs*1] = beta[0]*C1[0+bs*1];
 		CC[2+bs*1] = beta[0]*C1[1+bs*1];
 		CC[3+bs*1] = beta[0]*C1[2+bs*1];
 
+		CC[0+bs*2] = beta[0]*C0[3+bs*2];
+		CC[1+bs*2] = beta[0]*C1[0+bs*2];
 		CC[2+bs*2] = beta[0]*C1[1+bs*2];
 		CC[3+bs*2] = beta[0]*C1[2+bs*2];
 
+		CC[0+bs*3] = beta[0]*C0[3+bs*3];
+		CC[1+bs*3] = beta[0]*C1[0+bs*3];
+		CC[2+bs*3] = beta[0]*C1[1+bs*3];
 		CC[3+bs*3] = beta[0]*C1[2+bs*3];
 		}
 	
@@ -5674,7 +5699,7 @@ void kernel_dtrmm_nn_rl_4x4_gen_lib4(int kmax, double *alpha, double *A, int off
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR)
 void kernel_dpotrf_nt_l_4x4_lib4(int kmax, double *A, double *B, double *C, double *D, double *inv_diag_D)
 	{
 
@@ -5783,7 +5808,7 @@ void kernel_dpotrf_nt_l_4x4_lib4(int kmax, double *A, double *B, double *C, doub
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_X86_AMD_JAGUAR) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
 void kernel_dpotrf_nt_l_4x4_vs_lib4(int kmax, double *A, double *B, double *C, double *D, double *inv_diag_D, int km, int kn)
 	{
 
@@ -5966,7 +5991,7 @@ void kernel_dsyrk_dpotrf_nt_l_4x4_vs_lib4(int kp, double *Ap, double *Bp, int km
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA)
 void kernel_dtrsm_nt_rl_inv_4x4_lib4(int kmax, double *A, double *B, double *beta, double *C, double *D, double *E, double *inv_diag_E)
 	{
 
@@ -6065,7 +6090,7 @@ void kernel_dtrsm_nt_rl_inv_4x4_lib4(int kmax, double *A, double *B, double *bet
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X86_AMD_BARCELONA) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9)
 void kernel_dtrsm_nt_rl_inv_4x4_vs_lib4(int kmax, double *A, double *B, double *beta, double *C, double *D, double *E, double *inv_diag_E, int km, int kn)
 	{
 
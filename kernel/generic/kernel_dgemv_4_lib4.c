@@ -39,7 +39,7 @@
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X64_AMD_BULLDOZER) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9) //|| defined(TARGET_ARMV8A_ARM_CORTEX_A57) || defined(TARGET_ARMV8A_ARM_CORTEX_A53)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X64_AMD_BULLDOZER) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9) //|| defined(TARGET_ARMV8A_ARM_CORTEX_A57) || defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 void kernel_dgemv_n_4_lib4(int kmax, double *alpha, double *A, double *x, double *beta, double *y, double *z)
 	{
 
@@ -172,7 +172,7 @@ void kernel_dgemv_n_4_gen_lib4(int kmax, double *alpha, double *A, double *x, do
 
 
 
-#if defined(TARGET_GENERIC) || defined(TARGET_X64_AMD_BULLDOZER) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9) //|| defined(TARGET_ARMV8A_ARM_CORTEX_A57) || defined(TARGET_ARMV8A_ARM_CORTEX_A53)
+#if ( defined(TARGET_GENERIC) && !defined(TARGET_GENERIC_SIMD) ) || defined(TARGET_X64_AMD_BULLDOZER) || defined(TARGET_ARMV7A_ARM_CORTEX_A15) || defined(TARGET_ARMV7A_ARM_CORTEX_A7) || defined(TARGET_ARMV7A_ARM_CORTEX_A9) //|| defined(TARGET_ARMV8A_ARM_CORTEX_A57) || defined(TARGET_ARMV8A_ARM_CORTEX_A53)
 void kernel_dgemv_t_4_lib4(int kmax, double *alpha, int offA, double *A, int sda, double *x, double *beta, double *y, double *z)
 	{
 
@@ -1611,6 +1611,441 @@ void kernel_dtrmv_ut_4_lib4(int kmax, double *A, int sda, double *x, double *z)
 
 
 
+// multiple right-hand sides: x, y and z are arrays of 4 vector pointers, and A is streamed once for all of them
+void kernel_dgemv_n_4_k4_lib4(int kmax, double *alpha, double *A, double **x, double *beta, double **y, double **z)
+	{
+
+	const int bs = 4;
+
+	int k, jj;
+
+	double
+		a_0, a_1, a_2, a_3,
+		x_0;
+
+	double *x0 = x[0];
+	double *x1 = x[1];
+	double *x2 = x[2];
+	double *x3 = x[3];
+
+	double yy[16] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+	for(k=0; k<kmax; k++)
+		{
+
+		a_0 = A[0];
+		a_1 = A[1];
+		a_2 = A[2];
+		a_3 = A[3];
+
+		x_0 = x0[k];
+		yy[0+bs*0] += a_0 * x_0;
+		yy[1+bs*0] += a_1 * x_0;
+		yy[2+bs*0] += a_2 * x_0;
+		yy[3+bs*0] += a_3 * x_0;
+
+		x_0 = x1[k];
+		yy[0+bs*1] += a_0 * x_0;
+		yy[1+bs*1] += a_1 * x_0;
+		yy[2+bs*1] += a_2 * x_0;
+		yy[3+bs*1] += a_3 * x_0;
+
+		x_0 = x2[k];
+		yy[0+bs*2] += a_0 * x_0;
+		yy[1+bs*2] += a_1 * x_0;
+		yy[2+bs*2] += a_2 * x_0;
+		yy[3+bs*2] += a_3 * x_0;
+
+		x_0 = x3[k];
+		yy[0+bs*3] += a_0 * x_0;
+		yy[1+bs*3] += a_1 * x_0;
+		yy[2+bs*3] += a_2 * x_0;
+		yy[3+bs*3] += a_3 * x_0;
+
+		A += bs;
+
+		}
+
+	// scale (all loads before stores, to allow for duplicated or in-place vectors)
+	if(beta[0]==0.0)
+		{
+		for(jj=0; jj<4; jj++)
+			{
+			yy[0+bs*jj] = alpha[0]*yy[0+bs*jj];
+			yy[1+bs*jj] = alpha[0]*yy[1+bs*jj];
+			yy[2+bs*jj] = alpha[0]*yy[2+bs*jj];
+			yy[3+bs*jj] = alpha[0]*yy[3+bs*jj];
+			}
+		}
+	else
+		{
+		for(jj=0; jj<4; jj++)
+			{
+			yy[0+bs*jj] = alpha[0]*yy[0+bs*jj] + beta[0]*y[jj][0];
+			yy[1+bs*jj] = alpha[0]*yy[1+bs*jj] + beta[0]*y[jj][1];
+			yy[2+bs*jj] = alpha[0]*yy[2+bs*jj] + beta[0]*y[jj][2];
+			yy[3+bs*jj] = alpha[0]*yy[3+bs*jj] + beta[0]*y[jj][3];
+			}
+		}
+
+	// store
+	for(jj=0; jj<4; jj++)
+		{
+		z[jj][0] = yy[0+bs*jj];
+		z[jj][1] = yy[1+bs*jj];
+		z[jj][2] = yy[2+bs*jj];
+		z[jj][3] = yy[3+bs*jj];
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dgemv_n_4_k4_gen_lib4(int kmax, double *alpha, double *A, double **x, double *beta, double **y, double **z, int m0, int m1)
+	{
+
+	const int bs = 4;
+
+	int ii, jj;
+
+	double yy[16];
+	double *pyy[4] = {yy+0*bs, yy+1*bs, yy+2*bs, yy+3*bs};
+
+	// y is only read in the [m0,m1) range
+	double yt[16] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	double *pyt[4] = {yt+0*bs, yt+1*bs, yt+2*bs, yt+3*bs};
+	if(beta[0]!=0.0)
+		for(jj=0; jj<4; jj++)
+			for(ii=m0; ii<m1 & ii<4; ii++)
+				yt[ii+bs*jj] = y[jj][ii];
+
+	kernel_dgemv_n_4_k4_lib4(kmax, alpha, A, x, beta, pyt, pyy);
+
+	for(jj=0; jj<4; jj++)
+		for(ii=m0; ii<m1 & ii<4; ii++)
+			z[jj][ii] = yy[ii+bs*jj];
+
+	return;
+
+	}
+
+
+
+void kernel_dgemv_t_4_k4_lib4(int kmax, double *alpha, int offA, double *A, int sda, double **x, double *beta, double **y, double **z)
+	{
+
+	const int bs = 4;
+
+	int k, kend, jj;
+
+	double
+		a_0, a_1, a_2, a_3,
+		x_0;
+
+	double *x0 = x[0];
+	double *x1 = x[1];
+	double *x2 = x[2];
+	double *x3 = x[3];
+
+	double yy[16] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+	k = 0;
+	// first (possibly partial) panel
+	kend = bs-offA<kmax ? bs-offA : kmax;
+	while(k<kmax)
+		{
+		for(; k<kend; k++)
+			{
+
+			a_0 = A[0+bs*0];
+			a_1 = A[0+bs*1];
+			a_2 = A[0+bs*2];
+			a_3 = A[0+bs*3];
+
+			x_0 = x0[k];
+			yy[0+bs*0] += a_0 * x_0;
+			yy[1+bs*0] += a_1 * x_0;
+			yy[2+bs*0] += a_2 * x_0;
+			yy[3+bs*0] += a_3 * x_0;
+
+			x_0 = x1[k];
+			yy[0+bs*1] += a_0 * x_0;
+			yy[1+bs*1] += a_1 * x_0;
+			yy[2+bs*1] += a_2 * x_0;
+			yy[3+bs*1] += a_3 * x_0;
+
+			x_0 = x2[k];
+			yy[0+bs*2] += a_0 * x_0;
+			yy[1+bs*2] += a_1 * x_0;
+			yy[2+bs*2] += a_2 * x_0;
+			yy[3+bs*2] += a_3 * x_0;
+
+			x_0 = x3[k];
+			yy[0+bs*3] += a_0 * x_0;
+			yy[1+bs*3] += a_1 * x_0;
+			yy[2+bs*3] += a_2 * x_0;
+			yy[3+bs*3] += a_3 * x_0;
+
+			A += 1;
+
+			}
+		// next panel
+		A += bs*(sda-1);
+		kend = k+bs<kmax ? k+bs : kmax;
+		}
+
+	// scale (all loads before stores, to allow for duplicated or in-place vectors)
+	if(beta[0]==0.0)
+		{
+		for(jj=0; jj<4; jj++)
+			{
+			yy[0+bs*jj] = alpha[0]*yy[0+bs*jj];
+			yy[1+bs*jj] = alpha[0]*yy[1+bs*jj];
+			yy[2+bs*jj] = alpha[0]*yy[2+bs*jj];
+			yy[3+bs*jj] = alpha[0]*yy[3+bs*jj];
+			}
+		}
+	else
+		{
+		for(jj=0; jj<4; jj++)
+			{
+			yy[0+bs*jj] = alpha[0]*yy[0+bs*jj] + beta[0]*y[jj][0];
+			yy[1+bs*jj] = alpha[0]*yy[1+bs*jj] + beta[0]*y[jj][1];
+			yy[2+bs*jj] = alpha[0]*yy[2+bs*jj] + beta[0]*y[jj][2];
+			yy[3+bs*jj] = alpha[0]*yy[3+bs*jj] + beta[0]*y[jj][3];
+			}
+		}
+
+	// store
+	for(jj=0; jj<4; jj++)
+		{
+		z[jj][0] = yy[0+bs*jj];
+		z[jj][1] = yy[1+bs*jj];
+		z[jj][2] = yy[2+bs*jj];
+		z[jj][3] = yy[3+bs*jj];
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dgemv_t_4_k4_vs_lib4(int kmax, double *alpha, int offA, double *A, int sda, double **x, double *beta, double **y, double **z, int n1)
+	{
+
+	const int bs = 4;
+
+	int ii, jj;
+
+	double yy[16];
+	double *pyy[4] = {yy+0*bs, yy+1*bs, yy+2*bs, yy+3*bs};
+
+	// y is only read for the first n1 entries
+	double yt[16] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	double *pyt[4] = {yt+0*bs, yt+1*bs, yt+2*bs, yt+3*bs};
+	if(beta[0]!=0.0)
+		for(jj=0; jj<4; jj++)
+			for(ii=0; ii<n1 & ii<4; ii++)
+				yt[ii+bs*jj] = y[jj][ii];
+
+	kernel_dgemv_t_4_k4_lib4(kmax, alpha, offA, A, sda, x, beta, pyt, pyy);
+
+	for(jj=0; jj<4; jj++)
+		for(ii=0; ii<n1 & ii<4; ii++)
+			z[jj][ii] = yy[ii+bs*jj];
+
+	return;
+
+	}
+
+
+
+void kernel_dtrsv_ln_inv_4_k4_vs_lib4(int kmax, double *A, double *inv_diag_A, double **x, double **y, double **z, int m1, int n1)
+	{
+
+	const int bs = 4;
+
+	int ii, jj;
+
+	double yy[16];
+	double *pyy[4] = {yy+0*bs, yy+1*bs, yy+2*bs, yy+3*bs};
+
+	double yt[16] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	double *pyt[4] = {yt+0*bs, yt+1*bs, yt+2*bs, yt+3*bs};
+	for(jj=0; jj<4; jj++)
+		for(ii=0; ii<m1 & ii<4; ii++)
+			yt[ii+bs*jj] = y[jj][ii];
+
+	double alpha1 = -1.0;
+	double beta1  = 1.0;
+
+	int k1 = kmax/bs*bs;
+
+	kernel_dgemv_n_4_k4_lib4(k1, &alpha1, A, x, &beta1, pyt, pyy);
+
+	A += k1*bs;
+
+	double
+		a_00, a_10, a_20, a_30,
+		a_11, a_21, a_31,
+		a_22, a_32,
+		a_33;
+
+	a_00 = inv_diag_A[0];
+	a_10 = A[1+bs*0];
+	a_20 = A[2+bs*0];
+	a_30 = A[3+bs*0];
+	a_11 = n1>1 ? inv_diag_A[1] : 0.0;
+	a_21 = A[2+bs*1];
+	a_31 = A[3+bs*1];
+	a_22 = n1>2 ? inv_diag_A[2] : 0.0;
+	a_32 = A[3+bs*2];
+	a_33 = n1>3 ? inv_diag_A[3] : 0.0;
+
+	for(jj=0; jj<4; jj++)
+		{
+		yy[0+bs*jj] *= a_00;
+		yy[1+bs*jj] -= a_10 * yy[0+bs*jj];
+		yy[2+bs*jj] -= a_20 * yy[0+bs*jj];
+		yy[3+bs*jj] -= a_30 * yy[0+bs*jj];
+		if(n1>1)
+			{
+			yy[1+bs*jj] *= a_11;
+			yy[2+bs*jj] -= a_21 * yy[1+bs*jj];
+			yy[3+bs*jj] -= a_31 * yy[1+bs*jj];
+			}
+		if(n1>2)
+			{
+			yy[2+bs*jj] *= a_22;
+			yy[3+bs*jj] -= a_32 * yy[2+bs*jj];
+			}
+		if(n1>3)
+			{
+			yy[3+bs*jj] *= a_33;
+			}
+		}
+
+	for(jj=0; jj<4; jj++)
+		for(ii=0; ii<m1 & ii<4; ii++)
+			z[jj][ii] = yy[ii+bs*jj];
+
+	return;
+
+	}
+
+
+
+void kernel_dtrsv_ln_inv_4_k4_lib4(int kmax, double *A, double *inv_diag_A, double **x, double **y, double **z)
+	{
+
+	const int bs = 4;
+
+	int jj;
+
+	double yy[16];
+	double *pyy[4] = {yy+0*bs, yy+1*bs, yy+2*bs, yy+3*bs};
+
+	double alpha1 = -1.0;
+	double beta1  = 1.0;
+
+	int k1 = kmax/bs*bs;
+
+	kernel_dgemv_n_4_k4_lib4(k1, &alpha1, A, x, &beta1, y, pyy);
+
+	A += k1*bs;
+
+	double
+		a_00, a_10, a_20, a_30,
+		a_11, a_21, a_31,
+		a_22, a_32,
+		a_33;
+
+	a_00 = inv_diag_A[0];
+	a_10 = A[1+bs*0];
+	a_20 = A[2+bs*0];
+	a_30 = A[3+bs*0];
+	a_11 = inv_diag_A[1];
+	a_21 = A[2+bs*1];
+	a_31 = A[3+bs*1];
+	a_22 = inv_diag_A[2];
+	a_32 = A[3+bs*2];
+	a_33 = inv_diag_A[3];
+
+	for(jj=0; jj<4; jj++)
+		{
+		yy[0+bs*jj] *= a_00;
+		yy[1+bs*jj] -= a_10 * yy[0+bs*jj];
+		yy[2+bs*jj] -= a_20 * yy[0+bs*jj];
+		yy[3+bs*jj] -= a_30 * yy[0+bs*jj];
+		yy[1+bs*jj] *= a_11;
+		yy[2+bs*jj] -= a_21 * yy[1+bs*jj];
+		yy[3+bs*jj] -= a_31 * yy[1+bs*jj];
+		yy[2+bs*jj] *= a_22;
+		yy[3+bs*jj] -= a_32 * yy[2+bs*jj];
+		yy[3+bs*jj] *= a_33;
+		}
+
+	for(jj=0; jj<4; jj++)
+		{
+		z[jj][0] = yy[0+bs*jj];
+		z[jj][1] = yy[1+bs*jj];
+		z[jj][2] = yy[2+bs*jj];
+		z[jj][3] = yy[3+bs*jj];
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dtrsv_lt_inv_4_k4_lib4(int kmax, double *A, int sda, double *inv_diag_A, double **x, double **y, double **z)
+	{
+
+	const int bs = 4;
+
+	int jj;
+
+	double yy[16];
+	double *pyy[4] = {yy+0*bs, yy+1*bs, yy+2*bs, yy+3*bs};
+	double *x4[4] = {x[0]+4, x[1]+4, x[2]+4, x[3]+4};
+
+	double alpha = -1.0;
+	double beta = 1.0;
+	kernel_dgemv_t_4_k4_lib4(kmax-4, &alpha, 0, A+4+(sda-1)*bs, sda, x4, &beta, y, pyy);
+
+	for(jj=0; jj<4; jj++)
+		{
+		// bottom trinagle
+		yy[3+bs*jj] *= inv_diag_A[3];
+		yy[2+bs*jj] -= A[3+bs*2] * yy[3+bs*jj];
+		yy[2+bs*jj] *= inv_diag_A[2];
+		// square
+		yy[0+bs*jj] -= A[2+bs*0]*yy[2+bs*jj] + A[3+bs*0]*yy[3+bs*jj];
+		yy[1+bs*jj] -= A[2+bs*1]*yy[2+bs*jj] + A[3+bs*1]*yy[3+bs*jj];
+		// top trinagle
+		yy[1+bs*jj] *= inv_diag_A[1];
+		yy[0+bs*jj] -= A[1+bs*0] * yy[1+bs*jj];
+		yy[0+bs*jj] *= inv_diag_A[0];
+		}
+
+	for(jj=0; jj<4; jj++)
+		{
+		z[jj][0] = yy[0+bs*jj];
+		z[jj][1] = yy[1+bs*jj];
+		z[jj][2] = yy[2+bs*jj];
+		z[jj][3] = yy[3+bs*jj];
+		}
+
+	return;
+
+	}
+
+
+
 //#if defined(BLAS_API)
 #if ( defined(BLAS_API) | ( defined(LA_HIGH_PERFORMANCE) & defined(MF_COLMAJ) ) )
 
@@ -0,0 +1,480 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * 4x4 panel-major kernels written with the GCC/Clang vector extensions (TARGET=GENERIC_SIMD).
+ *
+ * A column of D is held in a 4-wide vector, the compiler maps it to the native SIMD registers
+ * selected by -march (one 256-bit register, two 128-bit registers, or a scalable vector).
+ * The remaining generic 4x4 kernels (vs, gen, trmm, ...) are built on top of these ones.
+ */
+
+#include <math.h>
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_kernel.h>
+
+
+
+// 4 doubles, one column of a panel
+typedef double v4d __attribute__ ((vector_size (32)));
+// same, for loads and stores at any double-aligned address
+typedef double v4d_u __attribute__ ((vector_size (32), aligned (8), may_alias));
+
+
+
+// c_j <= sum_k A(:,k) * B(j,k), computed with two sets of accumulators for even and odd k
+static inline void kernel_dgemm_nt_4x4_acc(int kmax, double *A, double *B, v4d *c)
+	{
+
+	v4d
+		a_0, a_1,
+		c_0 = {0}, c_1 = {0}, c_2 = {0}, c_3 = {0},
+		d_0 = {0}, d_1 = {0}, d_2 = {0}, d_3 = {0};
+
+	int k;
+
+	for(k=0; k<kmax-3; k+=4)
+		{
+
+		a_0 = *(v4d_u *) &A[0];
+		a_1 = *(v4d_u *) &A[4];
+
+		c_0 += a_0 * B[0];
+		c_1 += a_0 * B[1];
+		c_2 += a_0 * B[2];
+		c_3 += a_0 * B[3];
+
+		d_0 += a_1 * B[4];
+		d_1 += a_1 * B[5];
+		d_2 += a_1 * B[6];
+		d_3 += a_1 * B[7];
+
+		a_0 = *(v4d_u *) &A[8];
+		a_1 = *(v4d_u *) &A[12];
+
+		c_0 += a_0 * B[8];
+		c_1 += a_0 * B[9];
+		c_2 += a_0 * B[10];
+		c_3 += a_0 * B[11];
+
+		d_0 += a_1 * B[12];
+		d_1 += a_1 * B[13];
+		d_2 += a_1 * B[14];
+		d_3 += a_1 * B[15];
+
+		A += 16;
+		B += 16;
+
+		}
+	for(; k<kmax; k++)
+		{
+
+		a_0 = *(v4d_u *) &A[0];
+
+		c_0 += a_0 * B[0];
+		c_1 += a_0 * B[1];
+		c_2 += a_0 * B[2];
+		c_3 += a_0 * B[3];
+
+		A += 4;
+		B += 4;
+
+		}
+
+	c[0] = c_0 + d_0;
+	c[1] = c_1 + d_1;
+	c[2] = c_2 + d_2;
+	c[3] = c_3 + d_3;
+
+	return;
+
+	}
+
+
+
+// c_j <= sum_k A(:,k) * B(k,j), B panel-major starting at row offsetB of its panel
+static inline void kernel_dgemm_nn_4x4_acc(int kmax, double *A, int offsetB, double *B, int sdb, v4d *c)
+	{
+
+	const int bs = 4;
+
+	v4d
+		a_0, a_1,
+		c_0 = {0}, c_1 = {0}, c_2 = {0}, c_3 = {0},
+		d_0 = {0}, d_1 = {0}, d_2 = {0}, d_3 = {0};
+
+	int k, kend;
+
+	k = 0;
+	if(offsetB!=0)
+		{
+		B += offsetB;
+		kend = bs-offsetB<kmax ? bs-offsetB : kmax;
+		for(; k<kend; k++)
+			{
+			a_0 = *(v4d_u *) &A[0];
+			c_0 += a_0 * B[0+bs*0];
+			c_1 += a_0 * B[0+bs*1];
+			c_2 += a_0 * B[0+bs*2];
+			c_3 += a_0 * B[0+bs*3];
+			A += 4;
+			B += 1;
+			}
+		B += bs*(sdb-1);
+		}
+	for(; k<kmax-3; k+=4)
+		{
+
+		a_0 = *(v4d_u *) &A[0];
+		a_1 = *(v4d_u *) &A[4];
+
+		c_0 += a_0 * B[0+bs*0];
+		c_1 += a_0 * B[0+bs*1];
+		c_2 += a_0 * B[0+bs*2];
+		c_3 += a_0 * B[0+bs*3];
+
+		d_0 += a_1 * B[1+bs*0];
+		d_1 += a_1 * B[1+bs*1];
+		d_2 += a_1 * B[1+bs*2];
+		d_3 += a_1 * B[1+bs*3];
+
+		a_0 = *(v4d_u *) &A[8];
+		a_1 = *(v4d_u *) &A[12];
+
+		c_0 += a_0 * B[2+bs*0];
+		c_1 += a_0 * B[2+bs*1];
+		c_2 += a_0 * B[2+bs*2];
+		c_3 += a_0 * B[2+bs*3];
+
+		d_0 += a_1 * B[3+bs*0];
+		d_1 += a_1 * B[3+bs*1];
+		d_2 += a_1 * B[3+bs*2];
+		d_3 += a_1 * B[3+bs*3];
+
+		A += 16;
+		B += bs*sdb;
+
+		}
+	for(; k<kmax; k++)
+		{
+
+		a_0 = *(v4d_u *) &A[0];
+
+		c_0 += a_0 * B[0+bs*0];
+		c_1 += a_0 * B[0+bs*1];
+		c_2 += a_0 * B[0+bs*2];
+		c_3 += a_0 * B[0+bs*3];
+
+		A += 4;
+		B += 1;
+
+		}
+
+	c[0] = c_0 + d_0;
+	c[1] = c_1 + d_1;
+	c[2] = c_2 + d_2;
+	c[3] = c_3 + d_3;
+
+	return;
+
+	}
+
+
+
+// c_j <= beta * C(:,j) + alpha * c_j
+static inline void kernel_dgemm_4x4_scale(double alpha, double beta, double *C, v4d *c)
+	{
+
+	const int bs = 4;
+
+	c[0] = beta * *(v4d_u *) &C[0+bs*0] + alpha * c[0];
+	c[1] = beta * *(v4d_u *) &C[0+bs*1] + alpha * c[1];
+	c[2] = beta * *(v4d_u *) &C[0+bs*2] + alpha * c[2];
+	c[3] = beta * *(v4d_u *) &C[0+bs*3] + alpha * c[3];
+
+	return;
+
+	}
+
+
+
+// store rows [0,km) and columns [0,kn) of c, only on and below the diagonal if lower!=0
+static inline void kernel_dgemm_4x4_store_vs(int lower, v4d *c, double *D, int km, int kn)
+	{
+
+	const int bs = 4;
+
+	int ii, jj;
+
+	if(km>=4 & kn>=4 & !lower)
+		{
+		*(v4d_u *) &D[0+bs*0] = c[0];
+		*(v4d_u *) &D[0+bs*1] = c[1];
+		*(v4d_u *) &D[0+bs*2] = c[2];
+		*(v4d_u *) &D[0+bs*3] = c[3];
+		return;
+		}
+
+	km = km<4 ? km : 4;
+	kn = kn<4 ? kn : 4;
+	for(jj=0; jj<kn; jj++)
+		{
+		for(ii=lower ? jj : 0; ii<km; ii++)
+			{
+			D[ii+bs*jj] = c[jj][ii];
+			}
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dgemm_nt_4x4_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D)
+	{
+
+	const int bs = 4;
+
+	v4d c[4];
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(alpha[0], beta[0], C, c);
+
+	*(v4d_u *) &D[0+bs*0] = c[0];
+	*(v4d_u *) &D[0+bs*1] = c[1];
+	*(v4d_u *) &D[0+bs*2] = c[2];
+	*(v4d_u *) &D[0+bs*3] = c[3];
+
+	return;
+
+	}
+
+
+
+void kernel_dgemm_nn_4x4_lib4(int kmax, double *alpha, double *A, int offsetB, double *B, int sdb, double *beta, double *C, double *D)
+	{
+
+	const int bs = 4;
+
+	v4d c[4];
+
+	kernel_dgemm_nn_4x4_acc(kmax, A, offsetB, B, sdb, c);
+
+	kernel_dgemm_4x4_scale(alpha[0], beta[0], C, c);
+
+	*(v4d_u *) &D[0+bs*0] = c[0];
+	*(v4d_u *) &D[0+bs*1] = c[1];
+	*(v4d_u *) &D[0+bs*2] = c[2];
+	*(v4d_u *) &D[0+bs*3] = c[3];
+
+	return;
+
+	}
+
+
+
+void kernel_dsyrk_nt_l_4x4_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D)
+	{
+
+	v4d c[4];
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(alpha[0], beta[0], C, c);
+
+	kernel_dgemm_4x4_store_vs(1, c, D, 4, 4);
+
+	return;
+
+	}
+
+
+
+void kernel_dsyrk_nt_l_4x4_vs_lib4(int kmax, double *alpha, double *A, double *B, double *beta, double *C, double *D, int km, int kn)
+	{
+
+	v4d c[4];
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(alpha[0], beta[0], C, c);
+
+	kernel_dgemm_4x4_store_vs(1, c, D, km, kn);
+
+	return;
+
+	}
+
+
+
+// factorize the columns [0,kn) of c in place, a non-positive pivot gives a zero column
+static inline void kernel_dpotrf_4x4_fact(v4d *c, double *inv_diag_D, int kn)
+	{
+
+	double d, tmp;
+
+	int jj, ii;
+
+	for(jj=0; jj<kn; jj++)
+		{
+		for(ii=0; ii<jj; ii++)
+			{
+			c[jj] -= c[ii] * c[ii][jj];
+			}
+		d = c[jj][jj];
+		if(d>0)
+			{
+			d = sqrt(d);
+			tmp = 1.0/d;
+			}
+		else
+			{
+			d = 0.0;
+			tmp = 0.0;
+			}
+		c[jj] *= tmp;
+		c[jj][jj] = d;
+		inv_diag_D[jj] = tmp;
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dpotrf_nt_l_4x4_lib4(int kmax, double *A, double *B, double *C, double *D, double *inv_diag_D)
+	{
+
+	v4d c[4];
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(-1.0, 1.0, C, c);
+
+	kernel_dpotrf_4x4_fact(c, inv_diag_D, 4);
+
+	kernel_dgemm_4x4_store_vs(1, c, D, 4, 4);
+
+	return;
+
+	}
+
+
+
+void kernel_dpotrf_nt_l_4x4_vs_lib4(int kmax, double *A, double *B, double *C, double *D, double *inv_diag_D, int km, int kn)
+	{
+
+	v4d c[4];
+
+	kn = kn<4 ? kn : 4;
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(-1.0, 1.0, C, c);
+
+	kernel_dpotrf_4x4_fact(c, inv_diag_D, kn);
+
+	kernel_dgemm_4x4_store_vs(1, c, D, km, kn);
+
+	return;
+
+	}
+
+
+
+// solve the columns [0,kn) of c with the transposed of the lower triangular E
+static inline void kernel_dtrsm_rl_inv_4x4_solve(v4d *c, double *E, double *inv_diag_E, int kn)
+	{
+
+	const int bs = 4;
+
+	int jj, ii;
+
+	for(jj=0; jj<kn; jj++)
+		{
+		for(ii=0; ii<jj; ii++)
+			{
+			c[jj] -= c[ii] * E[jj+bs*ii];
+			}
+		c[jj] *= inv_diag_E[jj];
+		}
+
+	return;
+
+	}
+
+
+
+void kernel_dtrsm_nt_rl_inv_4x4_lib4(int kmax, double *A, double *B, double *beta, double *C, double *D, double *E, double *inv_diag_E)
+	{
+
+	v4d c[4];
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(-1.0, beta[0], C, c);
+
+	kernel_dtrsm_rl_inv_4x4_solve(c, E, inv_diag_E, 4);
+
+	kernel_dgemm_4x4_store_vs(0, c, D, 4, 4);
+
+	return;
+
+	}
+
+
+
+void kernel_dtrsm_nt_rl_inv_4x4_vs_lib4(int kmax, double *A, double *B, double *beta, double *C, double *D, double *E, double *inv_diag_E, int km, int kn)
+	{
+
+	v4d c[4];
+
+	kn = kn<4 ? kn : 4;
+
+	kernel_dgemm_nt_4x4_acc(kmax, A, B, c);
+
+	kernel_dgemm_4x4_scale(-1.0, beta[0], C, c);
+
+	kernel_dtrsm_rl_inv_4x4_solve(c, E, inv_diag_E, kn);
+
+	kernel_dgemm_4x4_store_vs(0, c, D, km, kn);
+
+	return;
+
+	}
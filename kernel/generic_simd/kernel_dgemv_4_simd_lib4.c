@@ -0,0 +1,188 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of BLASFEO.                                                                   *
+*                                                                                                 *
+* BLASFEO -- BLAS For Embedded Optimization.                                                      *
+* Copyright (C) 2019 by Gianluca Frison.                                                          *
+* Developed at IMTEK (University of Freiburg) under the supervision of Moritz Diehl.              *
+* All rights reserved.                                                                            *
+*                                                                                                 *
+* The 2-Clause BSD License                                                                        *
+*                                                                                                 *
+* Redistribution and use in source and binary forms, with or without                              *
+* modification, are permitted provided that the following conditions are met:                     *
+*                                                                                                 *
+* 1. Redistributions of source code must retain the above copyright notice, this                  *
+*    list of conditions and the following disclaimer.                                             *
+* 2. Redistributions in binary form must reproduce the above copyright notice,                    *
+*    this list of conditions and the following disclaimer in the documentation                    *
+*    and/or other materials provided with the distribution.                                       *
+*                                                                                                 *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND                 *
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED                   *
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE                          *
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR                 *
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES                  *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;                    *
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND                     *
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT                      *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS                   *
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                    *
+*                                                                                                 *
+* Author: Gianluca Frison, gianluca.frison (at) imtek.uni-freiburg.de                             *
+*                                                                                                 *
+**************************************************************************************************/
+
+/*
+ * 4-wide panel-major gemv kernels written with the GCC/Clang vector extensions (TARGET=GENERIC_SIMD).
+ */
+
+#include <blasfeo_common.h>
+#include <blasfeo_d_kernel.h>
+
+
+
+// 4 doubles, one column of a panel
+typedef double v4d __attribute__ ((vector_size (32)));
+// same, for loads and stores at any double-aligned address
+typedef double v4d_u __attribute__ ((vector_size (32), aligned (8), may_alias));
+
+
+
+void kernel_dgemv_n_4_lib4(int kmax, double *alpha, double *A, double *x, double *beta, double *y, double *z)
+	{
+
+	const int bs = 4;
+
+	int k;
+
+	v4d
+		y_0 = {0}, y_1 = {0};
+
+	k=0;
+	for(; k<kmax-3; k+=4)
+		{
+
+		y_0 += *(v4d_u *) &A[0+bs*0] * x[0];
+		y_1 += *(v4d_u *) &A[0+bs*1] * x[1];
+		y_0 += *(v4d_u *) &A[0+bs*2] * x[2];
+		y_1 += *(v4d_u *) &A[0+bs*3] * x[3];
+
+		A += 4*bs;
+		x += 4;
+
+		}
+	for(; k<kmax; k++)
+		{
+
+		y_0 += *(v4d_u *) &A[0+bs*0] * x[0];
+
+		A += 1*bs;
+		x += 1;
+
+		}
+
+	y_0 = alpha[0] * (y_0 + y_1);
+
+	if(beta[0]!=0.0)
+		{
+		y_0 += beta[0] * *(v4d_u *) &y[0];
+		}
+
+	*(v4d_u *) &z[0] = y_0;
+
+	return;
+
+	}
+
+
+
+void kernel_dgemv_t_4_lib4(int kmax, double *alpha, int offA, double *A, int sda, double *x, double *beta, double *y, double *z)
+	{
+
+	const int bs  = 4;
+
+	int k, kend;
+
+	double
+		x_0;
+
+	v4d
+		xx,
+		t_0 = {0}, t_1 = {0}, t_2 = {0}, t_3 = {0};
+
+	double yy[4] = {0.0, 0.0, 0.0, 0.0};
+
+	k=0;
+	if(offA!=0) // 1, 2, 3
+		{
+		kend = 4-offA<kmax ? 4-offA : kmax;
+		for(; k<kend; k++)
+			{
+
+			x_0 = x[0];
+
+			yy[0] += A[0+bs*0] * x_0;
+			yy[1] += A[0+bs*1] * x_0;
+			yy[2] += A[0+bs*2] * x_0;
+			yy[3] += A[0+bs*3] * x_0;
+
+			A += 1;
+			x += 1;
+
+			}
+		A += bs*(sda-1);
+		}
+	// full panels: t_j holds the 4 partial products of column j, reduced at the end
+	for(; k<kmax-bs+1; k+=bs)
+		{
+
+		xx = *(v4d_u *) &x[0];
+
+		t_0 += *(v4d_u *) &A[0+bs*0] * xx;
+		t_1 += *(v4d_u *) &A[0+bs*1] * xx;
+		t_2 += *(v4d_u *) &A[0+bs*2] * xx;
+		t_3 += *(v4d_u *) &A[0+bs*3] * xx;
+
+		A += sda*bs;
+		x += 4;
+
+		}
+	for(; k<kmax; k++)
+		{
+
+		x_0 = x[0];
+
+		yy[0] += A[0+bs*0] * x_0;
+		yy[1] += A[0+bs*1] * x_0;
+		yy[2] += A[0+bs*2] * x_0;
+		yy[3] += A[0+bs*3] * x_0;
+
+		A += 1;
+		x += 1;
+
+		}
+
+	yy[0] += (t_0[0] + t_0[1]) + (t_0[2] + t_0[3]);
+	yy[1] += (t_1[0] + t_1[1]) + (t_1[2] + t_1[3]);
+	yy[2] += (t_2[0] + t_2[1]) + (t_2[2] + t_2[3]);
+	yy[3] += (t_3[0] + t_3[1]) + (t_3[2] + t_3[3]);
+
+	if(beta[0]==0.0)
+		{
+		z[0] = alpha[0]*yy[0];
+		z[1] = alpha[0]*yy[1];
+		z[2] = alpha[0]*yy[2];
+		z[3] = alpha[0]*yy[3];
+		}
+	else
+		{
+		z[0] = alpha[0]*yy[0] + beta[0]*y[0];
+		z[1] = alpha[0]*yy[1] + beta[0]*y[1];
+		z[2] = alpha[0]*yy[2] + beta[0]*y[2];
+		z[3] = alpha[0]*yy[3] + beta[0]*y[3];
+		}
+
+	return;
+
+	}
@@ -11,6 +11,7 @@ from pathlib import Path
 from collections import OrderedDict
 import shutil
 import multiprocessing
+import statistics
 
 
 
@@ -23,6 +24,9 @@ BUILDS_DIR="build"
 REPORTS_DIR="reports"
 TESTCLASSES_DIR="classes"
 TPL_PATH="Makefile.tpl"
+ROUTINES_JSON="routines.json"
+PERFSET_JSON="perfset_default.json"
+PERF_BASELINES_DIR="perf_baselines"
 LIB_BLASFEO_STATIC = "libblasfeo.a"
 #MAKE_FLAGS={"--jobs":"8"}
 MAKE_FLAGS={"--jobs": multiprocessing.cpu_count()}
@@ -33,7 +37,7 @@ SILENT=0
 def parse_arguments():
 	parser = argparse.ArgumentParser(description='BLASFEO tests scheduler')
 
-	parser.add_argument(dest='testset_json', type=str, default=TESTSET_JSON, nargs='?',
+	parser.add_argument(dest='testset_json', type=str, default=None, nargs='?',
 		help='Run a batch of test from a specific testset, i.e. testset_all.json')
 	parser.add_argument('--silent', default=False, action='store_true',
 		help='Silent makefile output')
@@ -42,8 +46,15 @@ def parse_arguments():
 	parser.add_argument('--rebuild', default=False, action='store_true',
 		help='Rebuild libblasfeo to take into account recent code '+
 		'changes or addition of new target to the testset batch')
+	parser.add_argument('--perf', default=False, action='store_true',
+		help='Performance regression mode: benchmark the routines of a perfset, '+
+		'i.e. perfset_default.json, and compare against the stored baselines')
+	parser.add_argument('--update-baseline', dest='update_baseline', default=False, action='store_true',
+		help='In performance mode, store the measured performance as new baseline')
 
 	args = parser.parse_args()
+	if args.testset_json is None:
+		args.testset_json = PERFSET_JSON if args.perf else TESTSET_JSON
 	return args
 
 
@@ -449,10 +460,154 @@ class BlasfeoTestset:
 
 
 
+class BlasfeoPerfset:
+	"""
+	Performance regression suite: the routines in the perfset are benchmarked
+	with benchmarks/x_benchmark_blasfeo_api.c at a few sizes per routine group,
+	pinned to one cpu, and the median over the trials is compared against the
+	baseline stored in perf_baselines/ for the current LA, MF and TARGET
+	"""
+	def __init__(self, cli_flags):
+		global SILENT
+
+		self.cli_flags=cli_flags
+
+		with open(cli_flags.testset_json) as f:
+			self.specs = json.load(f, object_pairs_hook=OrderedDict)
+
+		if self.specs["options"].get("silent") or self.cli_flags.silent:
+			SILENT = 1
+
+		# routine group (blas2, blas3, lapack) selects the benchmarked sizes
+		with open(ROUTINES_JSON) as f:
+			routines = json.load(f)
+		self.routine_groups = {
+			routine: group for group, group_routines in routines.items() for routine in group_routines
+		}
+
+		self.trials = self.specs["options"].get("trials", 5)
+		self.tolerance = self.specs["options"].get("tolerance", 0.1)
+		self.cpu = self.specs["options"].get("cpu", 0)
+
+		self._success_n = 0
+		self._errors_n = 0
+		self.regressions = []
+
+	def run_all(self):
+
+		for la in self.specs["LA"]:
+			for mf in self.specs["MF"]:
+				for target in self.specs["TARGET"]:
+
+					blasfeo_flags = OrderedDict(self.specs["blasfeo_flags"])
+					blasfeo_flags.update({"LA": la, "MF": mf, "TARGET": target})
+
+					print("\n## Benchmarking {la}:{mf}:{target}".format(la=la, mf=mf, target=target))
+
+					if make_blasfeo(blasfeo_flags=blasfeo_flags, env_flags=self.specs["env_flags"]):
+						print("Error building libblasfeo for {target}".format(target=target))
+						self._errors_n += 1
+						continue
+
+					baseline_path = Path(PERF_BASELINES_DIR, "{la}_{mf}_{target}.json".format(la=la, mf=mf, target=target))
+					baseline = {}
+					if baseline_path.is_file():
+						with open(str(baseline_path)) as f:
+							baseline = json.load(f)
+					elif not self.cli_flags.update_baseline:
+						print("No baseline {path}, only reporting".format(path=baseline_path))
+
+					measured = self.run_perfset(blasfeo_flags)
+
+					if self.cli_flags.update_baseline:
+						baseline.update(measured)
+						baseline_path.parent.mkdir(parents=True, exist_ok=True)
+						with open(str(baseline_path), "w") as f:
+							json.dump(baseline, f, indent=4, sort_keys=True)
+						print("Baseline written to {path}".format(path=baseline_path))
+					else:
+						self.compare(la+":"+mf+":"+target, measured, baseline)
+
+	def run_perfset(self, blasfeo_flags):
+
+		blasfeo_flags_str = " ".join(["{k}={v}".format(k=k, v=v) for k, v in blasfeo_flags.items()])
+
+		# pin to one cpu, if taskset is available
+		pin_cmd = "taskset -c {cpu} ".format(cpu=self.cpu) if shutil.which("taskset") else ""
+
+		measured = OrderedDict()
+
+		for precision in self.specs["precisions"]:
+			for routine in self.specs["routines"]:
+
+				routine_name = "{p}{routine}".format(p=precision[0], routine=routine)
+				sizes = self.specs["sizes"][self.routine_groups[routine]]
+
+				make_cmd = "make {flags} BENCHMARK_CALIBRATE_FREQ=1 BENCHMARK_OUTPUT=csv -C {path}/benchmarks blasfeo_api_{name}"\
+					.format(flags=blasfeo_flags_str, path=BLASFEO_PATH, name=routine_name)
+				if run_cmd(make_cmd).returncode:
+					print("Error building benchmark {name}".format(name=routine_name))
+					self._errors_n += 1
+					continue
+
+				binary = Path(BLASFEO_PATH, "benchmarks", "build", blasfeo_flags["LA"], blasfeo_flags["TARGET"],
+					"BLASFEO_API", "{name}_benchmark.out".format(name=routine_name))
+				run_cmd_str = pin_cmd + str(binary) + " " + " ".join([str(n) for n in sizes])
+
+				gflops = {str(n): [] for n in sizes}
+				for trial in range(self.trials):
+					outs = sp.run(run_cmd_str, shell=True, stdout=sp.PIPE).stdout.decode("utf8")
+					for line in outs.splitlines():
+						if line.startswith("#") or line.startswith("n,"):
+							continue
+						fields = line.split(",")
+						gflops[fields[0]].append(float(fields[1]))
+
+				measured[routine_name] = {n: statistics.median(values) for n, values in gflops.items() if values}
+				print("{name}: {res}".format(name=routine_name,
+					res=", ".join(["n={n} {g:.3f} Gflops".format(n=n, g=g) for n, g in measured[routine_name].items()])))
+
+		return measured
+
+	def compare(self, run_id, measured, baseline):
+
+		for routine_name, results in measured.items():
+			for n, gflops in results.items():
+				ref = baseline.get(routine_name, {}).get(n)
+				if ref is None:
+					continue
+				if gflops < (1.0-self.tolerance)*ref:
+					self._errors_n += 1
+					self.regressions.append(
+						"Regression {run_id} {name} n={n}: {g:.3f} Gflops, baseline {ref:.3f} Gflops ({pct:+.1f}%)"
+						.format(run_id=run_id, name=routine_name, n=n, g=gflops, ref=ref, pct=100.0*(gflops/ref-1.0)))
+				else:
+					self._success_n += 1
+
+	def print_summary(self):
+
+		print("\n\n### Perfset Summary:\n")
+		print("\n".join(self.regressions))
+		print("({done}:Within tolerance, {errors}:Regressions or errors), tolerance {tol:.0f}%\n"
+			.format(done=self._success_n, errors=self._errors_n, tol=100.0*self.tolerance))
+
+	def get_returncode(self):
+		if self._errors_n > 0:
+			return 1
+		return 0
+
+
+
 if __name__ == "__main__":
 
 	cli_flags = parse_arguments()
 
+	if cli_flags.perf:
+		perfset = BlasfeoPerfset(cli_flags)
+		perfset.run_all()
+		perfset.print_summary()
+		sys.exit(perfset.get_returncode())
+
 	# generate test set
 	# collection of routines/lib combinations to be run in the given excution of the tester.py
 	testset = BlasfeoTestset(cli_flags)